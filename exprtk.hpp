@@ -48,6 +48,7 @@
 #include <limits>
 #include <list>
 #include <map>
+#include <new>
 #include <set>
 #include <stack>
 #include <stdexcept>
@@ -55,6 +56,10 @@
 #include <utility>
 #include <vector>
 
+#if defined(exprtk_enable_vector_huge_pages) && defined(__linux__)
+#   include <sys/mman.h>
+#endif
+
 
 namespace exprtk
 {
@@ -624,7 +629,9 @@ namespace exprtk
             {
                const type c = *(p_itr);
 
-               if ((data_end != d_itr) && (Compare::cmp(c,*(d_itr)) || (exactly_one == c)))
+               // A wildcard in the data must not consume a pattern
+               // wildcard, else backtracking revisits the same state
+               if ((data_end != d_itr) && (zero_or_more != c) && (Compare::cmp(c,*(d_itr)) || (exactly_one == c)))
                {
                   ++d_itr;
                   ++p_itr;
@@ -760,6 +767,237 @@ namespace exprtk
                 );
       }
 
+      class wildcard_matcher
+      {
+      public:
+
+         /*
+            A like/ilike pattern compiled once: the pattern is split at
+            each '*' into segments, the first is anchored at the start
+            of the string, the last at its end, and the ones between
+            are found in order, each by searching for its longest run
+            without a '?' and then checking the whole segment. The runs
+            are searched with memchr/memcmp, or when matching without
+            case by a Horspool search whose shift table is built here.
+         */
+         wildcard_matcher(const std::string& pattern, const bool case_insensitive)
+         : case_insensitive_(case_insensitive)
+         , anchored_(true)
+         , fixed_size_(0)
+         {
+            build_fold_table();
+
+            std::size_t begin = 0;
+
+            for ( ; ; )
+            {
+               const std::size_t end = pattern.find('*', begin);
+
+               add_segment(pattern.substr(begin, (std::string::npos == end) ? std::string::npos : end - begin), true);
+
+               if (std::string::npos == end)
+                  break;
+
+               anchored_ = false;
+               begin = end + 1;
+            }
+         }
+
+         inline bool match(const char_t* s, const std::size_t n) const
+         {
+            if (n < fixed_size_)
+               return false;
+
+            const segment& first = segment_list_.front();
+
+            if (anchored_)
+               return (n == first.text.size()) && equal(first, s);
+
+            const segment& last = segment_list_.back();
+
+            if (!equal(first, s) || !equal(last, s + n - last.text.size()))
+               return false;
+
+            std::size_t position = first.text.size();
+            const std::size_t end = n - last.text.size();
+
+            for (std::size_t i = 1; i < (segment_list_.size() - 1); ++i)
+            {
+               const segment& middle = segment_list_[i];
+
+               if (middle.text.empty())
+                  continue;
+
+               const std::size_t found = search(middle, s + position, end - position);
+
+               if (std::string::npos == found)
+                  return false;
+
+               position += found + middle.text.size();
+            }
+
+            return true;
+         }
+
+      private:
+
+         struct segment
+         {
+            std::string text;
+            bool        wildcard;
+            bool        plain;
+            std::size_t key_offset;
+            std::size_t key_size;
+            std::size_t shift[256];
+         };
+
+         inline void build_fold_table()
+         {
+            for (std::size_t c = 0; c < 256; ++c)
+            {
+               fold_[c] = static_cast<unsigned char>(case_insensitive_ ? std::tolower(static_cast<int>(c)) : static_cast<int>(c));
+            }
+         }
+
+         inline unsigned char fold(const char_t c) const
+         {
+            return fold_[static_cast<unsigned char>(c)];
+         }
+
+         inline void add_segment(const std::string& text, const bool wildcard)
+         {
+            segment_list_.push_back(segment());
+            segment& seg = segment_list_.back();
+
+            seg.wildcard   = wildcard && (std::string::npos != text.find('?'));
+            seg.plain      = !seg.wildcard && !case_insensitive_;
+            seg.text       = text;
+            seg.key_offset = 0;
+            seg.key_size   = text.size();
+
+            for (std::size_t i = 0; i < seg.text.size(); ++i)
+            {
+               seg.text[i] = static_cast<char_t>(fold(seg.text[i]));
+            }
+
+            // Searches look for the longest run without a '?', the key
+            if (seg.wildcard)
+            {
+               seg.key_size = 0;
+
+               for (std::size_t i = 0; i < seg.text.size(); )
+               {
+                  const std::size_t run_end = std::min(seg.text.find('?', i), seg.text.size());
+
+                  if ((run_end - i) > seg.key_size)
+                  {
+                     seg.key_offset = i;
+                     seg.key_size   = run_end - i;
+                  }
+
+                  i = run_end + 1;
+               }
+            }
+
+            const std::size_t k = seg.key_size;
+
+            std::fill_n(seg.shift, 256, std::max<std::size_t>(k, 1));
+
+            for (std::size_t i = 0; (i + 1) < k; ++i)
+            {
+               seg.shift[static_cast<unsigned char>(seg.text[seg.key_offset + i])] = k - 1 - i;
+            }
+
+            fixed_size_ += seg.text.size();
+         }
+
+         inline bool equal(const segment& seg, const char_t* s) const
+         {
+            if (seg.plain)
+               return (0 == std::memcmp(seg.text.data(), s, seg.text.size()));
+
+            for (std::size_t i = 0; i < seg.text.size(); ++i)
+            {
+               if ((seg.wildcard && ('?' == seg.text[i])))
+                  continue;
+               else if (static_cast<unsigned char>(seg.text[i]) != fold(s[i]))
+                  return false;
+            }
+
+            return true;
+         }
+
+         // First position in [from, last] at which the key of the segment occurs in s
+         inline std::size_t find_key(const segment& seg, const char_t* s, const std::size_t from, const std::size_t last) const
+         {
+            const char_t*     key = seg.text.data() + seg.key_offset;
+            const std::size_t k   = seg.key_size;
+
+            if (0 == k)
+               return from;
+            else if (!case_insensitive_)
+            {
+               const char_t* begin = s + from;
+               const char_t* end   = s + last + 1;
+
+               while (const void* found = std::memchr(begin, key[0], static_cast<std::size_t>(end - begin)))
+               {
+                  begin = static_cast<const char_t*>(found);
+
+                  if (0 == std::memcmp(begin + 1, key + 1, k - 1))
+                     return static_cast<std::size_t>(begin - s);
+
+                  ++begin;
+               }
+
+               return std::string::npos;
+            }
+
+            for (std::size_t i = from; i <= last; i += seg.shift[fold(s[i + k - 1])])
+            {
+               std::size_t j = 0;
+
+               while ((j < k) && (static_cast<unsigned char>(key[j]) == fold(s[i + j])))
+               {
+                  ++j;
+               }
+
+               if (j == k)
+                  return i;
+            }
+
+            return std::string::npos;
+         }
+
+         inline std::size_t search(const segment& seg, const char_t* s, const std::size_t n) const
+         {
+            const std::size_t m = seg.text.size();
+
+            if (m > n)
+               return std::string::npos;
+
+            const std::size_t last = n - m;
+
+            for (std::size_t i = 0; i <= last; ++i)
+            {
+               i = find_key(seg, s + seg.key_offset, i, last);
+
+               if (std::string::npos == i)
+                  break;
+               else if (!seg.wildcard || equal(seg, s + i))
+                  return i;
+            }
+
+            return std::string::npos;
+         }
+
+         bool                 case_insensitive_;
+         bool                 anchored_;
+         std::size_t          fixed_size_;
+         unsigned char        fold_[256];
+         std::vector<segment> segment_list_;
+      };
+
       template<typename T>
       struct set_zero_value_impl
       {
@@ -1754,6 +1992,416 @@ namespace exprtk
          exprtk_define_unary_function(frac )
          exprtk_define_unary_function(trunc)
          #undef exprtk_define_unary_function
+
+         /*
+            Polynomial approximations of exp, log, sin, cos, erf, erfc
+            and ncdf, used in place of the standard library when the
+            parser's e_approximations option is enabled. They evaluate in
+            double precision using only basic arithmetic, floor and bit
+            manipulation, so provided the compiler does not contract
+            expressions into fused multiply-adds (-ffp-contract=off), the
+            results are identical on every IEEE-754 platform. Measured
+            maximum errors against an extended precision reference:
+
+               exp  : 1.1 ulp
+               log  : 1 ulp
+               sin  : 1.5 ulp for |x| <= 10, 2.5 ulp for |x| <= 2^20
+               cos  : 1.5 ulp for |x| <= 10, 2.5 ulp for |x| <= 2^20
+               erf  : 2 ulp
+               erfc : 6 ulp
+               ncdf : 6 ulp, plus the error from rounding x / sqrt(2)
+
+            Beyond 2^20, sin and cos defer to the standard library. Each
+            function has a scalar form and a batch form applying it to n
+            consecutive values, the batch forms of exp, sin and cos are
+            branch-free and vectorise where the target supports it. The
+            float forms round the double result, other types use the
+            standard functions.
+         */
+         namespace approx
+         {
+            // c[0] + x * (c[S] + x * (c[2S] + ...)), unrolled at compile time
+            template <std::size_t N, std::size_t S>
+            struct horner_impl
+            {
+               static inline double process(const double x, const double* c)
+               {
+                  return horner_impl<N - 1,S>::process(x, c + S) * x + c[0];
+               }
+            };
+
+            template <std::size_t S>
+            struct horner_impl<1,S>
+            {
+               static inline double process(const double, const double* c)
+               {
+                  return c[0];
+               }
+            };
+
+            template <std::size_t N>
+            inline double horner(const double x, const double (&c)[N])
+            {
+               return horner_impl<N,1>::process(x, c);
+            }
+
+            // As above, split into two independent chains of even and odd terms
+            template <std::size_t N>
+            inline double horner2(const double x, const double (&c)[N])
+            {
+               const double x2 = x * x;
+
+               return horner_impl<(N + 1) / 2,2>::process(x2, c) +
+                      horner_impl<N / 2      ,2>::process(x2, c + 1) * x;
+            }
+
+            // Nearest integer to x for |x| < 2^51, without a libm call
+            inline double round_nearest(const double x)
+            {
+               static const double shifter = 6755399441055744.0; // 1.5 * 2^52
+
+               return (x + shifter) - shifter;
+            }
+
+            // 2^k for k in [-1022,1023]
+            inline double pow2(const int k)
+            {
+               const _uint64_t bits = static_cast<_uint64_t>(k + 1023) << 52;
+
+               double result;
+               std::memcpy(&result, &bits, sizeof(result));
+
+               return result;
+            }
+
+            inline double exp(const double x)
+            {
+               static const double log2e  = 1.44269504088896338700e+00;
+               static const double ln2_hi = 6.93147180369123816490e-01;
+               static const double ln2_lo = 1.90821492927058770002e-10;
+
+               // Minimax fit of exp(r) for |r| <= log(2) / 2
+               static const double c[] =
+                  {
+                     1.00000000000000000e+00, 1.00000000000000000e+00, 5.00000000000001887e-01,
+                     1.66666666666666796e-01, 4.16666666664880989e-02, 8.33333333331960115e-03,
+                     1.38888889523147751e-03, 1.98412698900471131e-04, 2.48014854823284939e-05,
+                     2.75572409185789696e-06, 2.76326396390410286e-07, 2.51100376059637769e-08
+                  };
+
+               // Clamping yields inf and zero through the scaling below
+               const double v = (x != x) ? 0.0 : (x < -746.0) ? -746.0 : (x > 710.0) ? 710.0 : x;
+               const double k = round_nearest(v * log2e);
+               const double r = (v - k * ln2_hi) - k * ln2_lo;
+
+               // Scaling in two steps keeps both factors normal
+               const int k0 = static_cast<int>(k) / 2;
+               const int k1 = static_cast<int>(k) - k0;
+
+               /*
+                  Estrin's scheme shortens the dependency chain of the
+                  polynomial, the leading 1 + r is added last.
+               */
+               const double r2 = r  * r;
+               const double r4 = r2 * r2;
+               const double q0 = r2 * (c[2] + c[ 3] * r);
+               const double q1 = (c[4] + c[ 5] * r) + r2 * (c[ 6] + c[ 7] * r);
+               const double q2 = (c[8] + c[ 9] * r) + r2 * (c[10] + c[11] * r);
+               const double p  = c[0] + (c[1] * r + (q0 + r4 * (q1 + r4 * q2)));
+
+               const double result = (p * pow2(k0)) * pow2(k1);
+
+               return (x != x) ? x : result;
+            }
+
+            inline double log(const double x)
+            {
+               static const double ln2_hi = 6.93147180369123816490e-01;
+               static const double ln2_lo = 1.90821492927058770002e-10;
+               static const double two54  = 1.80143985094819840000e+16;
+
+               static const double lg[] =
+                  {
+                     6.666666666666735130e-01, 3.999999999940941908e-01,
+                     2.857142874366239149e-01, 2.222219843214978396e-01,
+                     1.818357216161805012e-01, 1.531383769920937332e-01,
+                     1.479819860511658591e-01
+                  };
+
+               // Zero, negative, infinite and NaN arguments are selected at the end
+               const bool   finite    = (x > 0.0) && (x <= std::numeric_limits<double>::max());
+               const bool   subnormal = (x < std::numeric_limits<double>::min());
+               const double v         = finite ? (subnormal ? x * two54 : x) : 1.0;
+
+               _uint64_t bits = 0;
+               std::memcpy(&bits, &v, sizeof(bits));
+
+               const _int64_t exponent = static_cast<_int64_t>((bits >> 52) & 0x7FF) - (subnormal ? 1077 : 1023);
+
+               bits = (bits & 0x000FFFFFFFFFFFFFULL) | 0x3FF0000000000000ULL;
+
+               double m0 = 0.0;
+               std::memcpy(&m0, &bits, sizeof(m0));
+
+               // Reduce m into [sqrt(2) / 2, sqrt(2)]
+               const bool   halve = (m0 > constant::sqrt2);
+               const double m     = halve ? (m0 * 0.5) : m0;
+
+               const double f    = m - 1.0;
+               const double s    = f / (2.0 + f);
+               const double z    = s * s;
+               const double w    = z * z;
+               const double t0   = z * (lg[0] + w * (lg[2] + w * (lg[4] + w * lg[6])));
+               const double t1   = w * (lg[1] + w * (lg[3] + w * lg[5]));
+               const double hfsq = 0.5 * f * f;
+               const double k    = static_cast<double>(exponent + (halve ? 1 : 0));
+
+               const double result = k * ln2_hi - ((hfsq - (s * (hfsq + t0 + t1) + k * ln2_lo)) - f);
+
+               return finite   ? result :
+                      (x == 0.0) ? -std::numeric_limits<double>::infinity() :
+                      (x >  0.0) ? x : std::numeric_limits<double>::quiet_NaN();
+            }
+
+            inline double sin_kernel(const double r)
+            {
+               static const double c[] =
+                  {
+                     -1.66666666666666324348e-01,  8.33333333332248946124e-03,
+                     -1.98412698298579493134e-04,  2.75573137070700676789e-06,
+                     -2.50507602534068634195e-08,  1.58969099521155010221e-10
+                  };
+
+               const double z = r * r;
+
+               return r + (z * r) * horner(z, c);
+            }
+
+            inline double cos_kernel(const double r)
+            {
+               static const double c[] =
+                  {
+                      4.16666666666666019037e-02, -1.38888888888741095749e-03,
+                      2.48015872894767294178e-05, -2.75573143513906633035e-07,
+                      2.08757232129817482790e-09, -1.13596475577881948265e-11
+                  };
+
+               const double z  = r * r;
+               const double hz = 0.5 * z;
+               const double w  = 1.0 - hz;
+
+               return w + (((1.0 - w) - hz) + (z * z) * horner(z, c));
+            }
+
+            // sin(x + quadrant * pi / 2) for |x| <= 2^20
+            inline double sin_quadrant(const double x, const int quadrant)
+            {
+               static const double pio2_1 = 1.57079632673412561417e+00;
+               static const double pio2_2 = 6.07710050630396597660e-11;
+               static const double pio2_3 = 2.02226624871116645580e-21;
+
+               const double k = round_nearest(x * constant::_2_pi);
+               const double r = ((x - k * pio2_1) - k * pio2_2) - k * pio2_3;
+
+               const int    q      = static_cast<int>(k) + quadrant;
+               const double result = (q & 1) ? cos_kernel(r) : sin_kernel(r);
+
+               return (q & 2) ? -result : result;
+            }
+
+            static const double sin_cos_limit = 1048576.0;
+
+            inline double sin(const double x)
+            {
+               if (std::abs(x) <= sin_cos_limit)
+                  return sin_quadrant(x, 0);
+               else
+                  return std::sin(x);
+            }
+
+            inline double cos(const double x)
+            {
+               if (std::abs(x) <= sin_cos_limit)
+                  return sin_quadrant(x, 1);
+               else
+                  return std::cos(x);
+            }
+
+            // exp(-x^2) for |x| < 27.3, with x^2 split into an exact and a small part
+            inline double exp_neg_sqr(const double x)
+            {
+               const double c  = 134217729.0 * x;
+               const double hi = c - (c - x);
+               const double b  = -(x - hi) * (x + hi);
+
+               return exp(-hi * hi) * (1.0 + b * (1.0 + b * (0.5 + b * (1.0 / 6.0))));
+            }
+
+            // erfc(x) for x >= 0.84375
+            inline double erfc_tail(const double x)
+            {
+               // Minimax fits of erfc(x) * exp(x^2) about the centre of each interval
+               static const double g0[] =
+                  {
+                      3.84813747141001639e-01, -2.26471947233790022e-01,  1.19416933976391026e-01,
+                     -5.76868184867906711e-02,  2.59075967830163997e-02, -1.09305414041365005e-02,
+                      4.36612275099712479e-03, -1.66114030594850435e-03,  6.04871339348755140e-04,
+                     -2.11625279250494779e-04,  7.13357406107145410e-05, -2.32584278867696494e-05,
+                      7.60918738912307878e-06, -2.32968158594648512e-06
+                  };
+
+               static const double g1[] =
+                  {
+                      2.55395676310505748e-01, -1.06796461853489941e-01,  4.18027526035266300e-02,
+                     -1.54606377642391730e-02,  5.44073853745951665e-03, -1.83166427797548377e-03,
+                      5.92469995882164693e-04, -1.84778324630957260e-04,  5.57283047833016638e-05,
+                     -1.62941339129647593e-05,  4.62827740445235032e-06, -1.27736168071255075e-06,
+                      3.44323663463959969e-07, -9.64371218645640617e-08,  2.47423390766504529e-08
+                  };
+
+               static const double g2[] =
+                  {
+                      1.66335348426821877e-01, -4.71994023211703764e-02,  1.29372908830191948e-02,
+                     -3.43547130090777987e-03,  8.86004577495601168e-04, -2.22382569560788723e-04,
+                      5.44204093612904547e-05, -1.30046403744951908e-05,  3.03882816371284791e-06,
+                     -6.95207307766110240e-07,  1.55895587362157982e-07, -3.42927465163799976e-08,
+                      7.37643263621547345e-09, -1.56612897302118352e-09,  3.60510949140734418e-10,
+                     -7.38469711574246700e-11
+                  };
+
+               // Minimax fit of x * erfc(x) * exp(x^2) in t = 1 / x^2
+               static const double h[] =
+                  {
+                      5.64189583547756279e-01, -2.82094791773817577e-01,  4.23142187597243646e-01,
+                     -1.05785544267482456e+00,  3.70248833767044427e+00, -1.66604532730340260e+01,
+                      9.15695634290148348e+01, -5.91586374540741758e+02,  4.29201045810361211e+03,
+                     -3.23904168324825296e+04,  2.26606974137652927e+05, -1.27529649420307763e+06,
+                      4.83662134779933561e+06, -8.93161032317644730e+06
+                  };
+
+               if (x < 1.5)
+                  return exp_neg_sqr(x) * horner2(x - 1.171875, g0);
+               else if (x < 2.5)
+                  return exp_neg_sqr(x) * horner2(x - 2.0, g1);
+               else if (x < 4.0)
+                  return exp_neg_sqr(x) * horner2(x - 3.25, g2);
+               else if (x < 27.3)
+                  return exp_neg_sqr(x) * (horner2(1.0 / (x * x), h) / x);
+               else
+                  return 0.0;
+            }
+
+            // erf(x) for |x| < 0.84375
+            inline double erf_core(const double x)
+            {
+               // Minimax fit of erf(x) / x in x^2
+               static const double c[] =
+                  {
+                      1.12837916709551256e+00, -3.76126389031833985e-01,  1.12837916709353114e-01,
+                     -2.68661706407798510e-02,  5.22397757637784420e-03, -8.54832379116412990e-04,
+                      1.20551999413218855e-04, -1.49221215744430553e-05,  1.64016296793470192e-06,
+                     -1.57144606726024413e-07,  1.07265714321763478e-08
+                  };
+
+               return x * horner(x * x, c);
+            }
+
+            inline double erf(const double x)
+            {
+               const double a = std::abs(x);
+
+               if (a < 0.84375)
+                  return erf_core(x);
+               else if (a < 6.0)
+               {
+                  const double result = 1.0 - erfc_tail(a);
+                  return (x < 0.0) ? -result : result;
+               }
+               else if (x != x)
+                  return x;
+               else
+                  return (x < 0.0) ? -1.0 : 1.0;
+            }
+
+            inline double erfc(const double x)
+            {
+               if (x != x)
+                  return x;
+               else if (std::abs(x) < 0.84375)
+                  return 1.0 - erf_core(x);
+               else if (x > 0.0)
+                  return erfc_tail(x);
+               else
+                  return 2.0 - erfc_tail(-x);
+            }
+
+            inline double ncdf(const double x)
+            {
+               static const double _1_sqrt2 = 0.70710678118654752440;
+
+               return 0.5 * erfc(-(x * _1_sqrt2));
+            }
+
+            #define exprtk_define_approx_function(FunctionName)                \
+            inline float FunctionName (const float v)                          \
+            {                                                                  \
+               return static_cast<float>(FunctionName(static_cast<double>(v))); \
+            }                                                                  \
+                                                                               \
+            template <typename T>                                              \
+            inline T FunctionName (const T v)                                  \
+            {                                                                  \
+               return numeric:: FunctionName (v);                              \
+            }                                                                  \
+                                                                               \
+            template <typename T>                                              \
+            inline void FunctionName (const T* v, T* result, const std::size_t n) \
+            {                                                                  \
+               for (std::size_t i = 0; i < n; ++i)                             \
+               {                                                               \
+                  result[i] = FunctionName(v[i]);                              \
+               }                                                               \
+            }                                                                  \
+
+            exprtk_define_approx_function(exp )
+            exprtk_define_approx_function(log )
+            exprtk_define_approx_function(sin )
+            exprtk_define_approx_function(cos )
+            exprtk_define_approx_function(erf )
+            exprtk_define_approx_function(erfc)
+            exprtk_define_approx_function(ncdf)
+            #undef exprtk_define_approx_function
+
+            /*
+               The batch forms of sin and cos reduce every value in one
+               branch-free pass, then revisit those out of range.
+            */
+            inline void sin_quadrant(const double* v, double* result, const std::size_t n, const int quadrant)
+            {
+               for (std::size_t i = 0; i < n; ++i)
+               {
+                  result[i] = sin_quadrant((std::abs(v[i]) <= sin_cos_limit) ? v[i] : 0.0, quadrant);
+               }
+
+               for (std::size_t i = 0; i < n; ++i)
+               {
+                  if (!(std::abs(v[i]) <= sin_cos_limit))
+                  {
+                     result[i] = quadrant ? std::cos(v[i]) : std::sin(v[i]);
+                  }
+               }
+            }
+
+            inline void sin(const double* v, double* result, const std::size_t n)
+            {
+               sin_quadrant(v, result, n, 0);
+            }
+
+            inline void cos(const double* v, double* result, const std::size_t n)
+            {
+               sin_quadrant(v, result, n, 1);
+            }
+         }
       }
 
       template <typename T>
@@ -2461,6 +3109,7 @@ namespace exprtk
          typedef token token_t;
          typedef std::vector<token_t> token_list_t;
          typedef token_list_t::iterator token_list_itr_t;
+         typedef token_list_t::const_iterator token_list_citr_t;
          typedef details::char_t char_t;
 
          generator()
@@ -2522,6 +3171,12 @@ namespace exprtk
             store_token_itr_ = token_itr_;
          }
 
+         // Index of the token the next call to next_token will return
+         inline std::size_t next_token_index() const
+         {
+            return static_cast<std::size_t>(std::distance(token_list_.begin(), token_list_citr_t(token_itr_)));
+         }
+
          inline void restore()
          {
             token_itr_ = store_token_itr_;
@@ -3004,6 +3659,30 @@ namespace exprtk
             details::char_cptr initial_itr = s_itr_;
             token_t t;
 
+            // Literal parameter: $name, where name is not of the form fdd
+            if (
+                 !is_end(s_itr_ + 1) && details::is_letter(*(s_itr_ + 1)) &&
+                 !(
+                    details::imatch('f', *(s_itr_ + 1)) &&
+                    !is_end(s_itr_ + 2) && details::is_digit(*(s_itr_ + 2)) &&
+                    !is_end(s_itr_ + 3) && details::is_digit(*(s_itr_ + 3)) &&
+                    (is_end(s_itr_ + 4) || !(details::is_letter_or_digit(*(s_itr_ + 4)) || ('_' == *(s_itr_ + 4))))
+                  )
+               )
+            {
+               ++s_itr_;
+
+               while (!is_end(s_itr_) && (details::is_letter_or_digit(*s_itr_) || ('_' == *s_itr_)))
+               {
+                  ++s_itr_;
+               }
+
+               t.set_symbol(initial_itr, s_itr_, base_itr_);
+               token_list_.push_back(t);
+
+               return;
+            }
+
             // $fdd(x,x,x) = at least 11 chars
             if (std::distance(s_itr_,s_end_) < 11)
             {
@@ -3158,6 +3837,7 @@ namespace exprtk
          friend class token_modifier;
          friend class token_inserter;
          friend class token_joiner;
+         friend class token_pipeline;
       }; // class generator
 
       class helper_interface
@@ -3275,6 +3955,11 @@ namespace exprtk
             return false;
          }
 
+         inline std::size_t stride() const
+         {
+            return stride_;
+         }
+
       private:
 
          const std::size_t stride_;
@@ -3403,6 +4088,11 @@ namespace exprtk
 
          #undef token_inserter_empty_body
 
+         inline std::size_t stride() const
+         {
+            return stride_;
+         }
+
       private:
 
          const std::size_t stride_;
@@ -3432,6 +4122,11 @@ namespace exprtk
          virtual bool join(const token&, const token&, token&)               { return false; }
          virtual bool join(const token&, const token&, const token&, token&) { return false; }
 
+         inline std::size_t stride() const
+         {
+            return stride_;
+         }
+
       private:
 
          inline std::size_t process_stride_2(generator& g)
@@ -3522,6 +4217,300 @@ namespace exprtk
          const std::size_t stride_;
       };
 
+
+      /*
+         Runs a chain of inserters, joiners, modifiers and scanners over
+         the token list in a single pass. Each inserter and joiner holds
+         a window of at most its stride in tokens, and hands the tokens
+         it releases on to the next stage. Modifiers and scanners see each
+         token as it is appended to the output list. The result is that
+         of running each helper over the whole list in turn, but without
+         building an intermediate list per helper.
+      */
+      class token_pipeline
+      {
+      public:
+
+         token_pipeline()
+         : scanner_active_(0)
+         {}
+
+         inline void clear()
+         {
+            stage_list_   .clear();
+            modifier_list_.clear();
+            scanner_list_ .clear();
+         }
+
+         inline void add_inserter(token_inserter* inserter)
+         {
+            stage_list_.push_back(stage_t(inserter, 0, inserter->stride()));
+         }
+
+         inline void add_joiner(token_joiner* joiner)
+         {
+            stage_list_.push_back(stage_t(0, joiner, joiner->stride()));
+         }
+
+         inline void add_modifier(token_modifier* modifier)
+         {
+            modifier_list_.push_back(modifier);
+         }
+
+         inline void add_scanner(token_scanner* scanner)
+         {
+            scanner_list_.push_back(scanner);
+         }
+
+         inline void process(generator& g)
+         {
+            const generator::token_list_t& input = g.token_list_;
+
+            /*
+               A token made by a stage stays in its pool until every later
+               stage has released it, which is at most the sum of their
+               strides tokens later.
+            */
+            std::size_t pool_size = 2;
+
+            for (std::size_t i = 0; i < stage_list_.size(); ++i)
+            {
+               pool_size += stage_list_[i].stride;
+            }
+
+            for (std::size_t i = 0; i < stage_list_.size(); ++i)
+            {
+               stage_list_[i].pool.resize(pool_size);
+               stage_list_[i].pool_index = 0;
+               stage_list_[i].count      = 0;
+            }
+
+            scanner_active_ = scanner_list_.size();
+            scanner_state_.assign(scanner_list_.size(), true);
+
+            output_.clear();
+            output_.reserve(input.size() + (input.size() >> 3) + 1);
+
+            for (std::size_t i = 0; i < input.size(); ++i)
+            {
+               push(0, &input[i]);
+            }
+
+            for (std::size_t i = 0; i < stage_list_.size(); ++i)
+            {
+               flush(i);
+            }
+
+            g.token_list_.swap(output_);
+            output_.clear();
+         }
+
+      private:
+
+         struct stage_t
+         {
+            stage_t(token_inserter* i, token_joiner* j, const std::size_t s)
+            : inserter  (i)
+            , joiner    (j)
+            , stride    (s)
+            , count     (0)
+            , pool_index(0)
+            {
+               std::fill_n(window, 5, reinterpret_cast<const token*>(0));
+            }
+
+            inline token& next_token()
+            {
+               token& t = pool[pool_index];
+               t.clear();
+               return t;
+            }
+
+            inline void commit_token()
+            {
+               if (++pool_index == pool.size())
+                  pool_index = 0;
+            }
+
+            inline void shift()
+            {
+               for (std::size_t i = 1; i < count; ++i)
+               {
+                  window[i - 1] = window[i];
+               }
+
+               --count;
+            }
+
+            token_inserter*    inserter;
+            token_joiner*      joiner;
+            std::size_t        stride;
+            std::size_t        count;
+            const token*       window[5];
+            std::vector<token> pool;
+            std::size_t        pool_index;
+         };
+
+         inline void push(const std::size_t index, const token* t)
+         {
+            if (index == stage_list_.size())
+               emit(*t);
+            else if (stage_list_[index].inserter)
+               push_inserter(index, stage_list_[index], t);
+            else
+               push_joiner(index, stage_list_[index], t);
+         }
+
+         inline void push_inserter(const std::size_t index, stage_t& stage, const token* t)
+         {
+            if ((0 == stage.stride) || (stage.stride > 5))
+            {
+               push(index + 1, t);
+               return;
+            }
+
+            stage.window[stage.count++] = t;
+
+            if (stage.count < stage.stride)
+               return;
+
+            token_inserter& inserter     = (*stage.inserter);
+            const token**   w            = stage.window;
+            token&          new_token    = stage.next_token();
+            int             insert_index = -1;
+
+            switch (stage.stride)
+            {
+               case 1 : insert_index = inserter.insert(*w[0], new_token);
+                        break;
+
+               case 2 : insert_index = inserter.insert(*w[0], *w[1], new_token);
+                        break;
+
+               case 3 : insert_index = inserter.insert(*w[0], *w[1], *w[2], new_token);
+                        break;
+
+               case 4 : insert_index = inserter.insert(*w[0], *w[1], *w[2], *w[3], new_token);
+                        break;
+
+               case 5 : insert_index = inserter.insert(*w[0], *w[1], *w[2], *w[3], *w[4], new_token);
+                        break;
+            }
+
+            push(index + 1, w[0]);
+
+            if ((insert_index >= 0) && (insert_index <= (static_cast<int>(stage.stride) + 1)))
+            {
+               stage.commit_token();
+               push(index + 1, &new_token);
+            }
+
+            stage.shift();
+         }
+
+         inline void push_joiner(const std::size_t index, stage_t& stage, const token* t)
+         {
+            if ((2 != stage.stride) && (3 != stage.stride))
+            {
+               push(index + 1, t);
+               return;
+            }
+
+            stage.window[stage.count++] = t;
+
+            if (stage.count < stage.stride)
+               return;
+
+            const token** w            = stage.window;
+            token&        joined_token = stage.next_token();
+
+            const bool joined = (2 == stage.stride) ?
+                                stage.joiner->join(*w[0], *w[1], joined_token) :
+                                stage.joiner->join(*w[0], *w[1], *w[2], joined_token);
+
+            if (joined)
+            {
+               stage.count = 0;
+               stage.commit_token();
+               push(index + 1, &joined_token);
+            }
+            else
+            {
+               push(index + 1, w[0]);
+               stage.shift();
+            }
+         }
+
+         inline void flush(const std::size_t index)
+         {
+            stage_t& stage = stage_list_[index];
+
+            // Tokens still held can not complete a window
+            for (std::size_t i = 0; i < stage.count; ++i)
+            {
+               push(index + 1, stage.window[i]);
+            }
+
+            stage.count = 0;
+         }
+
+         inline void emit(const token& t)
+         {
+            output_.push_back(t);
+
+            for (std::size_t i = 0; i < modifier_list_.size(); ++i)
+            {
+               modifier_list_[i]->modify(output_.back());
+            }
+
+            if (0 == scanner_active_)
+               return;
+
+            const std::size_t n = output_.size();
+
+            for (std::size_t i = 0; i < scanner_list_.size(); ++i)
+            {
+               token_scanner& scanner = (*scanner_list_[i]);
+
+               const std::size_t stride = scanner.stride();
+
+               if (!scanner_state_[i] || (0 == stride) || (n < stride))
+                  continue;
+
+               const token* w = &output_[n - stride];
+               bool state = true;
+
+               switch (stride)
+               {
+                  case 1 : state = scanner(w[0]);
+                           break;
+
+                  case 2 : state = scanner(w[0], w[1]);
+                           break;
+
+                  case 3 : state = scanner(w[0], w[1], w[2]);
+                           break;
+
+                  case 4 : state = scanner(w[0], w[1], w[2], w[3]);
+                           break;
+               }
+
+               if (!state)
+               {
+                  scanner_state_[i] = false;
+                  --scanner_active_;
+               }
+            }
+         }
+
+         std::vector<stage_t>         stage_list_;
+         std::vector<token_modifier*> modifier_list_;
+         std::vector<token_scanner*>  scanner_list_;
+         std::vector<bool>            scanner_state_;
+         std::size_t                  scanner_active_;
+         generator::token_list_t      output_;
+      };
+
       namespace helper
       {
 
@@ -3555,10 +4544,26 @@ namespace exprtk
 
             inline int insert(const lexer::token& t0, const lexer::token& t1, lexer::token& new_token) exprtk_override
             {
-               bool match         = false;
-               new_token.type     = lexer::token::e_mul;
-               new_token.value    = "*";
-               new_token.position = t1.position;
+               bool match = false;
+
+               if      ((t0.type == lexer::token::e_number     ) && (t1.type == lexer::token::e_symbol     )) match = true;
+               else if ((t0.type == lexer::token::e_number     ) && (t1.type == lexer::token::e_lbracket   )) match = true;
+               else if ((t0.type == lexer::token::e_number     ) && (t1.type == lexer::token::e_lcrlbracket)) match = true;
+               else if ((t0.type == lexer::token::e_number     ) && (t1.type == lexer::token::e_lsqrbracket)) match = true;
+               else if ((t0.type == lexer::token::e_symbol     ) && (t1.type == lexer::token::e_number     )) match = true;
+               else if ((t0.type == lexer::token::e_rbracket   ) && (t1.type == lexer::token::e_number     )) match = true;
+               else if ((t0.type == lexer::token::e_rcrlbracket) && (t1.type == lexer::token::e_number     )) match = true;
+               else if ((t0.type == lexer::token::e_rsqrbracket) && (t1.type == lexer::token::e_number     )) match = true;
+               else if ((t0.type == lexer::token::e_rbracket   ) && (t1.type == lexer::token::e_symbol     )) match = true;
+               else if ((t0.type == lexer::token::e_rcrlbracket) && (t1.type == lexer::token::e_symbol     )) match = true;
+               else if ((t0.type == lexer::token::e_rsqrbracket) && (t1.type == lexer::token::e_symbol     )) match = true;
+               else if ((t0.type == lexer::token::e_symbol     ) && (t1.type == lexer::token::e_symbol     )) match = true;
+
+               // Most pairs fail on their types alone, so the symbol lookups come last
+               if (!match)
+               {
+                  return -1;
+               }
 
                if (t0.type == lexer::token::e_symbol)
                {
@@ -3579,20 +4584,12 @@ namespace exprtk
                      return -1;
                   }
                }
-               if      ((t0.type == lexer::token::e_number     ) && (t1.type == lexer::token::e_symbol     )) match = true;
-               else if ((t0.type == lexer::token::e_number     ) && (t1.type == lexer::token::e_lbracket   )) match = true;
-               else if ((t0.type == lexer::token::e_number     ) && (t1.type == lexer::token::e_lcrlbracket)) match = true;
-               else if ((t0.type == lexer::token::e_number     ) && (t1.type == lexer::token::e_lsqrbracket)) match = true;
-               else if ((t0.type == lexer::token::e_symbol     ) && (t1.type == lexer::token::e_number     )) match = true;
-               else if ((t0.type == lexer::token::e_rbracket   ) && (t1.type == lexer::token::e_number     )) match = true;
-               else if ((t0.type == lexer::token::e_rcrlbracket) && (t1.type == lexer::token::e_number     )) match = true;
-               else if ((t0.type == lexer::token::e_rsqrbracket) && (t1.type == lexer::token::e_number     )) match = true;
-               else if ((t0.type == lexer::token::e_rbracket   ) && (t1.type == lexer::token::e_symbol     )) match = true;
-               else if ((t0.type == lexer::token::e_rcrlbracket) && (t1.type == lexer::token::e_symbol     )) match = true;
-               else if ((t0.type == lexer::token::e_rsqrbracket) && (t1.type == lexer::token::e_symbol     )) match = true;
-               else if ((t0.type == lexer::token::e_symbol     ) && (t1.type == lexer::token::e_symbol     )) match = true;
 
-               return (match) ? 1 : -1;
+               new_token.type     = lexer::token::e_mul;
+               new_token.value    = "*";
+               new_token.position = t1.position;
+
+               return 1;
             }
 
          private:
@@ -3996,8 +4993,8 @@ namespace exprtk
          {
          private:
 
-            typedef std::pair<lexer::token::token_type,lexer::token::token_type> token_pair_t;
-            typedef std::set<token_pair_t> set_t;
+            // Token types are all below 128, pairs are looked up in a flat table
+            static const std::size_t type_count = 128;
 
          public:
 
@@ -4005,6 +5002,7 @@ namespace exprtk
 
             sequence_validator()
             : lexer::token_scanner(2)
+            , invalid_comb_(type_count * type_count, false)
             {
                add_invalid(lexer::token::e_number, lexer::token::e_number);
                add_invalid(lexer::token::e_string, lexer::token::e_string);
@@ -4038,13 +5036,15 @@ namespace exprtk
 
             bool operator() (const lexer::token& t0, const lexer::token& t1) exprtk_override
             {
-               const set_t::value_type p = std::make_pair(t0.type,t1.type);
-
                if (invalid_bracket_check(t0.type,t1.type))
                {
                   error_list_.push_back(std::make_pair(t0,t1));
                }
-               else if (invalid_comb_.find(p) != invalid_comb_.end())
+               else if (
+                         (static_cast<std::size_t>(t0.type) < type_count) &&
+                         (static_cast<std::size_t>(t1.type) < type_count) &&
+                         invalid_comb_[t0.type * type_count + t1.type]
+                       )
                {
                   error_list_.push_back(std::make_pair(t0,t1));
                }
@@ -4079,7 +5079,7 @@ namespace exprtk
 
             void add_invalid(const lexer::token::token_type base, const lexer::token::token_type t)
             {
-               invalid_comb_.insert(std::make_pair(base,t));
+               invalid_comb_[base * type_count + t] = true;
             }
 
             void add_invalid_set1(const lexer::token::token_type t)
@@ -4160,7 +5160,7 @@ namespace exprtk
                return false;
             }
 
-            set_t invalid_comb_;
+            std::vector<bool> invalid_comb_;
             std::vector<std::pair<lexer::token,lexer::token> > error_list_;
          };
 
@@ -4172,12 +5172,15 @@ namespace exprtk
             typedef std::pair<token_t,std::pair<token_t,token_t> > token_triplet_t;
             typedef std::set<token_triplet_t> set_t;
 
+            static const std::size_t type_count = 128;
+
          public:
 
             using lexer::token_scanner::operator();
 
             sequence_validator_3tokens()
             : lexer::token_scanner(3)
+            , invalid_prefix_(type_count * type_count, false)
             {
                add_invalid(lexer::token::e_number , lexer::token::e_number , lexer::token::e_number);
                add_invalid(lexer::token::e_string , lexer::token::e_string , lexer::token::e_string);
@@ -4205,6 +5208,16 @@ namespace exprtk
 
             bool operator() (const lexer::token& t0, const lexer::token& t1, const lexer::token& t2) exprtk_override
             {
+               // Only the triplets that begin with a known invalid pair are looked up
+               if (
+                    (static_cast<std::size_t>(t0.type) >= type_count) ||
+                    (static_cast<std::size_t>(t1.type) >= type_count) ||
+                    !invalid_prefix_[t0.type * type_count + t1.type]
+                  )
+               {
+                  return true;
+               }
+
                const set_t::value_type p = std::make_pair(t0.type,std::make_pair(t1.type,t2.type));
 
                if (invalid_comb_.find(p) != invalid_comb_.end())
@@ -4243,9 +5256,11 @@ namespace exprtk
             void add_invalid(const token_t t0, const token_t t1, const token_t t2)
             {
                invalid_comb_.insert(std::make_pair(t0,std::make_pair(t1,t2)));
+               invalid_prefix_[t0 * type_count + t1] = true;
             }
 
             set_t invalid_comb_;
+            std::vector<bool> invalid_prefix_;
             std::vector<std::pair<lexer::token,lexer::token> > error_list_;
          };
 
@@ -4395,11 +5410,91 @@ namespace exprtk
                return true;
             }
 
+            /*
+               Equivalent to running the inserters, joiners, modifiers and
+               then the scanners, but in a single pass over the tokens.
+            */
+            inline bool run_pipeline(lexer::generator& g)
+            {
+               error_token_inserter = reinterpret_cast<lexer::token_inserter*>(0);
+               error_token_joiner   = reinterpret_cast<lexer::token_joiner*  >(0);
+               error_token_modifier = reinterpret_cast<lexer::token_modifier*>(0);
+               error_token_scanner  = reinterpret_cast<lexer::token_scanner* >(0);
+
+               pipeline.clear();
+
+               for (std::size_t i = 0; i < token_inserter_list.size(); ++i)
+               {
+                  token_inserter_list[i]->reset();
+                  pipeline.add_inserter(token_inserter_list[i]);
+               }
+
+               for (std::size_t i = 0; i < token_joiner_list.size(); ++i)
+               {
+                  token_joiner_list[i]->reset();
+                  pipeline.add_joiner(token_joiner_list[i]);
+               }
+
+               for (std::size_t i = 0; i < token_modifier_list.size(); ++i)
+               {
+                  token_modifier_list[i]->reset();
+                  pipeline.add_modifier(token_modifier_list[i]);
+               }
+
+               for (std::size_t i = 0; i < token_scanner_list.size(); ++i)
+               {
+                  token_scanner_list[i]->reset();
+                  pipeline.add_scanner(token_scanner_list[i]);
+               }
+
+               pipeline.process(g);
+
+               for (std::size_t i = 0; i < token_inserter_list.size(); ++i)
+               {
+                  if (!token_inserter_list[i]->result())
+                  {
+                     error_token_inserter = token_inserter_list[i];
+                     return false;
+                  }
+               }
+
+               for (std::size_t i = 0; i < token_joiner_list.size(); ++i)
+               {
+                  if (!token_joiner_list[i]->result())
+                  {
+                     error_token_joiner = token_joiner_list[i];
+                     return false;
+                  }
+               }
+
+               for (std::size_t i = 0; i < token_modifier_list.size(); ++i)
+               {
+                  if (!token_modifier_list[i]->result())
+                  {
+                     error_token_modifier = token_modifier_list[i];
+                     return false;
+                  }
+               }
+
+               for (std::size_t i = 0; i < token_scanner_list.size(); ++i)
+               {
+                  if (!token_scanner_list[i]->result())
+                  {
+                     error_token_scanner = token_scanner_list[i];
+                     return false;
+                  }
+               }
+
+               return true;
+            }
+
             std::vector<lexer::token_scanner*>  token_scanner_list;
             std::vector<lexer::token_modifier*> token_modifier_list;
             std::vector<lexer::token_joiner*>   token_joiner_list;
             std::vector<lexer::token_inserter*> token_inserter_list;
 
+            lexer::token_pipeline pipeline;
+
             lexer::token_scanner*  error_token_scanner;
             lexer::token_modifier* error_token_modifier;
             lexer::token_joiner*   error_token_joiner;
@@ -4414,6 +5509,11 @@ namespace exprtk
          typedef token     token_t;
          typedef generator generator_t;
 
+         parser_helper()
+         : current_token_index_(0)
+         , store_current_token_index_(0)
+         {}
+
          inline bool init(const std::string& str)
          {
             if (!lexer_.process(str))
@@ -4441,18 +5541,21 @@ namespace exprtk
          inline void store_token()
          {
             lexer_.store();
-            store_current_token_ = current_token_;
+            store_current_token_       = current_token_;
+            store_current_token_index_ = current_token_index_;
          }
 
          inline void restore_token()
          {
             lexer_.restore();
-            current_token_ = store_current_token_;
+            current_token_       = store_current_token_;
+            current_token_index_ = store_current_token_index_;
          }
 
          inline void next_token()
          {
-            current_token_ = lexer_.next_token();
+            current_token_index_ = lexer_.next_token_index();
+            current_token_       = lexer_.next_token();
          }
 
          inline const token_t& current_token() const
@@ -4460,6 +5563,12 @@ namespace exprtk
             return current_token_;
          }
 
+         // Index of the current token in the lexer's token list
+         inline std::size_t current_token_index() const
+         {
+            return current_token_index_;
+         }
+
          inline const token_t& peek_next_token()
          {
             return lexer_.peek_next_token();
@@ -4627,6 +5736,8 @@ namespace exprtk
          generator_t lexer_;
          token_t     current_token_;
          token_t     store_current_token_;
+         std::size_t current_token_index_;
+         std::size_t store_current_token_index_;
       };
    }
 
@@ -5117,6 +6228,12 @@ namespace exprtk
          results_available_ = true;
       }
 
+      // Sized at compile time, so that assign never reallocates
+      inline void reserve(const std::size_t size)
+      {
+         parameter_list_.reserve(size);
+      }
+
       bool results_available_;
       ts_list_t parameter_list_;
 
@@ -5126,6 +6243,116 @@ namespace exprtk
       #endif
    };
 
+   #ifndef exprtk_vector_storage_alignment
+   #define exprtk_vector_storage_alignment 64
+   #endif
+
+   #ifndef exprtk_vector_huge_page_size
+   #define exprtk_vector_huge_page_size (2 * 1024 * 1024)
+   #endif
+
+   class vector_storage_allocator
+   {
+   public:
+
+      virtual ~vector_storage_allocator()
+      {}
+
+      /*
+         Raw storage for local vectors (var v[n]) and vector temporaries.
+         The returned block need not be aligned, alignment to
+         exprtk_vector_storage_alignment bytes is applied by the caller.
+         Return null upon failure.
+      */
+      virtual void* allocate(const std::size_t size_in_bytes) = 0;
+
+      virtual void deallocate(void* ptr, const std::size_t size_in_bytes) = 0;
+   };
+
+   namespace details
+   {
+      struct default_vector_storage
+      {
+         #if defined(exprtk_enable_vector_huge_pages) && defined(__linux__)
+         /*
+            Blocks of at least one huge page are mapped directly, first
+            via MAP_HUGETLB (reserved huge pages), and failing that as
+            regular anonymous pages advised for transparent huge pages.
+         */
+         static inline void* allocate(const std::size_t size_in_bytes)
+         {
+            if (size_in_bytes < exprtk_vector_huge_page_size)
+               return std::malloc(size_in_bytes);
+
+            const std::size_t length = mapped_length(size_in_bytes);
+
+            #ifdef MAP_HUGETLB
+            void* ptr = mmap(0, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+            if (MAP_FAILED != ptr)
+               return ptr;
+            #endif
+
+            void* ptr_thp = mmap(0, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            if (MAP_FAILED == ptr_thp)
+               return 0;
+
+            #ifdef MADV_HUGEPAGE
+            madvise(ptr_thp, length, MADV_HUGEPAGE);
+            #endif
+
+            return ptr_thp;
+         }
+
+         static inline void deallocate(void* ptr, const std::size_t size_in_bytes)
+         {
+            if (size_in_bytes < exprtk_vector_huge_page_size)
+               std::free(ptr);
+            else
+               munmap(ptr, mapped_length(size_in_bytes));
+         }
+
+         static inline std::size_t mapped_length(const std::size_t size_in_bytes)
+         {
+            const std::size_t page_size = exprtk_vector_huge_page_size;
+            return ((size_in_bytes + page_size - 1) / page_size) * page_size;
+         }
+         #else
+         static inline void* allocate(const std::size_t size_in_bytes)
+         {
+            return std::malloc(size_in_bytes);
+         }
+
+         static inline void deallocate(void* ptr, const std::size_t)
+         {
+            std::free(ptr);
+         }
+         #endif
+      };
+
+      inline vector_storage_allocator*& vector_storage_allocator_instance()
+      {
+         static vector_storage_allocator* allocator = 0;
+         return allocator;
+      }
+   }
+
+   /*
+      Replaces the process-wide allocator used for vector storage. Each
+      block records the allocator that created it, so the allocator must
+      outlive every expression compiled while it was registered.
+   */
+   inline void register_vector_storage_allocator(vector_storage_allocator& allocator)
+   {
+      details::vector_storage_allocator_instance() = &allocator;
+   }
+
+   inline void reset_vector_storage_allocator()
+   {
+      details::vector_storage_allocator_instance() = 0;
+   }
+
    namespace details
    {
       enum operator_type
@@ -5302,6 +6529,70 @@ namespace exprtk
       inline void dump_vector(const std::string&, const T*, const std::size_t) {}
       #endif
 
+      template <typename T>
+      struct vector_storage
+      {
+         struct header
+         {
+            void*                     base;
+            vector_storage_allocator* allocator;
+            std::size_t               size_in_bytes;
+            std::size_t               size;
+         };
+
+         static inline T* create(const std::size_t& size)
+         {
+            vector_storage_allocator* allocator = vector_storage_allocator_instance();
+
+            const std::size_t alignment     = exprtk_vector_storage_alignment;
+            const std::size_t size_in_bytes = (size * sizeof(T)) + sizeof(header) + alignment;
+
+            char* base = reinterpret_cast<char*>(allocator ?
+                            allocator->allocate(size_in_bytes) :
+                            default_vector_storage::allocate(size_in_bytes));
+
+            if (0 == base)
+            {
+               throw std::bad_alloc();
+            }
+
+            const std::size_t data_offset = sizeof(header) + (alignment - ((reinterpret_cast<std::size_t>(base) + sizeof(header)) % alignment)) % alignment;
+
+            T* data = reinterpret_cast<T*>(base + data_offset);
+
+            header* hdr = reinterpret_cast<header*>(base + data_offset - sizeof(header));
+            hdr->base          = base;
+            hdr->allocator     = allocator;
+            hdr->size_in_bytes = size_in_bytes;
+            hdr->size          = size;
+
+            for (std::size_t i = 0; i < size; ++i)
+            {
+               new (data + i) T(0);
+            }
+
+            return data;
+         }
+
+         static inline void destroy(T* data)
+         {
+            if (0 == data)
+               return;
+
+            header* hdr = reinterpret_cast<header*>(reinterpret_cast<char*>(data) - sizeof(header));
+
+            for (std::size_t i = 0; i < hdr->size; ++i)
+            {
+               data[i].~T();
+            }
+
+            if (hdr->allocator)
+               hdr->allocator->deallocate(hdr->base, hdr->size_in_bytes);
+            else
+               default_vector_storage::deallocate(hdr->base, hdr->size_in_bytes);
+         }
+      };
+
       template <typename T>
       class vec_data_store
       {
@@ -5340,7 +6631,7 @@ namespace exprtk
                if (data && destruct && (0 == ref_count))
                {
                   dump_ptr("~vec_data_store::control_block() data",data);
-                  delete[] data;
+                  vector_storage<T>::destroy(data);
                   data = reinterpret_cast<data_t>(0);
                }
             }
@@ -5387,8 +6678,7 @@ namespace exprtk
             inline void create_data()
             {
                destruct = true;
-               data     = new T[size];
-               std::fill_n(data, size, T(0));
+               data     = vector_storage<T>::create(size);
                dump_ptr("control_block::create_data() - data", data, size);
             }
          };
@@ -5711,7 +7001,9 @@ namespace exprtk
             e_vecvecswap    , e_vecvecineq    , e_vecvalineq  , e_valvecineq   ,
             e_vecvecarith   , e_vecvalarith   , e_valvecarith , e_vecunaryop   ,
             e_vecondition   , e_break         , e_continue    , e_swap         ,
-            e_assert
+            e_assert        , e_bitvector     , e_bitvecelem  , e_bitvecinit   ,
+            e_bitvecfunc    , e_csescope      , e_cseref      , e_csebarrier   ,
+            e_strset
          };
 
          typedef T value_type;
@@ -5887,6 +7179,18 @@ namespace exprtk
          return node && (details::expression_node<T>::e_vector == node->type());
       }
 
+      template <typename T>
+      inline bool is_bitvector_node(const expression_node<T>* node)
+      {
+         return node && (details::expression_node<T>::e_bitvector == node->type());
+      }
+
+      template <typename T>
+      inline bool is_bitvector_elem_node(const expression_node<T>* node)
+      {
+         return node && (details::expression_node<T>::e_bitvecelem == node->type());
+      }
+
       template <typename T>
       inline bool is_ivector_node(const expression_node<T>* node)
       {
@@ -6953,6 +8257,12 @@ namespace exprtk
          virtual char_cptr   base() const = 0;
 
          virtual std::size_t size() const = 0;
+
+         // Size the node's string is expected to reach, used to reserve buffers at compile time
+         virtual std::size_t capacity_hint() const
+         {
+            return size();
+         }
       };
 
       template <typename T>
@@ -8407,513 +9717,1207 @@ namespace exprtk
          std::vector<branch_t> arg_list_;
       };
 
-      template <typename T>
-      class ivariable
+      #ifndef exprtk_disable_string_capabilities
+      class string_literal_table
       {
       public:
 
-         virtual ~ivariable()
-         {}
+         // Lookup of a string among a set of literals, each mapped to
+         // a value: small sets are searched linearly, larger ones via
+         // an open addressing hash table of the precomputed literal
+         // hashes. The table grows geometrically, so that building a
+         // set of n literals costs O(n).
 
-         virtual T& ref() = 0;
-         virtual const T& ref() const = 0;
-      };
+         static const std::size_t linear_search_limit = 4;
 
-      template <typename T>
-      class variable_node exprtk_final
-                          : public expression_node<T>
-                          , public ivariable      <T>
-      {
-      public:
+         string_literal_table()
+         : table_mask_(0)
+         {}
 
-         static T null_value;
+         // A literal inserted as 'first' takes precedence over an
+         // equal literal already present, otherwise the existing
+         // literal keeps its value.
+         inline void insert(const std::string& literal, const std::size_t value, const bool first)
+         {
+            const unsigned int h = hash(literal);
+            const std::size_t index = index_of(literal, h);
 
-         explicit variable_node()
-         : value_(&null_value)
-         {}
+            if (index < literal_list_.size())
+            {
+               if (first)
+               {
+                  value_list_[index] = value;
+               }
 
-         explicit variable_node(T& v)
-         : value_(&v)
-         {}
+               return;
+            }
 
-         inline bool operator <(const variable_node<T>& v) const
-         {
-            return this < (&v);
-         }
+            literal_list_.push_back(literal);
+            hash_list_   .push_back(h);
+            value_list_  .push_back(value);
 
-         inline T value() const exprtk_override
-         {
-            return (*value_);
+            if ((2 * literal_list_.size()) > table_.size())
+               build_table();
+            else
+               place(literal_list_.size() - 1);
          }
 
-         inline T& ref() exprtk_override
+         inline std::size_t size() const
          {
-            return (*value_);
+            return literal_list_.size();
          }
 
-         inline const T& ref() const exprtk_override
+         inline bool empty() const
          {
-            return (*value_);
+            return literal_list_.empty();
          }
 
-         inline typename expression_node<T>::node_type type() const exprtk_override
+         inline bool find(const std::string& s, std::size_t& value) const
          {
-            return expression_node<T>::e_variable;
-         }
+            std::size_t index = literal_list_.size();
 
-      private:
+            if (literal_list_.size() <= linear_search_limit)
+            {
+               for (std::size_t i = 0; i < literal_list_.size(); ++i)
+               {
+                  if (literal_list_[i] == s)
+                  {
+                     index = i;
+                     break;
+                  }
+               }
+            }
+            else
+               index = index_of(s, hash(s));
 
-         T* value_;
-      };
+            if (index < literal_list_.size())
+            {
+               value = value_list_[index];
+               return true;
+            }
 
-      template <typename T>
-      T variable_node<T>::null_value = T(std::numeric_limits<T>::quiet_NaN());
+            return false;
+         }
 
-      template <typename T>
-      struct range_pack
-      {
-         typedef expression_node<T>*                expression_node_ptr;
-         typedef std::pair<std::size_t,std::size_t> cached_range_t;
+      private:
 
-         struct size_holder_t
+         static inline unsigned int hash(const std::string& s)
          {
-            std::size_t size_;
-
-            size_holder_t(const std::size_t sz = std::numeric_limits<std::size_t>::max())
-            : size_(sz)
-            {}
+            unsigned int h = 2166136261U;
 
-            std::size_t size() const
+            for (std::size_t i = 0; i < s.size(); ++i)
             {
-               return size_;
+               h ^= static_cast<unsigned char>(s[i]);
+               h *= 16777619U;
             }
-         };
-
-         range_pack()
-         : n0_e (std::make_pair(false,expression_node_ptr(0)))
-         , n1_e (std::make_pair(false,expression_node_ptr(0)))
-         , n0_c (std::make_pair(false,0))
-         , n1_c (std::make_pair(false,0))
-         , cache(std::make_pair(0,0))
-         {}
 
-         void clear()
-         {
-            n0_e  = std::make_pair(false,expression_node_ptr(0));
-            n1_e  = std::make_pair(false,expression_node_ptr(0));
-            n0_c  = std::make_pair(false,0);
-            n1_c  = std::make_pair(false,0);
-            cache = std::make_pair(0,0);
+            return h;
          }
 
-         void free()
+         inline std::size_t index_of(const std::string& s, const unsigned int h) const
          {
-            if (n0_e.first && n0_e.second)
-            {
-               n0_e.first = false;
-
-               if (
-                    !is_variable_node(n0_e.second) &&
-                    !is_string_node  (n0_e.second)
-                  )
-               {
-                  destroy_node(n0_e.second);
-               }
-            }
+            if (table_.empty())
+               return literal_list_.size();
 
-            if (n1_e.first && n1_e.second)
+            for (std::size_t i = (h & table_mask_); table_[i] < literal_list_.size(); i = ((i + 1) & table_mask_))
             {
-               n1_e.first = false;
+               const std::size_t index = table_[i];
 
-               if (
-                    !is_variable_node(n1_e.second) &&
-                    !is_string_node  (n1_e.second)
-                  )
-               {
-                  destroy_node(n1_e.second);
-               }
+               if ((hash_list_[index] == h) && (literal_list_[index] == s))
+                  return index;
             }
-         }
 
-         bool const_range() const
-         {
-           return ( n0_c.first &&  n1_c.first) &&
-                  (!n0_e.first && !n1_e.first);
-         }
-
-         bool var_range() const
-         {
-           return ( n0_e.first &&  n1_e.first) &&
-                  (!n0_c.first && !n1_c.first);
+            return literal_list_.size();
          }
 
-         template <typename StrBaseType>
-         bool operator() (std::size_t& r0, std::size_t& r1, const StrBaseType& str_base) const
+         inline void place(const std::size_t index)
          {
-            if (n0_c.first)
-               r0 = n0_c.second;
-            else if (n0_e.first)
-            {
-               r0 = static_cast<std::size_t>(details::numeric::to_int64(n0_e.second->value()));
-            }
-            else
-               return false;
-
-            if (n1_c.first)
-               r1 = n1_c.second;
-            else if (n1_e.first)
-            {
-               r1 = static_cast<std::size_t>(details::numeric::to_int64(n1_e.second->value()));
-            }
-            else
-               return false;
-
-            const std::size_t size = str_base.size();
+            std::size_t i = (hash_list_[index] & table_mask_);
 
-            if (
-                 (std::numeric_limits<std::size_t>::max() != size) &&
-                 (std::numeric_limits<std::size_t>::max() == r1  )
-               )
+            while (table_[i] < literal_list_.size())
             {
-               r1 = size;
+               i = ((i + 1) & table_mask_);
             }
 
-            cache.first  = r0;
-            cache.second = r1;
-
-            #ifdef exprtk_enable_range_runtime_checks
-            return range_runtime_check(r0, r1, size);
-            #else
-            return (r0 <= r1) && (r1 <= size);
-            #endif
-         }
-
-         inline std::size_t const_size() const
-         {
-            return (n1_c.second - n0_c.second);
+            table_[i] = index;
          }
 
-         inline std::size_t cache_size() const
+         inline void build_table()
          {
-            return (cache.second - cache.first);
-         }
-
-         std::pair<bool,expression_node_ptr> n0_e;
-         std::pair<bool,expression_node_ptr> n1_e;
-         std::pair<bool,std::size_t        > n0_c;
-         std::pair<bool,std::size_t        > n1_c;
-         mutable cached_range_t             cache;
+            std::size_t table_size = 8;
 
-         #ifdef exprtk_enable_range_runtime_checks
-         bool range_runtime_check(const std::size_t r0,
-                                  const std::size_t r1,
-                                  const std::size_t size) const
-         {
-            if (r0 > size)
+            while (table_size < (4 * literal_list_.size()))
             {
-               throw std::runtime_error("range error: (r0 < 0) || (r0 > size)");
-               #if !defined(_MSC_VER) && !defined(__NVCOMPILER)
-               return false;
-               #endif
+               table_size <<= 1;
             }
 
-            if (r1 > size)
+            table_.assign(table_size, std::numeric_limits<std::size_t>::max());
+            table_mask_ = table_size - 1;
+
+            for (std::size_t index = 0; index < literal_list_.size(); ++index)
             {
-               throw std::runtime_error("range error: (r1 < 0) || (r1 > size)");
-               #if !defined(_MSC_VER) && !defined(__NVCOMPILER)
-               return false;
-               #endif
+               place(index);
             }
-
-            return (r0 <= r1);
          }
-         #endif
-      };
-
-      template <typename T>
-      class string_base_node;
-
-      template <typename T>
-      struct range_data_type
-      {
-         typedef range_pack<T> range_t;
-         typedef string_base_node<T>* strbase_ptr_t;
-
-         range_data_type()
-         : range(0)
-         , data (0)
-         , size (0)
-         , type_size(0)
-         , str_node (0)
-         {}
 
-         range_t*      range;
-         void*         data;
-         std::size_t   size;
-         std::size_t   type_size;
-         strbase_ptr_t str_node;
+         std::vector<std::string>  literal_list_;
+         std::vector<unsigned int> hash_list_;
+         std::vector<std::size_t>  value_list_;
+         std::vector<std::size_t>  table_;
+         std::size_t               table_mask_;
       };
 
-      template <typename T> class vector_node;
-
       template <typename T>
-      class vector_interface
+      class string_switch_node exprtk_final : public expression_node<T>
       {
       public:
 
-         typedef vector_node<T>*   vector_node_ptr;
-         typedef vec_data_store<T> vds_t;
-
-         virtual ~vector_interface()
-         {}
-
-         virtual std::size_t size     () const = 0;
-
-         virtual std::size_t base_size() const = 0;
-
-         virtual vector_node_ptr vec  () const = 0;
-
-         virtual vector_node_ptr vec  ()       = 0;
-
-         virtual       vds_t& vds     ()       = 0;
-
-         virtual const vds_t& vds     () const = 0;
-
-         virtual bool side_effect     () const { return false; }
-      };
-
-      template <typename T>
-      class vector_node exprtk_final
-                        : public expression_node <T>
-                        , public vector_interface<T>
-      {
-      public:
+         // Switch over the value of a string variable compared
+         // against string literals, the cases being looked up in
+         // a string_literal_table. Cases are stored in the order
+         // they are added, the table resolving their precedence.
 
          typedef expression_node<T>* expression_ptr;
-         typedef vector_holder<T>    vector_holder_t;
-         typedef vector_node<T>*     vector_node_ptr;
-         typedef vec_data_store<T>   vds_t;
-
-         explicit vector_node(vector_holder_t* vh)
-         : vector_holder_(vh)
-         , vds_((*vector_holder_).size(),(*vector_holder_)[0])
-         {
-            vector_holder_->set_ref(&vds_.ref());
-         }
-
-         vector_node(const vds_t& vds, vector_holder_t* vh)
-         : vector_holder_(vh)
-         , vds_(vds)
-         {}
+         typedef std::pair<expression_ptr,bool> branch_t;
 
-        ~vector_node() exprtk_override
+         string_switch_node(const std::string& str, expression_ptr default_statement)
+         : str_(&str)
          {
-            assert(valid());
-            vector_holder_->remove_ref(&vds_.ref());
+            branch_list_.push_back(branch_t(reinterpret_cast<expression_ptr>(0), false));
+            construct_branch_pair(branch_list_.back(), default_statement);
          }
 
-         inline T value() const exprtk_override
+         // A case added as 'first' takes precedence over those already added
+         inline void add_case(const std::string& literal, expression_ptr consequent, const bool first)
          {
-            return vds().data()[0];
-         }
+            branch_t branch(reinterpret_cast<expression_ptr>(0), false);
+            construct_branch_pair(branch, consequent);
 
-         vector_node_ptr vec() const exprtk_override
-         {
-            return const_cast<vector_node_ptr>(this);
-         }
+            const std::size_t index = branch_list_.size() - 1;
 
-         vector_node_ptr vec() exprtk_override
-         {
-            return this;
-         }
+            branch_list_.insert(branch_list_.end() - 1, branch);
 
-         inline typename expression_node<T>::node_type type() const exprtk_override
-         {
-            return expression_node<T>::e_vector;
+            literal_table_.insert(literal, index, first);
          }
 
-         inline bool valid() const exprtk_override
+         inline const std::string& str() const
          {
-            return vector_holder_;
+            return (*str_);
          }
 
-         std::size_t size() const exprtk_override
+         inline T value() const exprtk_override
          {
-            return vec_holder().size();
-         }
+            std::size_t index = 0;
 
-         std::size_t base_size() const exprtk_override
-         {
-            return vec_holder().base_size();
+            if (literal_table_.find(*str_, index))
+               return branch_list_[index].first->value();
+            else if (branch_list_.back().first)
+               return branch_list_.back().first->value();
+            else
+               return std::numeric_limits<T>::quiet_NaN();
          }
 
-         vds_t& vds() exprtk_override
+         inline typename expression_node<T>::node_type type() const exprtk_override
          {
-            return vds_;
+            return expression_node<T>::e_switch;
          }
 
-         const vds_t& vds() const exprtk_override
+         inline bool valid() const exprtk_override
          {
-            return vds_;
+            return (0 != str_) && !literal_table_.empty();
          }
 
-         inline vector_holder_t& vec_holder()
+         void collect_nodes(typename expression_node<T>::noderef_list_t& node_delete_list) exprtk_override
          {
-            return (*vector_holder_);
+            expression_node<T>::ndb_t::collect(branch_list_, node_delete_list);
          }
 
-         inline vector_holder_t& vec_holder() const
+         std::size_t node_depth() const exprtk_override
          {
-            return (*vector_holder_);
+            return expression_node<T>::ndb_t::compute_node_depth(branch_list_);
          }
 
       private:
 
-         vector_holder_t* vector_holder_;
-         vds_t                      vds_;
+         const std::string*    str_;
+         string_literal_table  literal_table_;
+         std::vector<branch_t> branch_list_;
       };
 
       template <typename T>
-      class vector_size_node exprtk_final
-                        : public expression_node <T>
+      class string_set_node exprtk_final : public expression_node<T>
       {
       public:
 
-         typedef expression_node<T>* expression_ptr;
-         typedef vector_holder<T>    vector_holder_t;
+         // Membership of a string variable in a set of literals, as
+         // folded from 's == lit0 or s == lit1 or ...'
 
-         explicit vector_size_node(vector_holder_t* vh)
-         : vector_holder_(vh)
+         explicit string_set_node(const std::string& str)
+         : str_(&str)
          {}
 
-        ~vector_size_node() exprtk_override
+         inline void add_literal(const std::string& literal)
          {
-            assert(valid());
+            literal_table_.insert(literal, 0, false);
          }
 
-         inline T value() const exprtk_override
+         inline const std::string& str() const
          {
-            assert(vector_holder_);
-            return static_cast<T>(vector_holder_->size());
+            return (*str_);
          }
 
-         inline typename expression_node<T>::node_type type() const exprtk_override
+         inline T value() const exprtk_override
          {
-            return expression_node<T>::e_vecsize;
+            std::size_t index = 0;
+            return literal_table_.find(*str_, index) ? T(1) : T(0);
          }
 
-         inline bool valid() const exprtk_override
+         inline typename expression_node<T>::node_type type() const exprtk_override
          {
-            return vector_holder_ && vector_holder_->size();
+            return expression_node<T>::e_strset;
          }
 
-         inline vector_holder_t* vec_holder()
+         inline bool valid() const exprtk_override
          {
-            return vector_holder_;
+            return (0 != str_) && !literal_table_.empty();
          }
 
       private:
 
-         vector_holder_t* vector_holder_;
+         const std::string*   str_;
+         string_literal_table literal_table_;
       };
+      #endif
 
       template <typename T>
-      class vector_elem_node exprtk_final
-                             : public expression_node<T>
-                             , public ivariable      <T>
+      class numeric_switch_node : public expression_node<T>
       {
       public:
 
-         typedef expression_node<T>*            expression_ptr;
-         typedef vector_holder<T>               vector_holder_t;
-         typedef vector_holder_t*               vector_holder_ptr;
+         // Switch whose cases are all of the form 'var == constant'
+         // over the same variable. Integral keys spanning a compact
+         // range are dispatched through a dense jump table, all other
+         // key sets through a binary search of the sorted keys.
+
+         typedef expression_node<T>* expression_ptr;
          typedef std::pair<expression_ptr,bool> branch_t;
 
-         vector_elem_node(expression_ptr vec_node,
-                          expression_ptr index,
-                          vector_holder_ptr vec_holder)
-         : vector_holder_(vec_holder)
-         , vector_base_((*vec_holder)[0])
-         {
-            construct_branch_pair(vector_node_, vec_node);
-            construct_branch_pair(index_      , index   );
-            assert(valid());
-         }
+         static const std::size_t npos = static_cast<std::size_t>(-1);
 
-         inline T value() const exprtk_override
+         template <typename Allocator,
+                   template <typename, typename> class Sequence>
+         numeric_switch_node(const T& var,
+                             const std::vector<T>& key_list,
+                             const Sequence<expression_ptr,Allocator>& consequent_list,
+                             expression_ptr default_statement)
+         : var_(&var)
+         , dense_base_(0)
          {
-            return *access_vector();
-         }
+            // The default statement, if any, is the last branch
+            branch_list_.resize(consequent_list.size() + 1,
+                                branch_t(reinterpret_cast<expression_ptr>(0), false));
 
-         inline T& ref() exprtk_override
-         {
-            return *access_vector();
+            for (std::size_t i = 0; i < consequent_list.size(); ++i)
+            {
+               construct_branch_pair(branch_list_[i], consequent_list[i]);
+            }
+
+            construct_branch_pair(branch_list_.back(), default_statement);
+
+            build_dispatch(key_list);
          }
 
-         inline const T& ref() const exprtk_override
+         inline T value() const exprtk_override
          {
-            return *access_vector();
+            const std::size_t slot = find_slot(*var_);
+
+            if (npos != slot)
+               return branch_list_[index_list_[slot_list_[slot]]].first->value();
+            else if (branch_list_.back().first)
+               return branch_list_.back().first->value();
+            else
+               return std::numeric_limits<T>::quiet_NaN();
          }
 
          inline typename expression_node<T>::node_type type() const exprtk_override
          {
-            return expression_node<T>::e_vecelem;
+            return expression_node<T>::e_switch;
          }
 
          inline bool valid() const exprtk_override
          {
-            return
-               vector_holder_        &&
-               index_.first          &&
-               vector_node_.first    &&
-               index_.first->valid() &&
-               vector_node_.first->valid();
-         }
-
-         inline vector_holder_t& vec_holder()
-         {
-            return (*vector_holder_);
+            return (0 != var_) && (branch_list_.size() > 1);
          }
 
          void collect_nodes(typename expression_node<T>::noderef_list_t& node_delete_list) exprtk_override
          {
-            expression_node<T>::ndb_t::collect(vector_node_, node_delete_list);
-            expression_node<T>::ndb_t::collect(index_      , node_delete_list);
+            expression_node<T>::ndb_t::collect(branch_list_, node_delete_list);
          }
 
          std::size_t node_depth() const exprtk_override
          {
-            return expression_node<T>::ndb_t::compute_node_depth
-               (vector_node_, index_);
+            return expression_node<T>::ndb_t::compute_node_depth(branch_list_);
          }
 
-      private:
+      protected:
 
-         inline T* access_vector() const
+         // Index into slot_list_ of the distinct key equal to v, or npos
+         inline std::size_t find_slot(const T v) const
          {
-            vector_node_.first->value();
-            return (vector_base_ + details::numeric::to_uint64(index_.first->value()));
-         }
+            if (!dense_table_.empty())
+            {
+               if ((v < dense_base_) || !(v < (dense_base_ + T(dense_table_.size()))))
+                  return npos;
 
-         vector_holder_ptr vector_holder_;
-         T* vector_base_;
-         branch_t vector_node_;
-         branch_t index_;
-      };
+               const T offset = v - dense_base_;
+               const std::size_t index = static_cast<std::size_t>(numeric::to_int64(offset));
 
-      template <typename T>
-      class vector_celem_node exprtk_final
-                              : public expression_node<T>
-                              , public ivariable      <T>
-      {
-      public:
+               if (T(index) != offset)
+                  return npos;
 
-         typedef expression_node<T>*            expression_ptr;
-         typedef vector_holder<T>               vector_holder_t;
-         typedef vector_holder_t*               vector_holder_ptr;
-         typedef std::pair<expression_ptr,bool> branch_t;
+               return dense_table_[index];
+            }
 
-         vector_celem_node(expression_ptr vec_node,
+            const typename std::vector<T>::const_iterator itr =
+               std::lower_bound(sorted_key_list_.begin(), sorted_key_list_.end(), v);
+
+            if ((sorted_key_list_.end() == itr) || !(*itr == v))
+               return npos;
+
+            return static_cast<std::size_t>(std::distance(sorted_key_list_.begin(), itr));
+         }
+
+         const T*              var_;
+         std::vector<branch_t> branch_list_;
+
+         // The case indices sharing the key of slot s, in case order, are
+         // index_list_[slot_list_[s] .. slot_list_[s + 1])
+         std::vector<std::size_t> slot_list_;
+         std::vector<std::size_t> index_list_;
+
+      private:
+
+         static const std::size_t max_dense_table_size = 65536;
+
+         inline void build_dispatch(const std::vector<T>& key_list)
+         {
+            std::vector<std::pair<T,std::size_t> > case_list;
+
+            for (std::size_t i = 0; i < key_list.size(); ++i)
+            {
+               // A NaN key can never be matched
+               if (key_list[i] == key_list[i])
+               {
+                  case_list.push_back(std::make_pair(key_list[i] + T(0), i));
+               }
+            }
+
+            std::sort(case_list.begin(), case_list.end());
+
+            for (std::size_t i = 0; i < case_list.size(); ++i)
+            {
+               if ((0 == i) || (case_list[i - 1].first < case_list[i].first))
+               {
+                  sorted_key_list_.push_back(case_list[i].first);
+                  slot_list_.push_back(index_list_.size());
+               }
+
+               index_list_.push_back(case_list[i].second);
+            }
+
+            slot_list_.push_back(index_list_.size());
+
+            if (sorted_key_list_.empty())
+               return;
+
+            const T min_key = sorted_key_list_.front();
+            const T range   = sorted_key_list_.back() - min_key;
+
+            const std::size_t max_range = std::min(static_cast<std::size_t>(max_dense_table_size), 2 * sorted_key_list_.size() + 8);
+
+            if (!(range < T(max_range)))
+               return;
+
+            for (std::size_t i = 0; i < sorted_key_list_.size(); ++i)
+            {
+               const T offset = sorted_key_list_[i] - min_key;
+
+               if (T(numeric::to_int64(offset)) != offset)
+                  return;
+            }
+
+            dense_base_ = min_key;
+            dense_table_.assign(static_cast<std::size_t>(numeric::to_int64(range)) + 1, static_cast<std::size_t>(npos));
+
+            for (std::size_t i = 0; i < sorted_key_list_.size(); ++i)
+            {
+               dense_table_[static_cast<std::size_t>(numeric::to_int64(sorted_key_list_[i] - min_key))] = i;
+            }
+         }
+
+         std::vector<T>           sorted_key_list_;
+         std::vector<std::size_t> dense_table_;
+         T                        dense_base_;
+      };
+
+      template <typename T>
+      class numeric_multi_switch_node exprtk_final : public numeric_switch_node<T>
+      {
+      public:
+
+         typedef expression_node<T>* expression_ptr;
+         typedef numeric_switch_node<T> parent_t;
+
+         template <typename Allocator,
+                   template <typename, typename> class Sequence>
+         numeric_multi_switch_node(const T& var,
+                                   const std::vector<T>& key_list,
+                                   const Sequence<expression_ptr,Allocator>& consequent_list)
+         : parent_t(var, key_list, consequent_list, reinterpret_cast<expression_ptr>(0))
+         {}
+
+         inline T value() const exprtk_override
+         {
+            // A consequent may modify the switch variable, hence after
+            // each one the next case is the first later case whose key
+            // matches the variable's current value.
+
+            T result = T(0);
+
+            std::size_t next_case = 0;
+
+            for ( ; ; )
+            {
+               const std::size_t slot = parent_t::find_slot(*parent_t::var_);
+
+               if (parent_t::npos == slot)
+                  break;
+
+               const std::size_t* begin = &parent_t::index_list_[0] + parent_t::slot_list_[slot    ];
+               const std::size_t* end   = &parent_t::index_list_[0] + parent_t::slot_list_[slot + 1];
+               const std::size_t* itr   = std::lower_bound(begin, end, next_case);
+
+               if (end == itr)
+                  break;
+
+               result    = parent_t::branch_list_[*itr].first->value();
+               next_case = (*itr) + 1;
+            }
+
+            return result;
+         }
+
+         inline typename expression_node<T>::node_type type() const exprtk_override
+         {
+            return expression_node<T>::e_mswitch;
+         }
+      };
+
+      /*
+         Common subexpression elimination: the scope node owns the
+         expression body and the definition of each shared
+         subexpression. Every occurrence is replaced by a reference
+         node, the first of which to be evaluated computes the
+         definition, the remainder reusing its value until the next
+         evaluation of the scope, or until a function call that may
+         have modified the symbols of a definition.
+      */
+      template <typename T>
+      class cse_scope_node exprtk_final : public expression_node<T>
+      {
+      public:
+
+         typedef expression_node<T>* expression_ptr;
+         typedef std::pair<expression_ptr,bool> branch_t;
+
+         explicit cse_scope_node(const std::size_t& definition_count)
+         : epoch_(0)
+         , definition_count_(definition_count)
+         , slot_list_(definition_count)
+         , branch_list_(definition_count + 1, branch_t(reinterpret_cast<expression_ptr>(0), false))
+         {}
+
+         inline T value() const exprtk_override
+         {
+            ++epoch_;
+
+            const T result = branch_list_[definition_count_].first->value();
+
+            /*
+               Should this evaluation have been nested within another one,
+               by way of a function that re-enters the scope, the slots it
+               filled must not be reused by the outer evaluation.
+            */
+            ++epoch_;
+
+            return result;
+         }
+
+         inline void invalidate() const
+         {
+            ++epoch_;
+         }
+
+         inline T evaluate(const std::size_t index) const
+         {
+            slot_t& slot = slot_list_[index];
+
+            if (slot.epoch != epoch_)
+            {
+               slot.value = branch_list_[index].first->value();
+               slot.epoch = epoch_;
+            }
+
+            return slot.value;
+         }
+
+         inline bool define(const std::size_t index, expression_ptr definition)
+         {
+            if ((index >= definition_count_) || (0 != branch_list_[index].first))
+               return false;
+
+            construct_branch_pair(branch_list_[index], definition);
+
+            return true;
+         }
+
+         inline void set_body(expression_ptr body)
+         {
+            construct_branch_pair(branch_list_[definition_count_], body);
+         }
+
+         inline typename expression_node<T>::node_type type() const exprtk_override
+         {
+            return expression_node<T>::e_csescope;
+         }
+
+         inline bool valid() const exprtk_override
+         {
+            return (0 != branch_list_[definition_count_].first);
+         }
+
+         void collect_nodes(typename expression_node<T>::noderef_list_t& node_delete_list) exprtk_override
+         {
+            expression_node<T>::ndb_t::collect(branch_list_, node_delete_list);
+         }
+
+         std::size_t node_depth() const exprtk_override
+         {
+            return expression_node<T>::ndb_t::compute_node_depth(branch_list_);
+         }
+
+      private:
+
+         struct slot_t
+         {
+            slot_t()
+            : value(T(0))
+            , epoch(0)
+            {}
+
+            T value;
+            std::size_t epoch;
+         };
+
+         mutable std::size_t epoch_;
+         const std::size_t definition_count_;
+         mutable std::vector<slot_t> slot_list_;
+         std::vector<branch_t> branch_list_;
+      };
+
+      template <typename T>
+      class cse_reference_node exprtk_final : public expression_node<T>
+      {
+      public:
+
+         typedef cse_scope_node<T>* scope_ptr;
+
+         cse_reference_node(scope_ptr scope, const std::size_t index)
+         : scope_(scope)
+         , index_(index)
+         {}
+
+         inline T value() const exprtk_override
+         {
+            return scope_->evaluate(index_);
+         }
+
+         inline typename expression_node<T>::node_type type() const exprtk_override
+         {
+            return expression_node<T>::e_cseref;
+         }
+
+         inline bool valid() const exprtk_override
+         {
+            return (0 != scope_);
+         }
+
+      private:
+
+         scope_ptr   scope_;
+         std::size_t index_;
+      };
+
+      template <typename T>
+      class cse_barrier_node exprtk_final : public expression_node<T>
+      {
+      public:
+
+         typedef expression_node<T>* expression_ptr;
+         typedef std::pair<expression_ptr,bool> branch_t;
+         typedef cse_scope_node<T>* scope_ptr;
+
+         cse_barrier_node(scope_ptr scope, expression_ptr call)
+         : scope_(scope)
+         {
+            construct_branch_pair(branch_, call);
+         }
+
+         inline T value() const exprtk_override
+         {
+            const T result = branch_.first->value();
+            scope_->invalidate();
+            return result;
+         }
+
+         inline typename expression_node<T>::node_type type() const exprtk_override
+         {
+            return expression_node<T>::e_csebarrier;
+         }
+
+         inline expression_node<T>* branch(const std::size_t&) const exprtk_override
+         {
+            return branch_.first;
+         }
+
+         inline bool valid() const exprtk_override
+         {
+            return scope_ && branch_.first;
+         }
+
+         void collect_nodes(typename expression_node<T>::noderef_list_t& node_delete_list) exprtk_override
+         {
+            expression_node<T>::ndb_t::collect(branch_, node_delete_list);
+         }
+
+         std::size_t node_depth() const exprtk_override
+         {
+            return expression_node<T>::ndb_t::compute_node_depth(branch_);
+         }
+
+      private:
+
+         scope_ptr scope_;
+         branch_t  branch_;
+      };
+
+      template <typename T>
+      class ivariable
+      {
+      public:
+
+         virtual ~ivariable()
+         {}
+
+         virtual T& ref() = 0;
+         virtual const T& ref() const = 0;
+      };
+
+      template <typename T>
+      class variable_node exprtk_final
+                          : public expression_node<T>
+                          , public ivariable      <T>
+      {
+      public:
+
+         static T null_value;
+
+         explicit variable_node()
+         : value_(&null_value)
+         {}
+
+         explicit variable_node(T& v)
+         : value_(&v)
+         {}
+
+         inline bool operator <(const variable_node<T>& v) const
+         {
+            return this < (&v);
+         }
+
+         inline T value() const exprtk_override
+         {
+            return (*value_);
+         }
+
+         inline T& ref() exprtk_override
+         {
+            return (*value_);
+         }
+
+         inline const T& ref() const exprtk_override
+         {
+            return (*value_);
+         }
+
+         inline typename expression_node<T>::node_type type() const exprtk_override
+         {
+            return expression_node<T>::e_variable;
+         }
+
+      private:
+
+         T* value_;
+      };
+
+      template <typename T>
+      T variable_node<T>::null_value = T(std::numeric_limits<T>::quiet_NaN());
+
+      template <typename T>
+      struct range_pack
+      {
+         typedef expression_node<T>*                expression_node_ptr;
+         typedef std::pair<std::size_t,std::size_t> cached_range_t;
+
+         struct size_holder_t
+         {
+            std::size_t size_;
+
+            size_holder_t(const std::size_t sz = std::numeric_limits<std::size_t>::max())
+            : size_(sz)
+            {}
+
+            std::size_t size() const
+            {
+               return size_;
+            }
+         };
+
+         range_pack()
+         : n0_e (std::make_pair(false,expression_node_ptr(0)))
+         , n1_e (std::make_pair(false,expression_node_ptr(0)))
+         , n0_c (std::make_pair(false,0))
+         , n1_c (std::make_pair(false,0))
+         , cache(std::make_pair(0,0))
+         {}
+
+         void clear()
+         {
+            n0_e  = std::make_pair(false,expression_node_ptr(0));
+            n1_e  = std::make_pair(false,expression_node_ptr(0));
+            n0_c  = std::make_pair(false,0);
+            n1_c  = std::make_pair(false,0);
+            cache = std::make_pair(0,0);
+         }
+
+         void free()
+         {
+            if (n0_e.first && n0_e.second)
+            {
+               n0_e.first = false;
+
+               if (
+                    !is_variable_node(n0_e.second) &&
+                    !is_string_node  (n0_e.second)
+                  )
+               {
+                  destroy_node(n0_e.second);
+               }
+            }
+
+            if (n1_e.first && n1_e.second)
+            {
+               n1_e.first = false;
+
+               if (
+                    !is_variable_node(n1_e.second) &&
+                    !is_string_node  (n1_e.second)
+                  )
+               {
+                  destroy_node(n1_e.second);
+               }
+            }
+         }
+
+         bool const_range() const
+         {
+           return ( n0_c.first &&  n1_c.first) &&
+                  (!n0_e.first && !n1_e.first);
+         }
+
+         bool var_range() const
+         {
+           return ( n0_e.first &&  n1_e.first) &&
+                  (!n0_c.first && !n1_c.first);
+         }
+
+         template <typename StrBaseType>
+         bool operator() (std::size_t& r0, std::size_t& r1, const StrBaseType& str_base) const
+         {
+            if (n0_c.first)
+               r0 = n0_c.second;
+            else if (n0_e.first)
+            {
+               r0 = static_cast<std::size_t>(details::numeric::to_int64(n0_e.second->value()));
+            }
+            else
+               return false;
+
+            if (n1_c.first)
+               r1 = n1_c.second;
+            else if (n1_e.first)
+            {
+               r1 = static_cast<std::size_t>(details::numeric::to_int64(n1_e.second->value()));
+            }
+            else
+               return false;
+
+            const std::size_t size = str_base.size();
+
+            if (
+                 (std::numeric_limits<std::size_t>::max() != size) &&
+                 (std::numeric_limits<std::size_t>::max() == r1  )
+               )
+            {
+               r1 = size;
+            }
+
+            cache.first  = r0;
+            cache.second = r1;
+
+            #ifdef exprtk_enable_range_runtime_checks
+            return range_runtime_check(r0, r1, size);
+            #else
+            return (r0 <= r1) && (r1 <= size);
+            #endif
+         }
+
+         inline std::size_t const_size() const
+         {
+            return (n1_c.second - n0_c.second);
+         }
+
+         inline std::size_t cache_size() const
+         {
+            return (cache.second - cache.first);
+         }
+
+         std::pair<bool,expression_node_ptr> n0_e;
+         std::pair<bool,expression_node_ptr> n1_e;
+         std::pair<bool,std::size_t        > n0_c;
+         std::pair<bool,std::size_t        > n1_c;
+         mutable cached_range_t             cache;
+
+         #ifdef exprtk_enable_range_runtime_checks
+         bool range_runtime_check(const std::size_t r0,
+                                  const std::size_t r1,
+                                  const std::size_t size) const
+         {
+            if (r0 > size)
+            {
+               throw std::runtime_error("range error: (r0 < 0) || (r0 > size)");
+               #if !defined(_MSC_VER) && !defined(__NVCOMPILER)
+               return false;
+               #endif
+            }
+
+            if (r1 > size)
+            {
+               throw std::runtime_error("range error: (r1 < 0) || (r1 > size)");
+               #if !defined(_MSC_VER) && !defined(__NVCOMPILER)
+               return false;
+               #endif
+            }
+
+            return (r0 <= r1);
+         }
+         #endif
+      };
+
+      template <typename T>
+      class string_base_node;
+
+      template <typename T>
+      struct range_data_type
+      {
+         typedef range_pack<T> range_t;
+         typedef string_base_node<T>* strbase_ptr_t;
+
+         range_data_type()
+         : range(0)
+         , data (0)
+         , size (0)
+         , type_size(0)
+         , str_node (0)
+         {}
+
+         range_t*      range;
+         void*         data;
+         std::size_t   size;
+         std::size_t   type_size;
+         strbase_ptr_t str_node;
+      };
+
+      template <typename T> class vector_node;
+
+      template <typename T>
+      class vector_interface
+      {
+      public:
+
+         typedef vector_node<T>*   vector_node_ptr;
+         typedef vec_data_store<T> vds_t;
+
+         virtual ~vector_interface()
+         {}
+
+         virtual std::size_t size     () const = 0;
+
+         virtual std::size_t base_size() const = 0;
+
+         virtual vector_node_ptr vec  () const = 0;
+
+         virtual vector_node_ptr vec  ()       = 0;
+
+         virtual       vds_t& vds     ()       = 0;
+
+         virtual const vds_t& vds     () const = 0;
+
+         virtual bool side_effect     () const { return false; }
+      };
+
+      template <typename T>
+      class vector_node exprtk_final
+                        : public expression_node <T>
+                        , public vector_interface<T>
+      {
+      public:
+
+         typedef expression_node<T>* expression_ptr;
+         typedef vector_holder<T>    vector_holder_t;
+         typedef vector_node<T>*     vector_node_ptr;
+         typedef vec_data_store<T>   vds_t;
+
+         explicit vector_node(vector_holder_t* vh)
+         : vector_holder_(vh)
+         , vds_((*vector_holder_).size(),(*vector_holder_)[0])
+         {
+            vector_holder_->set_ref(&vds_.ref());
+         }
+
+         vector_node(const vds_t& vds, vector_holder_t* vh)
+         : vector_holder_(vh)
+         , vds_(vds)
+         {}
+
+        ~vector_node() exprtk_override
+         {
+            assert(valid());
+            vector_holder_->remove_ref(&vds_.ref());
+         }
+
+         inline T value() const exprtk_override
+         {
+            return vds().data()[0];
+         }
+
+         vector_node_ptr vec() const exprtk_override
+         {
+            return const_cast<vector_node_ptr>(this);
+         }
+
+         vector_node_ptr vec() exprtk_override
+         {
+            return this;
+         }
+
+         inline typename expression_node<T>::node_type type() const exprtk_override
+         {
+            return expression_node<T>::e_vector;
+         }
+
+         inline bool valid() const exprtk_override
+         {
+            return vector_holder_;
+         }
+
+         std::size_t size() const exprtk_override
+         {
+            return vec_holder().size();
+         }
+
+         std::size_t base_size() const exprtk_override
+         {
+            return vec_holder().base_size();
+         }
+
+         vds_t& vds() exprtk_override
+         {
+            return vds_;
+         }
+
+         const vds_t& vds() const exprtk_override
+         {
+            return vds_;
+         }
+
+         inline vector_holder_t& vec_holder()
+         {
+            return (*vector_holder_);
+         }
+
+         inline vector_holder_t& vec_holder() const
+         {
+            return (*vector_holder_);
+         }
+
+      private:
+
+         vector_holder_t* vector_holder_;
+         vds_t                      vds_;
+      };
+
+      template <typename T>
+      class vector_size_node exprtk_final
+                        : public expression_node <T>
+      {
+      public:
+
+         typedef expression_node<T>* expression_ptr;
+         typedef vector_holder<T>    vector_holder_t;
+
+         explicit vector_size_node(vector_holder_t* vh)
+         : vector_holder_(vh)
+         {}
+
+        ~vector_size_node() exprtk_override
+         {
+            assert(valid());
+         }
+
+         inline T value() const exprtk_override
+         {
+            assert(vector_holder_);
+            return static_cast<T>(vector_holder_->size());
+         }
+
+         inline typename expression_node<T>::node_type type() const exprtk_override
+         {
+            return expression_node<T>::e_vecsize;
+         }
+
+         inline bool valid() const exprtk_override
+         {
+            return vector_holder_ && vector_holder_->size();
+         }
+
+         inline vector_holder_t* vec_holder()
+         {
+            return vector_holder_;
+         }
+
+      private:
+
+         vector_holder_t* vector_holder_;
+      };
+
+      template <typename T>
+      class vector_elem_node exprtk_final
+                             : public expression_node<T>
+                             , public ivariable      <T>
+      {
+      public:
+
+         typedef expression_node<T>*            expression_ptr;
+         typedef vector_holder<T>               vector_holder_t;
+         typedef vector_holder_t*               vector_holder_ptr;
+         typedef std::pair<expression_ptr,bool> branch_t;
+
+         vector_elem_node(expression_ptr vec_node,
+                          expression_ptr index,
+                          vector_holder_ptr vec_holder)
+         : vector_holder_(vec_holder)
+         , vector_base_((*vec_holder)[0])
+         {
+            construct_branch_pair(vector_node_, vec_node);
+            construct_branch_pair(index_      , index   );
+            assert(valid());
+         }
+
+         inline T value() const exprtk_override
+         {
+            return *access_vector();
+         }
+
+         inline T& ref() exprtk_override
+         {
+            return *access_vector();
+         }
+
+         inline const T& ref() const exprtk_override
+         {
+            return *access_vector();
+         }
+
+         inline typename expression_node<T>::node_type type() const exprtk_override
+         {
+            return expression_node<T>::e_vecelem;
+         }
+
+         inline bool valid() const exprtk_override
+         {
+            return
+               vector_holder_        &&
+               index_.first          &&
+               vector_node_.first    &&
+               index_.first->valid() &&
+               vector_node_.first->valid();
+         }
+
+         inline vector_holder_t& vec_holder()
+         {
+            return (*vector_holder_);
+         }
+
+         void collect_nodes(typename expression_node<T>::noderef_list_t& node_delete_list) exprtk_override
+         {
+            expression_node<T>::ndb_t::collect(vector_node_, node_delete_list);
+            expression_node<T>::ndb_t::collect(index_      , node_delete_list);
+         }
+
+         std::size_t node_depth() const exprtk_override
+         {
+            return expression_node<T>::ndb_t::compute_node_depth
+               (vector_node_, index_);
+         }
+
+      private:
+
+         inline T* access_vector() const
+         {
+            vector_node_.first->value();
+            return (vector_base_ + details::numeric::to_uint64(index_.first->value()));
+         }
+
+         vector_holder_ptr vector_holder_;
+         T* vector_base_;
+         branch_t vector_node_;
+         branch_t index_;
+      };
+
+      template <typename T>
+      class vector_celem_node exprtk_final
+                              : public expression_node<T>
+                              , public ivariable      <T>
+      {
+      public:
+
+         typedef expression_node<T>*            expression_ptr;
+         typedef vector_holder<T>               vector_holder_t;
+         typedef vector_holder_t*               vector_holder_ptr;
+         typedef std::pair<expression_ptr,bool> branch_t;
+
+         vector_celem_node(expression_ptr vec_node,
                            const std::size_t index,
                            vector_holder_ptr vec_holder)
          : index_(index)
@@ -9344,205 +11348,533 @@ namespace exprtk
          branch_t          vector_node_;
       };
 
-      template <typename T>
-      class rebasevector_elem_rtc_node exprtk_final
-                                       : public expression_node<T>
-                                       , public ivariable      <T>
+      template <typename T>
+      class rebasevector_elem_rtc_node exprtk_final
+                                       : public expression_node<T>
+                                       , public ivariable      <T>
+      {
+      public:
+
+         typedef expression_node<T>*            expression_ptr;
+         typedef vector_holder<T>               vector_holder_t;
+         typedef vector_holder_t*               vector_holder_ptr;
+         typedef std::pair<expression_ptr,bool> branch_t;
+
+         rebasevector_elem_rtc_node(expression_ptr vec_node,
+                                    expression_ptr index,
+                                    vector_holder_ptr vec_holder,
+                                    vector_access_runtime_check_ptr vec_rt_chk)
+         : vector_holder_(vec_holder)
+         , vec_rt_chk_(vec_rt_chk)
+         {
+            construct_branch_pair(vector_node_, vec_node);
+            construct_branch_pair(index_      , index   );
+            assert(valid());
+         }
+
+         inline T value() const exprtk_override
+         {
+            return *access_vector();
+         }
+
+         inline T& ref() exprtk_override
+         {
+            return *access_vector();
+         }
+
+         inline const T& ref() const exprtk_override
+         {
+            return *access_vector();
+         }
+
+         inline typename expression_node<T>::node_type type() const exprtk_override
+         {
+            return expression_node<T>::e_rbvecelemrtc;
+         }
+
+         inline bool valid() const exprtk_override
+         {
+            return
+               vector_holder_        &&
+               index_.first          &&
+               vector_node_.first    &&
+               index_.first->valid() &&
+               vector_node_.first->valid();
+         }
+
+         inline vector_holder_t& vec_holder()
+         {
+            return (*vector_holder_);
+         }
+
+         void collect_nodes(typename expression_node<T>::noderef_list_t& node_delete_list) exprtk_override
+         {
+            expression_node<T>::ndb_t::collect(vector_node_, node_delete_list);
+            expression_node<T>::ndb_t::collect(index_      , node_delete_list);
+         }
+
+         std::size_t node_depth() const exprtk_override
+         {
+            return expression_node<T>::ndb_t::compute_node_depth
+               (vector_node_, index_);
+         }
+
+      private:
+
+         inline T* access_vector() const
+         {
+            vector_node_.first->value();
+            const _uint64_t index = details::numeric::to_uint64(index_.first->value());
+
+            if (index <= (vector_holder_->size() - 1))
+            {
+               return (vector_holder_->data() + index);
+            }
+
+            assert(vec_rt_chk_);
+
+            vector_access_runtime_check::violation_context context;
+            context.base_ptr   = reinterpret_cast<void*>(vector_holder_->data());
+            context.end_ptr    = reinterpret_cast<void*>(vector_holder_->data() + vector_holder_->size());
+            context.access_ptr = reinterpret_cast<void*>(vector_holder_->data() + index);
+            context.type_size  = sizeof(T);
+
+            return vec_rt_chk_->handle_runtime_violation(context) ?
+                   reinterpret_cast<T*>(context.access_ptr) :
+                   vector_holder_->data() ;
+         }
+
+         vector_holder_ptr vector_holder_;
+         branch_t          vector_node_;
+         branch_t          index_;
+         vector_access_runtime_check_ptr vec_rt_chk_;
+      };
+
+      template <typename T>
+      class rebasevector_celem_rtc_node exprtk_final
+                                    : public expression_node<T>
+                                    , public ivariable      <T>
+      {
+      public:
+
+         typedef expression_node<T>*            expression_ptr;
+         typedef vector_holder<T>               vector_holder_t;
+         typedef vector_holder_t*               vector_holder_ptr;
+         typedef std::pair<expression_ptr,bool> branch_t;
+
+         rebasevector_celem_rtc_node(expression_ptr vec_node,
+                                     const std::size_t index,
+                                     vector_holder_ptr vec_holder,
+                                     vector_access_runtime_check_ptr vec_rt_chk)
+         : index_(index)
+         , vector_holder_(vec_holder)
+         , vector_base_((*vec_holder)[0])
+         , vec_rt_chk_(vec_rt_chk)
+         {
+            construct_branch_pair(vector_node_, vec_node);
+            assert(valid());
+         }
+
+         inline T value() const exprtk_override
+         {
+            return *access_vector();
+         }
+
+         inline T& ref() exprtk_override
+         {
+            return *access_vector();
+         }
+
+         inline const T& ref() const exprtk_override
+         {
+            return *access_vector();
+         }
+
+         inline typename expression_node<T>::node_type type() const exprtk_override
+         {
+            return expression_node<T>::e_rbveccelemrtc;
+         }
+
+         inline bool valid() const exprtk_override
+         {
+            return
+               vector_holder_     &&
+               vector_node_.first &&
+               vector_node_.first->valid();
+         }
+
+         inline vector_holder_t& vec_holder()
+         {
+            return (*vector_holder_);
+         }
+
+         void collect_nodes(typename expression_node<T>::noderef_list_t& node_delete_list) exprtk_override
+         {
+            expression_node<T>::ndb_t::collect(vector_node_, node_delete_list);
+         }
+
+         std::size_t node_depth() const exprtk_override
+         {
+            return expression_node<T>::ndb_t::compute_node_depth(vector_node_);
+         }
+
+      private:
+
+         inline T* access_vector() const
+         {
+            vector_node_.first->value();
+
+            if (index_ <= vector_holder_->size() - 1)
+            {
+               return (vector_holder_->data() + index_);
+            }
+
+            assert(vec_rt_chk_);
+
+            vector_access_runtime_check::violation_context context;
+            context.base_ptr   = reinterpret_cast<void*>(vector_base_);
+            context.end_ptr    = reinterpret_cast<void*>(vector_base_ + vector_holder_->size());
+            context.access_ptr = reinterpret_cast<void*>(vector_base_ + index_);
+            context.type_size  = sizeof(T);
+
+            return vec_rt_chk_->handle_runtime_violation(context) ?
+               reinterpret_cast<T*>(context.access_ptr) :
+               vector_base_ ;
+         }
+
+         const std::size_t index_;
+         vector_holder_ptr vector_holder_;
+         T*                vector_base_;
+         branch_t          vector_node_;
+         vector_access_runtime_check_ptr vec_rt_chk_;
+      };
+
+      /*
+         Bit-packed storage backing boolean local vectors, that
+         is vectors defined as: var v[n] : bool
+      */
+      class bitvector_store
       {
       public:
 
-         typedef expression_node<T>*            expression_ptr;
-         typedef vector_holder<T>               vector_holder_t;
-         typedef vector_holder_t*               vector_holder_ptr;
-         typedef std::pair<expression_ptr,bool> branch_t;
+         typedef _uint64_t word_t;
 
-         rebasevector_elem_rtc_node(expression_ptr vec_node,
-                                    expression_ptr index,
-                                    vector_holder_ptr vec_holder,
-                                    vector_access_runtime_check_ptr vec_rt_chk)
-         : vector_holder_(vec_holder)
-         , vec_rt_chk_(vec_rt_chk)
+         static const std::size_t bits_per_word = 64;
+
+         explicit bitvector_store(const std::size_t& size)
+         : size_(size)
+         , words_((size + bits_per_word - 1) / bits_per_word, word_t(0))
+         {}
+
+         inline std::size_t size() const
          {
-            construct_branch_pair(vector_node_, vec_node);
-            construct_branch_pair(index_      , index   );
-            assert(valid());
+            return size_;
          }
 
-         inline T value() const exprtk_override
+         inline std::size_t size_in_bytes() const
          {
-            return *access_vector();
+            return words_.size() * sizeof(word_t);
          }
 
-         inline T& ref() exprtk_override
+         inline bool get(const std::size_t& index) const
          {
-            return *access_vector();
+            return 0 != (words_[index / bits_per_word] & (word_t(1) << (index % bits_per_word)));
          }
 
-         inline const T& ref() const exprtk_override
+         inline void set(const std::size_t& index, const bool state)
          {
-            return *access_vector();
+            const word_t mask = word_t(1) << (index % bits_per_word);
+
+            if (state)
+               words_[index / bits_per_word] |=  mask;
+            else
+               words_[index / bits_per_word] &= ~mask;
+         }
+
+         inline void fill(const bool state)
+         {
+            std::fill(words_.begin(), words_.end(), state ? ~word_t(0) : word_t(0));
+
+            const std::size_t tail_bits = size_ % bits_per_word;
+
+            if (state && tail_bits)
+            {
+               words_.back() &= (word_t(1) << tail_bits) - 1;
+            }
+         }
+
+         inline std::size_t count() const
+         {
+            std::size_t result = 0;
+
+            for (std::size_t i = 0; i < words_.size(); ++i)
+            {
+               result += popcount(words_[i]);
+            }
+
+            return result;
+         }
+
+      private:
+
+         static inline std::size_t popcount(word_t w)
+         {
+            #if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_popcountll(w));
+            #else
+            w = w - ((w >> 1) & word_t(0x5555555555555555ULL));
+            w = (w & word_t(0x3333333333333333ULL)) + ((w >> 2) & word_t(0x3333333333333333ULL));
+            w = (w + (w >> 4)) & word_t(0x0F0F0F0F0F0F0F0FULL);
+            return static_cast<std::size_t>((w * word_t(0x0101010101010101ULL)) >> 56);
+            #endif
+         }
+
+         std::size_t size_;
+         std::vector<word_t> words_;
+      };
+
+      template <typename T>
+      class bitvector_node exprtk_final : public expression_node<T>
+      {
+      public:
+
+         explicit bitvector_node(bitvector_store* store)
+         : store_(store)
+         {}
+
+         inline T value() const exprtk_override
+         {
+            return store_->get(0) ? T(1) : T(0);
          }
 
          inline typename expression_node<T>::node_type type() const exprtk_override
          {
-            return expression_node<T>::e_rbvecelemrtc;
+            return expression_node<T>::e_bitvector;
          }
 
          inline bool valid() const exprtk_override
          {
-            return
-               vector_holder_        &&
-               index_.first          &&
-               vector_node_.first    &&
-               index_.first->valid() &&
-               vector_node_.first->valid();
+            return store_ && store_->size();
          }
 
-         inline vector_holder_t& vec_holder()
+         inline bitvector_store* store() const
          {
-            return (*vector_holder_);
+            return store_;
          }
 
-         void collect_nodes(typename expression_node<T>::noderef_list_t& node_delete_list) exprtk_override
+      private:
+
+         bitvector_store* store_;
+      };
+
+      template <typename T>
+      class bitvector_elem_node exprtk_final : public expression_node<T>
+      {
+      public:
+
+         typedef expression_node<T>*            expression_ptr;
+         typedef std::pair<expression_ptr,bool> branch_t;
+
+         bitvector_elem_node(bitvector_store* store, expression_ptr index)
+         : store_(store)
          {
-            expression_node<T>::ndb_t::collect(vector_node_, node_delete_list);
-            expression_node<T>::ndb_t::collect(index_      , node_delete_list);
+            construct_branch_pair(index_, index);
+            assert(valid());
          }
 
-         std::size_t node_depth() const exprtk_override
+         inline T value() const exprtk_override
          {
-            return expression_node<T>::ndb_t::compute_node_depth
-               (vector_node_, index_);
+            const std::size_t i = index();
+
+            if (i >= store_->size())
+               return std::numeric_limits<T>::quiet_NaN();
+
+            return store_->get(i) ? T(1) : T(0);
          }
 
-      private:
+         inline T assign(const T& v) const
+         {
+            const std::size_t i = index();
 
-         inline T* access_vector() const
+            if (i >= store_->size())
+               return std::numeric_limits<T>::quiet_NaN();
+
+            const bool state = std::not_equal_to<T>()(T(0), v);
+
+            store_->set(i, state);
+
+            return state ? T(1) : T(0);
+         }
+
+         inline typename expression_node<T>::node_type type() const exprtk_override
          {
-            vector_node_.first->value();
-            const _uint64_t index = details::numeric::to_uint64(index_.first->value());
+            return expression_node<T>::e_bitvecelem;
+         }
 
-            if (index <= (vector_holder_->size() - 1))
-            {
-               return (vector_holder_->data() + index);
-            }
+         inline bool valid() const exprtk_override
+         {
+            return store_ && index_.first && index_.first->valid();
+         }
 
-            assert(vec_rt_chk_);
+         void collect_nodes(typename expression_node<T>::noderef_list_t& node_delete_list) exprtk_override
+         {
+            expression_node<T>::ndb_t::collect(index_, node_delete_list);
+         }
 
-            vector_access_runtime_check::violation_context context;
-            context.base_ptr   = reinterpret_cast<void*>(vector_holder_->data());
-            context.end_ptr    = reinterpret_cast<void*>(vector_holder_->data() + vector_holder_->size());
-            context.access_ptr = reinterpret_cast<void*>(vector_holder_->data() + index);
-            context.type_size  = sizeof(T);
+         std::size_t node_depth() const exprtk_override
+         {
+            return expression_node<T>::ndb_t::compute_node_depth(index_);
+         }
 
-            return vec_rt_chk_->handle_runtime_violation(context) ?
-                   reinterpret_cast<T*>(context.access_ptr) :
-                   vector_holder_->data() ;
+      private:
+
+         inline std::size_t index() const
+         {
+            return static_cast<std::size_t>(details::numeric::to_uint64(index_.first->value()));
          }
 
-         vector_holder_ptr vector_holder_;
-         branch_t          vector_node_;
-         branch_t          index_;
-         vector_access_runtime_check_ptr vec_rt_chk_;
+         bitvector_store* store_;
+         branch_t index_;
       };
 
       template <typename T>
-      class rebasevector_celem_rtc_node exprtk_final
-                                    : public expression_node<T>
-                                    , public ivariable      <T>
+      class bitvector_init_node exprtk_final : public expression_node<T>
       {
       public:
 
          typedef expression_node<T>*            expression_ptr;
-         typedef vector_holder<T>               vector_holder_t;
-         typedef vector_holder_t*               vector_holder_ptr;
          typedef std::pair<expression_ptr,bool> branch_t;
 
-         rebasevector_celem_rtc_node(expression_ptr vec_node,
-                                     const std::size_t index,
-                                     vector_holder_ptr vec_holder,
-                                     vector_access_runtime_check_ptr vec_rt_chk)
-         : index_(index)
-         , vector_holder_(vec_holder)
-         , vector_base_((*vec_holder)[0])
-         , vec_rt_chk_(vec_rt_chk)
+         bitvector_init_node(bitvector_store* store, expression_ptr initialiser)
+         : store_(store)
          {
-            construct_branch_pair(vector_node_, vec_node);
-            assert(valid());
+            construct_branch_pair(initialiser_, initialiser);
          }
 
          inline T value() const exprtk_override
          {
-            return *access_vector();
+            const bool state = initialiser_.first && is_true(initialiser_);
+            store_->fill(state);
+            return state ? T(1) : T(0);
          }
 
-         inline T& ref() exprtk_override
+         inline typename expression_node<T>::node_type type() const exprtk_override
          {
-            return *access_vector();
+            return expression_node<T>::e_bitvecinit;
          }
 
-         inline const T& ref() const exprtk_override
+         inline bool valid() const exprtk_override
          {
-            return *access_vector();
+            return store_ && (0 == initialiser_.first || initialiser_.first->valid());
          }
 
-         inline typename expression_node<T>::node_type type() const exprtk_override
+         void collect_nodes(typename expression_node<T>::noderef_list_t& node_delete_list) exprtk_override
          {
-            return expression_node<T>::e_rbveccelemrtc;
+            expression_node<T>::ndb_t::collect(initialiser_, node_delete_list);
          }
 
-         inline bool valid() const exprtk_override
+         std::size_t node_depth() const exprtk_override
          {
-            return
-               vector_holder_     &&
-               vector_node_.first &&
-               vector_node_.first->valid();
+            return expression_node<T>::ndb_t::compute_node_depth(initialiser_);
          }
 
-         inline vector_holder_t& vec_holder()
+      private:
+
+         bitvector_store* store_;
+         branch_t initialiser_;
+      };
+
+      template <typename T>
+      class bitvector_count_node exprtk_final : public expression_node<T>
+      {
+      public:
+
+         typedef expression_node<T>*            expression_ptr;
+         typedef std::pair<expression_ptr,bool> branch_t;
+
+         bitvector_count_node(const operator_type& operation, expression_ptr bitvec_node)
+         : operation_(operation)
+         , store_(static_cast<bitvector_node<T>*>(bitvec_node)->store())
          {
-            return (*vector_holder_);
+            construct_branch_pair(bitvec_node_, bitvec_node);
+         }
+
+         inline T value() const exprtk_override
+         {
+            const std::size_t count = store_->count();
+
+            switch (operation_)
+            {
+               case e_sum : return T(count);
+               case e_avg : return T(count) / T(store_->size());
+               case e_min : return (count == store_->size()) ? T(1) : T(0);
+               case e_max : return (count > 0) ? T(1) : T(0);
+               default    : return std::numeric_limits<T>::quiet_NaN();
+            }
+         }
+
+         inline typename expression_node<T>::node_type type() const exprtk_override
+         {
+            return expression_node<T>::e_bitvecfunc;
+         }
+
+         inline bool valid() const exprtk_override
+         {
+            return store_ && bitvec_node_.first;
          }
 
          void collect_nodes(typename expression_node<T>::noderef_list_t& node_delete_list) exprtk_override
          {
-            expression_node<T>::ndb_t::collect(vector_node_, node_delete_list);
+            expression_node<T>::ndb_t::collect(bitvec_node_, node_delete_list);
          }
 
          std::size_t node_depth() const exprtk_override
          {
-            return expression_node<T>::ndb_t::compute_node_depth(vector_node_);
+            return expression_node<T>::ndb_t::compute_node_depth(bitvec_node_);
          }
 
       private:
 
-         inline T* access_vector() const
-         {
-            vector_node_.first->value();
+         operator_type operation_;
+         bitvector_store* store_;
+         branch_t bitvec_node_;
+      };
 
-            if (index_ <= vector_holder_->size() - 1)
+      template <typename T>
+      class assignment_bitvec_elem_node exprtk_final : public binary_node<T>
+      {
+      public:
+
+         typedef expression_node<T>* expression_ptr;
+         using binary_node<T>::branch;
+
+         assignment_bitvec_elem_node(const operator_type& opr,
+                                     expression_ptr branch0,
+                                     expression_ptr branch1)
+         : binary_node<T>(opr, branch0, branch1)
+         , bitvec_elem_node_ptr_(0)
+         {
+            if (is_bitvector_elem_node(branch(0)))
             {
-               return (vector_holder_->data() + index_);
+               bitvec_elem_node_ptr_ = static_cast<bitvector_elem_node<T>*>(branch(0));
             }
 
-            assert(vec_rt_chk_);
+            assert(valid());
+         }
 
-            vector_access_runtime_check::violation_context context;
-            context.base_ptr   = reinterpret_cast<void*>(vector_base_);
-            context.end_ptr    = reinterpret_cast<void*>(vector_base_ + vector_holder_->size());
-            context.access_ptr = reinterpret_cast<void*>(vector_base_ + index_);
-            context.type_size  = sizeof(T);
+         inline T value() const exprtk_override
+         {
+            return bitvec_elem_node_ptr_->assign(branch(1)->value());
+         }
 
-            return vec_rt_chk_->handle_runtime_violation(context) ?
-               reinterpret_cast<T*>(context.access_ptr) :
-               vector_base_ ;
+         inline bool valid() const exprtk_override
+         {
+            return bitvec_elem_node_ptr_ && binary_node<T>::valid();
          }
 
-         const std::size_t index_;
-         vector_holder_ptr vector_holder_;
-         T*                vector_base_;
-         branch_t          vector_node_;
-         vector_access_runtime_check_ptr vec_rt_chk_;
+      private:
+
+         bitvector_elem_node<T>* bitvec_elem_node_ptr_;
       };
 
       template <typename T>
@@ -10334,6 +12666,19 @@ namespace exprtk
             return ref().size();
          }
 
+         std::size_t capacity_hint() const exprtk_override
+         {
+            return ref().capacity();
+         }
+
+         inline void reserve(const std::size_t n)
+         {
+            if (&null_value != value_)
+            {
+               value_->reserve(n);
+            }
+         }
+
          std::string& ref()
          {
             return (*value_);
@@ -10577,6 +12922,12 @@ namespace exprtk
             }
 
             initialised_ = (str_base_ptr_ && str_range_ptr_);
+
+            if (initialised_)
+            {
+               value_.reserve(str_base_ptr_->capacity_hint());
+            }
+
             assert(valid());
          }
 
@@ -10630,6 +12981,11 @@ namespace exprtk
             return value_.size();
          }
 
+         std::size_t capacity_hint() const exprtk_override
+         {
+            return value_.capacity();
+         }
+
          range_t& range_ref() exprtk_override
          {
             return range_;
@@ -10735,6 +13091,12 @@ namespace exprtk
                            str0_range_ptr_ &&
                            str1_range_ptr_ ;
 
+            if (initialised_)
+            {
+               value_.reserve(str0_base_ptr_->capacity_hint() +
+                              str1_base_ptr_->capacity_hint());
+            }
+
             assert(valid());
          }
 
@@ -10785,6 +13147,11 @@ namespace exprtk
             return value_.size();
          }
 
+         std::size_t capacity_hint() const exprtk_override
+         {
+            return value_.capacity();
+         }
+
          range_t& range_ref() exprtk_override
          {
             return range_;
@@ -11157,12 +13524,18 @@ namespace exprtk
       {
          static inline void execute(std::string& s, char_cptr data, const std::size_t size)
          { s.assign(data,size); }
+
+         static inline std::size_t capacity(const std::size_t s_size, const std::size_t size)
+         { return std::max(s_size,size); }
       };
 
       struct asn_addassignment
       {
          static inline void execute(std::string& s, char_cptr data, const std::size_t size)
          { s.append(data,size); }
+
+         static inline std::size_t capacity(const std::size_t s_size, const std::size_t size)
+         { return s_size + size; }
       };
 
       template <typename T, typename AssignmentProcess = asn_assignment>
@@ -11219,6 +13592,12 @@ namespace exprtk
                            str0_node_ptr_  &&
                            str1_range_ptr_ ;
 
+            if (initialised_)
+            {
+               str0_node_ptr_->reserve(AssignmentProcess::capacity(
+                  str0_node_ptr_->size(), str1_base_ptr_->capacity_hint()));
+            }
+
             assert(valid());
          }
 
@@ -11258,6 +13637,11 @@ namespace exprtk
             return str0_node_ptr_->size();
          }
 
+         std::size_t capacity_hint() const exprtk_override
+         {
+            return str0_node_ptr_->capacity_hint();
+         }
+
          range_t& range_ref() exprtk_override
          {
             return str0_node_ptr_->range_ref();
@@ -11493,6 +13877,12 @@ namespace exprtk
                            str0_range_ptr_ &&
                            str1_range_ptr_ ;
 
+            if (initialised_)
+            {
+               value_.reserve(std::max(str0_base_ptr_->capacity_hint(),
+                                       str1_base_ptr_->capacity_hint()));
+            }
+
             assert(valid());
          }
 
@@ -11556,6 +13946,11 @@ namespace exprtk
             return value_.size();
          }
 
+         std::size_t capacity_hint() const exprtk_override
+         {
+            return value_.capacity();
+         }
+
          range_t& range_ref() exprtk_override
          {
             return range_;
@@ -11641,6 +14036,12 @@ namespace exprtk
             }
 
             initialised_ = str0_base_ptr_ && str0_range_ptr_ ;
+
+            if (initialised_)
+            {
+               value_.reserve(str0_base_ptr_->capacity_hint());
+            }
+
             assert(valid());
          }
 
@@ -11686,6 +14087,11 @@ namespace exprtk
             return value_.size();
          }
 
+         std::size_t capacity_hint() const
+         {
+            return value_.capacity();
+         }
+
          range_t& range_ref()
          {
             return range_;
@@ -14230,6 +16636,19 @@ namespace exprtk
          memory_context    memory_context_;
       };
 
+      /*
+         Vector forms of unary operators evaluate element by element,
+         other than those with a batch kernel.
+      */
+      template <typename T, typename Operation>
+      struct unary_vector_batch
+      {
+         static const bool enabled = false;
+
+         static inline void process(const T*, T*, const std::size_t)
+         {}
+      };
+
       template <typename T, typename Operation>
       class unary_vector_node exprtk_final
                               : public unary_node      <T>
@@ -14292,6 +16711,13 @@ namespace exprtk
             const T* vec0 = vec0_node_ptr_->vds().data();
                   T* vec1 = vds().data();
 
+            if (unary_vector_batch<T,Operation>::enabled)
+            {
+               unary_vector_batch<T,Operation>::process(vec0, vec1, size());
+
+               return (vds().data())[0];
+            }
+
             loop_unroll::details lud(size());
             const T* upper_bound = vec0 + lud.upper_bound;
 
@@ -15517,7 +17943,9 @@ namespace exprtk
                      results_context_t& rc)
          : gen_function_t  (arg_list)
          , results_context_(&rc)
+         , tail_           (false)
          {
+            results_context_->reserve(arg_list.size());
             assert(valid());
          }
 
@@ -15532,12 +17960,24 @@ namespace exprtk
                results_context_->
                   assign(parameter_list_t(gen_function_t::typestore_list_));
 
-               throw return_exception();
+               /*
+                  A return in tail position has nothing left to unwind,
+                  and so avoids the heap allocation of the exception.
+               */
+               if (!tail_)
+               {
+                  throw return_exception();
+               }
             }
 
             return std::numeric_limits<T>::quiet_NaN();
          }
 
+         inline void set_tail()
+         {
+            tail_ = true;
+         }
+
          inline typename expression_node<T>::node_type type() const exprtk_override
          {
             return expression_node<T>::e_return;
@@ -15564,6 +18004,7 @@ namespace exprtk
          }
 
          results_context_t* results_context_;
+         bool tail_;
       };
 
       template <typename T>
@@ -15590,7 +18031,16 @@ namespace exprtk
                return_invoked_ = false;
                results_context_->clear();
 
-               return body_.first->value();
+               const T result = body_.first->value();
+
+               // A return in tail position completes without throwing
+               if (results_context_->results_available_)
+               {
+                  return_invoked_ = true;
+                  return std::numeric_limits<T>::quiet_NaN();
+               }
+
+               return result;
             }
             catch(const return_exception&)
             {
@@ -15698,6 +18148,48 @@ namespace exprtk
       exprtk_define_unary_op(trunc)
       #undef exprtk_define_unary_op
 
+      #define exprtk_define_approx_unary_op(OpName)             \
+      template <typename T>                                     \
+      struct approx_##OpName##_op : public OpName##_op<T>       \
+      {                                                         \
+         typedef typename functor_t<T>::Type Type;              \
+                                                                \
+         static inline T process(Type v)                        \
+         {                                                      \
+            return numeric::approx:: OpName (v);                \
+         }                                                      \
+      };                                                        \
+
+      exprtk_define_approx_unary_op(cos )
+      exprtk_define_approx_unary_op(erf )
+      exprtk_define_approx_unary_op(erfc)
+      exprtk_define_approx_unary_op(exp )
+      exprtk_define_approx_unary_op(log )
+      exprtk_define_approx_unary_op(ncdf)
+      exprtk_define_approx_unary_op(sin )
+      #undef exprtk_define_approx_unary_op
+
+      #define exprtk_define_approx_unary_batch(OpName)              \
+      template <typename T>                                         \
+      struct unary_vector_batch<T, approx_##OpName##_op<T> >        \
+      {                                                             \
+         static const bool enabled = true;                          \
+                                                                    \
+         static inline void process(const T* v, T* r, const std::size_t n) \
+         {                                                          \
+            numeric::approx:: OpName (v, r, n);                     \
+         }                                                          \
+      };                                                            \
+
+      exprtk_define_approx_unary_batch(cos )
+      exprtk_define_approx_unary_batch(erf )
+      exprtk_define_approx_unary_batch(erfc)
+      exprtk_define_approx_unary_batch(exp )
+      exprtk_define_approx_unary_batch(log )
+      exprtk_define_approx_unary_batch(ncdf)
+      exprtk_define_approx_unary_batch(sin )
+      #undef exprtk_define_approx_unary_batch
+
       template <typename T>
       struct opr_base
       {
@@ -18539,6 +21031,16 @@ namespace exprtk
             return s1_;
          }
 
+         inline const std::string& s0() const
+         {
+            return s0_;
+         }
+
+         inline const std::string& s1() const
+         {
+            return s1_;
+         }
+
       protected:
 
          SType0 s0_;
@@ -18550,6 +21052,44 @@ namespace exprtk
          sos_node<T,SType0,SType1,Operation>& operator=(const sos_node<T,SType0,SType1,Operation>&) exprtk_delete;
       };
 
+      template <typename T, typename Operation>
+      class sos_match_node exprtk_final : public sos_base_node<T>
+      {
+      public:
+
+         typedef Operation operation_t;
+
+         // string op constant-pattern node, the pattern being
+         // compiled into a wildcard_matcher at parse time
+         sos_match_node(std::string& s, const wildcard_matcher& matcher)
+         : s_(s)
+         , matcher_(matcher)
+         {}
+
+         inline T value() const exprtk_override
+         {
+            return matcher_.match(s_.data(), s_.size()) ? T(1) : T(0);
+         }
+
+         inline typename expression_node<T>::node_type type() const exprtk_override
+         {
+            return Operation::type();
+         }
+
+         inline operator_type operation() const exprtk_override
+         {
+            return Operation::operation();
+         }
+
+      private:
+
+         sos_match_node(const sos_match_node<T,Operation>&) exprtk_delete;
+         sos_match_node<T,Operation>& operator=(const sos_match_node<T,Operation>&) exprtk_delete;
+
+         std::string&     s_;
+         wildcard_matcher matcher_;
+      };
+
       template <typename T, typename SType0, typename SType1, typename RangePack, typename Operation>
       class str_xrox_node exprtk_final : public sos_base_node<T>
       {
@@ -18564,7 +21104,9 @@ namespace exprtk
          : s0_ (p0 )
          , s1_ (p1 )
          , rp0_(rp0)
-         {}
+         {
+            substr0_.reserve(s0_.size());
+         }
 
         ~str_xrox_node() exprtk_override
          {
@@ -18577,7 +21119,10 @@ namespace exprtk
             std::size_t r1 = 0;
 
             if (rp0_(r0, r1, s0_))
-               return Operation::process(s0_.substr(r0, (r1 - r0)), s1_);
+            {
+               substr0_.assign(s0_.data() + r0, (r1 - r0));
+               return Operation::process(substr0_, s1_);
+            }
             else
                return T(0);
          }
@@ -18608,6 +21153,9 @@ namespace exprtk
          SType1    s1_;
          RangePack rp0_;
 
+         // Holds the range across evaluations, so ranged comparisons do not allocate
+         mutable std::string substr0_;
+
       private:
 
          str_xrox_node(const node_type&) exprtk_delete;
@@ -18628,7 +21176,9 @@ namespace exprtk
          : s0_ (p0 )
          , s1_ (p1 )
          , rp1_(rp1)
-         {}
+         {
+            substr1_.reserve(s1_.size());
+         }
 
         ~str_xoxr_node()
          {
@@ -18642,11 +21192,8 @@ namespace exprtk
 
             if (rp1_(r0, r1, s1_))
             {
-               return Operation::process
-                      (
-                         s0_,
-                         s1_.substr(r0, (r1 - r0))
-                      );
+               substr1_.assign(s1_.data() + r0, (r1 - r0));
+               return Operation::process(s0_, substr1_);
             }
             else
                return T(0);
@@ -18678,6 +21225,8 @@ namespace exprtk
          SType1    s1_;
          RangePack rp1_;
 
+         mutable std::string substr1_;
+
       private:
 
          str_xoxr_node(const node_type&) exprtk_delete;
@@ -18699,7 +21248,10 @@ namespace exprtk
          , s1_ (p1 )
          , rp0_(rp0)
          , rp1_(rp1)
-         {}
+         {
+            substr0_.reserve(s0_.size());
+            substr1_.reserve(s1_.size());
+         }
 
         ~str_xroxr_node() exprtk_override
          {
@@ -18719,11 +21271,10 @@ namespace exprtk
                  rp1_(r0_1, r1_1, s1_)
                )
             {
-               return Operation::process
-                      (
-                         s0_.substr(r0_0, (r1_0 - r0_0)),
-                         s1_.substr(r0_1, (r1_1 - r0_1))
-                      );
+               substr0_.assign(s0_.data() + r0_0, (r1_0 - r0_0));
+               substr1_.assign(s1_.data() + r0_1, (r1_1 - r0_1));
+
+               return Operation::process(substr0_, substr1_);
             }
             else
                return T(0);
@@ -18756,6 +21307,9 @@ namespace exprtk
          RangePack rp0_;
          RangePack rp1_;
 
+         mutable std::string substr0_;
+         mutable std::string substr1_;
+
       private:
 
          str_xroxr_node(const node_type&) exprtk_delete;
@@ -18822,6 +21376,12 @@ namespace exprtk
                str0_range_ptr_ &&
                str1_range_ptr_;
 
+            if (initialised_)
+            {
+               substr0_.reserve(str0_base_ptr_->capacity_hint());
+               substr1_.reserve(str1_base_ptr_->capacity_hint());
+            }
+
             assert(valid());
          }
 
@@ -18844,11 +21404,10 @@ namespace exprtk
                  range1(str1_r0, str1_r1, *str1_base_ptr_)
                )
             {
-               return Operation::process
-                      (
-                         str0_base_ptr_->str().substr(str0_r0,(str0_r1 - str0_r0)),
-                         str1_base_ptr_->str().substr(str1_r0,(str1_r1 - str1_r0))
-                      );
+               substr0_.assign(str0_base_ptr_->base() + str0_r0, (str0_r1 - str0_r0));
+               substr1_.assign(str1_base_ptr_->base() + str1_r0, (str1_r1 - str1_r0));
+
+               return Operation::process(substr0_, substr1_);
             }
 
             return std::numeric_limits<T>::quiet_NaN();
@@ -18874,6 +21433,9 @@ namespace exprtk
          range_ptr    str0_range_ptr_;
          range_ptr    str1_range_ptr_;
          bool         initialised_;
+
+         mutable std::string substr0_;
+         mutable std::string substr1_;
       };
 
       template <typename T, typename SType0, typename SType1, typename SType2, typename Operation>
@@ -21790,7 +24352,8 @@ namespace exprtk
             e_vecholder,
             e_data     ,
             e_vecdata  ,
-            e_string
+            e_string   ,
+            e_bitvecdata
          };
 
          static std::string to_str(data_type dt)
@@ -21803,6 +24366,7 @@ namespace exprtk
                case e_data      : return "e_data"     ;
                case e_vecdata   : return "e_vecdata"  ;
                case e_string    : return "e_string"   ;
+               case e_bitvecdata: return "e_bitvecdata";
             }
 
             return "";
@@ -21869,12 +24433,15 @@ namespace exprtk
                      case e_data      : delete reinterpret_cast<T*>(local_data_list[i].pointer);
                                         break;
 
-                     case e_vecdata   : delete [] reinterpret_cast<T*>(local_data_list[i].pointer);
+                     case e_vecdata   : details::vector_storage<T>::destroy(reinterpret_cast<T*>(local_data_list[i].pointer));
                                         break;
 
                      case e_string    : delete reinterpret_cast<std::string*>(local_data_list[i].pointer);
                                         break;
 
+                     case e_bitvecdata: delete reinterpret_cast<details::bitvector_store*>(local_data_list[i].pointer);
+                                        break;
+
                      default          : break;
                   }
                }
@@ -21913,6 +24480,7 @@ namespace exprtk
          results_context_t* results;
          bool  retinv_null;
          bool* return_invoked;
+         std::map<std::string,T*> parameters;
 
          friend class function_compositor<T>;
       };
@@ -22064,6 +24632,65 @@ namespace exprtk
                 (*control_block_->return_invoked);
       }
 
+      // Storage of the literal parameter $name, null if there is no such parameter
+      inline T* parameter(const std::string& name) const
+      {
+         if (0 == control_block_)
+            return reinterpret_cast<T*>(0);
+
+         std::string key = (!name.empty() && ('$' == name[0])) ? name.substr(1) : name;
+         details::case_normalise(key);
+
+         const typename std::map<std::string,T*>::const_iterator itr = control_block_->parameters.find(key);
+
+         return (control_block_->parameters.end() != itr) ? itr->second : reinterpret_cast<T*>(0);
+      }
+
+      inline bool set_parameter(const std::string& name, const T& value)
+      {
+         T* data = parameter(name);
+
+         if (0 == data)
+            return false;
+
+         (*data) = value;
+
+         return true;
+      }
+
+      // Number of nodes owned by the compiled tree, symbol table variables excluded
+      inline std::size_t node_count() const
+      {
+         typedef typename details::expression_node<T>::noderef_list_t noderef_list_t;
+
+         if ((0 == control_block_) || (0 == control_block_->expr))
+            return 0;
+
+         std::vector<expression_ptr> node_list(1, control_block_->expr);
+         noderef_list_t child_list;
+         std::size_t count = 0;
+
+         while (!node_list.empty())
+         {
+            expression_ptr node = node_list.back();
+            node_list.pop_back();
+            ++count;
+
+            child_list.clear();
+            node->collect_nodes(child_list);
+
+            for (std::size_t i = 0; i < child_list.size(); ++i)
+            {
+               if (*child_list[i])
+               {
+                  node_list.push_back(*child_list[i]);
+               }
+            }
+         }
+
+         return count;
+      }
+
    private:
 
       inline symtab_list_t get_symbol_table_list() const
@@ -22130,6 +24757,7 @@ namespace exprtk
                   case 0 : dt = control_block::e_data;    break;
                   case 1 : dt = control_block::e_vecdata; break;
                   case 2 : dt = control_block::e_string;  break;
+                  case 3 : dt = control_block::e_bitvecdata; break;
                }
 
                control_block_->
@@ -22161,6 +24789,14 @@ namespace exprtk
          }
       }
 
+      inline void register_parameter(const std::string& name, T* data)
+      {
+         if (control_block_ && data)
+         {
+            control_block_->parameters[name] = data;
+         }
+      }
+
       inline void set_retinvk(bool* retinvk_ptr)
       {
          if (control_block_)
@@ -22518,7 +25154,15 @@ namespace exprtk
       typedef details::rebasevector_elem_rtc_node<T>         rebasevector_elem_rtc_node_t;
       typedef details::rebasevector_celem_rtc_node<T>        rebasevector_celem_rtc_node_t;
       typedef details::vector_node<T>                        vector_node_t;
+      typedef details::bitvector_node<T>                     bitvector_node_t;
+      typedef details::bitvector_elem_node<T>                bitvector_elem_node_t;
+      typedef details::bitvector_init_node<T>                bitvector_init_node_t;
+      typedef details::bitvector_count_node<T>               bitvector_count_node_t;
+      typedef details::assignment_bitvec_elem_node<T>        assignment_bitvec_elem_node_t;
       typedef details::vector_size_node<T>                   vector_size_node_t;
+      typedef details::cse_scope_node<T>                     cse_scope_node_t;
+      typedef details::cse_reference_node<T>                 cse_reference_node_t;
+      typedef details::cse_barrier_node<T>                   cse_barrier_node_t;
       typedef details::range_pack<T>                         range_t;
       #ifndef exprtk_disable_string_capabilities
       typedef details::stringvar_node<T>                     stringvar_node_t;
@@ -22606,7 +25250,8 @@ namespace exprtk
             e_variable,
             e_vector  ,
             e_vecelem ,
-            e_string
+            e_string  ,
+            e_bitvector
          };
 
          typedef details::vector_holder<T> vector_holder_t;
@@ -22790,6 +25435,9 @@ namespace exprtk
                case scope_element::e_vector   : total_local_symb_size_bytes_ += sizeof(T) * se.size;
                                                 break;
 
+               case scope_element::e_bitvector: total_local_symb_size_bytes_ += (se.size + 7) / 8;
+                                                break;
+
                default                        : break;
             }
 
@@ -22833,13 +25481,16 @@ namespace exprtk
                                                   delete se.var_node;
                                                   break;
 
-               case scope_element::e_vector     : delete[] reinterpret_cast<T*>(se.data);
+               case scope_element::e_vector     : details::vector_storage<T>::destroy(reinterpret_cast<T*>(se.data));
                                                   delete se.vec_node;
                                                   break;
 
                case scope_element::e_vecelem    : delete se.var_node;
                                                   break;
 
+               case scope_element::e_bitvector  : delete reinterpret_cast<details::bitvector_store*>(se.data);
+                                                  break;
+
                #ifndef exprtk_disable_string_capabilities
                case scope_element::e_string     : delete reinterpret_cast<std::string*>(se.data);
                                                   delete se.str_node;
@@ -22930,6 +25581,80 @@ namespace exprtk
          std::size_t total_local_symb_size_bytes_;
       };
 
+      /*
+         State for common subexpression elimination. Subexpressions
+         are identified by the tokens that produced them: the first
+         parse records the token range of each pure subexpression
+         synthesised, the plan selects those occurring more than once,
+         and the second parse replaces each of their occurrences with
+         a reference to a single shared definition.
+
+         Loop invariant motion follows the same scheme: subexpressions
+         within a loop that read no variable assigned in that loop are
+         given a definition in a scope wrapping the loop, and so are
+         evaluated at most once per entry into the loop.
+      */
+      struct cse_context
+      {
+         typedef std::pair<std::size_t,std::size_t>            range_t;
+         typedef std::vector<range_t>                          range_list_t;
+         typedef std::map<std::string,range_list_t>            occurrence_map_t;
+         typedef std::map<std::string,std::vector<std::string> > symbol_map_t;
+         typedef std::map<std::string,std::size_t>             plan_t;
+         typedef std::pair<std::size_t,std::size_t>            slot_t;
+         typedef std::map<range_t,slot_t>                      invariant_plan_t;
+         typedef std::map<std::size_t,cse_scope_node_t*>       loop_scope_map_t;
+
+         struct invariant_t
+         {
+            range_t range;
+            std::string key;
+            std::vector<std::string> symbols;
+            bool local;
+         };
+
+         cse_context()
+         : recording(false)
+         , applying (false)
+         , scope    (0    )
+         {}
+
+         void reset()
+         {
+            recording = false;
+            applying  = false;
+            scope     = 0;
+            occurrences   .clear();
+            symbols       .clear();
+            plan          .clear();
+            invariants    .clear();
+            loops         .clear();
+            invariant_plan.clear();
+            loop_slots    .clear();
+            loop_scopes   .clear();
+         }
+
+         bool recording;
+         bool applying;
+         occurrence_map_t occurrences;
+         symbol_map_t symbols;
+         plan_t plan;
+         cse_scope_node_t* scope;
+         std::vector<invariant_t> invariants;
+         range_list_t loops;
+         invariant_plan_t invariant_plan;
+         std::map<std::size_t,std::size_t> loop_slots;
+         loop_scope_map_t loop_scopes;
+      };
+
+      struct literal_parameter_t
+      {
+         T*               data;
+         variable_node_t* node;
+      };
+
+      typedef std::map<std::string,literal_parameter_t> literal_parameter_map_t;
+
       class scope_handler
       {
       public:
@@ -23994,7 +26719,11 @@ namespace exprtk
             e_collect_funcs        =  512,
             e_collect_assings      = 1024,
             e_disable_usr_on_rsrvd = 2048,
-            e_disable_zero_return  = 4096
+            e_disable_zero_return  = 4096,
+            e_common_subexpr_elim  = 8192,
+            e_loop_invariant_motion = 16384,
+            e_literal_parameters   = 32768,
+            e_approximations       = 65536
          };
 
          enum settings_base_funcs
@@ -24130,6 +26859,30 @@ namespace exprtk
             return (*this);
          }
 
+         settings_store& enable_common_subexpr_elim()
+         {
+            enable_common_subexpr_elim_ = true;
+            return (*this);
+         }
+
+         settings_store& enable_loop_invariant_motion()
+         {
+            enable_loop_invariant_motion_ = true;
+            return (*this);
+         }
+
+         settings_store& enable_literal_parameters()
+         {
+            enable_literal_parameters_ = true;
+            return (*this);
+         }
+
+         settings_store& enable_approximations()
+         {
+            enable_approximations_ = true;
+            return (*this);
+         }
+
          settings_store& disable_all_base_functions()
          {
             std::copy(details::base_function_list,
@@ -24202,6 +26955,30 @@ namespace exprtk
             return (*this);
          }
 
+         settings_store& disable_common_subexpr_elim()
+         {
+            enable_common_subexpr_elim_ = false;
+            return (*this);
+         }
+
+         settings_store& disable_loop_invariant_motion()
+         {
+            enable_loop_invariant_motion_ = false;
+            return (*this);
+         }
+
+         settings_store& disable_literal_parameters()
+         {
+            enable_literal_parameters_ = false;
+            return (*this);
+         }
+
+         settings_store& disable_approximations()
+         {
+            enable_approximations_ = false;
+            return (*this);
+         }
+
          bool replacer_enabled           () const { return enable_replacer_;           }
          bool commutative_check_enabled  () const { return enable_commutative_check_;  }
          bool joiner_enabled             () const { return enable_joiner_;             }
@@ -24215,6 +26992,10 @@ namespace exprtk
          bool vardef_disabled            () const { return disable_vardef_;            }
          bool rsrvd_sym_usr_disabled     () const { return disable_rsrvd_sym_usr_;     }
          bool zero_return_disabled       () const { return disable_zero_return_;       }
+         bool common_subexpr_elim_enabled() const { return enable_common_subexpr_elim_;}
+         bool loop_invariant_motion_enabled() const { return enable_loop_invariant_motion_; }
+         bool literal_parameters_enabled () const { return enable_literal_parameters_;  }
+         bool approximations_enabled     () const { return enable_approximations_;      }
 
          bool function_enabled(const std::string& function_name) const
          {
@@ -24570,6 +27351,10 @@ namespace exprtk
             disable_vardef_            = (compile_options & e_disable_vardef      ) == e_disable_vardef;
             disable_rsrvd_sym_usr_     = (compile_options & e_disable_usr_on_rsrvd) == e_disable_usr_on_rsrvd;
             disable_zero_return_       = (compile_options & e_disable_zero_return ) == e_disable_zero_return;
+            enable_common_subexpr_elim_= (compile_options & e_common_subexpr_elim ) == e_common_subexpr_elim;
+            enable_loop_invariant_motion_ = (compile_options & e_loop_invariant_motion) == e_loop_invariant_motion;
+            enable_literal_parameters_ = (compile_options & e_literal_parameters  ) == e_literal_parameters;
+            enable_approximations_     = (compile_options & e_approximations      ) == e_approximations;
          }
 
          std::string assign_opr_to_string(details::operator_type opr) const
@@ -24644,6 +27429,10 @@ namespace exprtk
          bool disable_vardef_;
          bool disable_rsrvd_sym_usr_;
          bool disable_zero_return_;
+         bool enable_common_subexpr_elim_;
+         bool enable_loop_invariant_motion_;
+         bool enable_literal_parameters_;
+         bool enable_approximations_;
 
          disabled_entity_set_t disabled_func_set_ ;
          disabled_entity_set_t disabled_ctrl_set_ ;
@@ -24702,7 +27491,9 @@ namespace exprtk
       }
 
      ~parser()
-      {}
+      {
+         literal_parameter_cleanup();
+      }
 
       inline void init_precompilation()
       {
@@ -24781,6 +27572,7 @@ namespace exprtk
          sem_                 .cleanup();
 
          return_cleanup();
+         literal_parameter_cleanup();
 
          if (!valid_settings())
          {
@@ -24842,8 +27634,24 @@ namespace exprtk
 
          next_token();
 
+         cse_.reset();
+         cse_.recording = settings_.common_subexpr_elim_enabled() ||
+                          settings_.loop_invariant_motion_enabled();
+
          expression_node_ptr e = parse_corpus();
 
+         if (cse_.recording)
+         {
+            cse_.recording = false;
+
+            if ((0 != e) && (token_t::e_eof == current_token().type) && cse_build_plan())
+            {
+               e = parse_corpus_cse(e);
+            }
+
+            cse_.reset();
+         }
+
          if ((0 != e) && (token_t::e_eof == current_token().type))
          {
             bool* retinvk_ptr = 0;
@@ -24861,6 +27669,7 @@ namespace exprtk
 
             register_local_vars(expr);
             register_return_results(expr);
+            register_literal_parameters(expr);
 
             return !(!expr);
          }
@@ -24883,12 +27692,66 @@ namespace exprtk
             dec_.clear    ();
             sem_.cleanup  ();
             return_cleanup();
+            literal_parameter_cleanup();
             expr = expression_t();
 
             return false;
          }
       }
 
+      inline expression_node_ptr parse_corpus_cse(expression_node_ptr e)
+      {
+         // Discard the first parse, and re-parse with the plan applied
+         if (branch_deletable(e))
+         {
+            destroy_node(e);
+         }
+
+         state_               .reset();
+         brkcnt_list_         .clear();
+         synthesis_error_     .clear();
+         immutable_memory_map_.reset();
+         immutable_symtok_map_.clear();
+         current_state_stack_ .clear();
+         assert_ids_          .clear();
+         sem_                 .cleanup();
+         dec_                 .clear();
+
+         return_cleanup();
+
+         if (!cse_.plan.empty())
+         {
+            cse_.scope = static_cast<cse_scope_node_t*>(
+                            node_allocator_.allocate_c<cse_scope_node_t>(cse_.plan.size()));
+         }
+
+         cse_.applying = true;
+
+         lexer().begin();
+
+         next_token();
+
+         e = parse_corpus();
+
+         cse_scope_node_t* scope = cse_.scope;
+
+         cse_.reset();
+
+         if (0 == scope)
+            return e;
+         else if ((0 == e) || (token_t::e_eof != current_token().type))
+         {
+            expression_node_ptr scope_node = scope;
+            destroy_node(scope_node);
+
+            return e;
+         }
+
+         scope->set_body(e);
+
+         return scope;
+      }
+
       inline expression_t compile(const std::string& expression_string, symbol_table_t& symtab)
       {
          expression_t expression;
@@ -24936,106 +27799,88 @@ namespace exprtk
 
       inline bool run_assemblies()
       {
-         if (settings_.commutative_check_enabled())
-         {
-            helper_assembly_.run_inserters(lexer());
-         }
-
-         if (settings_.joiner_enabled())
-         {
-            helper_assembly_.run_joiners(lexer());
-         }
-
-         if (settings_.replacer_enabled())
-         {
-            helper_assembly_.run_modifiers(lexer());
-         }
-
-         if (
-              settings_.numeric_check_enabled () ||
-              settings_.bracket_check_enabled () ||
-              settings_.sequence_check_enabled()
-            )
+         /*
+            Only the helpers enabled by the settings are registered, and
+            they are all run together in a single pass over the tokens.
+         */
+         if (!helper_assembly_.run_pipeline(lexer()))
          {
-            if (!helper_assembly_.run_scanners(lexer()))
+            if (helper_assembly_.error_token_scanner)
             {
-               if (helper_assembly_.error_token_scanner)
-               {
-                  lexer::helper::bracket_checker*            bracket_checker_ptr     = 0;
-                  lexer::helper::numeric_checker<T>*         numeric_checker_ptr     = 0;
-                  lexer::helper::sequence_validator*         sequence_validator_ptr  = 0;
-                  lexer::helper::sequence_validator_3tokens* sequence_validator3_ptr = 0;
+               lexer::helper::bracket_checker*            bracket_checker_ptr     = 0;
+               lexer::helper::numeric_checker<T>*         numeric_checker_ptr     = 0;
+               lexer::helper::sequence_validator*         sequence_validator_ptr  = 0;
+               lexer::helper::sequence_validator_3tokens* sequence_validator3_ptr = 0;
 
-                  if (0 != (bracket_checker_ptr = dynamic_cast<lexer::helper::bracket_checker*>(helper_assembly_.error_token_scanner)))
+               if (0 != (bracket_checker_ptr = dynamic_cast<lexer::helper::bracket_checker*>(helper_assembly_.error_token_scanner)))
+               {
+                  set_error(make_error(
+                     parser_error::e_token,
+                     bracket_checker_ptr->error_token(),
+                     "ERR005 - Mismatched brackets: '" + bracket_checker_ptr->error_token().value + "'",
+                     exprtk_error_location));
+               }
+               else if (0 != (numeric_checker_ptr = dynamic_cast<lexer::helper::numeric_checker<T>*>(helper_assembly_.error_token_scanner)))
+               {
+                  for (std::size_t i = 0; i < numeric_checker_ptr->error_count(); ++i)
                   {
+                     lexer::token error_token = lexer()[numeric_checker_ptr->error_index(i)];
+
                      set_error(make_error(
                         parser_error::e_token,
-                        bracket_checker_ptr->error_token(),
-                        "ERR005 - Mismatched brackets: '" + bracket_checker_ptr->error_token().value + "'",
+                        error_token,
+                        "ERR006 - Invalid numeric token: '" + error_token.value + "'",
                         exprtk_error_location));
                   }
-                  else if (0 != (numeric_checker_ptr = dynamic_cast<lexer::helper::numeric_checker<T>*>(helper_assembly_.error_token_scanner)))
-                  {
-                     for (std::size_t i = 0; i < numeric_checker_ptr->error_count(); ++i)
-                     {
-                        lexer::token error_token = lexer()[numeric_checker_ptr->error_index(i)];
-
-                        set_error(make_error(
-                           parser_error::e_token,
-                           error_token,
-                           "ERR006 - Invalid numeric token: '" + error_token.value + "'",
-                           exprtk_error_location));
-                     }
 
-                     if (numeric_checker_ptr->error_count())
-                     {
-                        numeric_checker_ptr->clear_errors();
-                     }
+                  if (numeric_checker_ptr->error_count())
+                  {
+                     numeric_checker_ptr->clear_errors();
                   }
-                  else if (0 != (sequence_validator_ptr = dynamic_cast<lexer::helper::sequence_validator*>(helper_assembly_.error_token_scanner)))
+               }
+               else if (0 != (sequence_validator_ptr = dynamic_cast<lexer::helper::sequence_validator*>(helper_assembly_.error_token_scanner)))
+               {
+                  for (std::size_t i = 0; i < sequence_validator_ptr->error_count(); ++i)
                   {
-                     for (std::size_t i = 0; i < sequence_validator_ptr->error_count(); ++i)
-                     {
-                        std::pair<lexer::token,lexer::token> error_token = sequence_validator_ptr->error(i);
+                     std::pair<lexer::token,lexer::token> error_token = sequence_validator_ptr->error(i);
 
-                        set_error(make_error(
-                           parser_error::e_token,
-                           error_token.first,
-                           "ERR007 - Invalid token sequence: '" +
-                           error_token.first.value  + "' and '" +
-                           error_token.second.value + "'",
-                           exprtk_error_location));
-                     }
+                     set_error(make_error(
+                        parser_error::e_token,
+                        error_token.first,
+                        "ERR007 - Invalid token sequence: '" +
+                        error_token.first.value  + "' and '" +
+                        error_token.second.value + "'",
+                        exprtk_error_location));
+                  }
 
-                     if (sequence_validator_ptr->error_count())
-                     {
-                        sequence_validator_ptr->clear_errors();
-                     }
+                  if (sequence_validator_ptr->error_count())
+                  {
+                     sequence_validator_ptr->clear_errors();
                   }
-                  else if (0 != (sequence_validator3_ptr = dynamic_cast<lexer::helper::sequence_validator_3tokens*>(helper_assembly_.error_token_scanner)))
+               }
+               else if (0 != (sequence_validator3_ptr = dynamic_cast<lexer::helper::sequence_validator_3tokens*>(helper_assembly_.error_token_scanner)))
+               {
+                  for (std::size_t i = 0; i < sequence_validator3_ptr->error_count(); ++i)
                   {
-                     for (std::size_t i = 0; i < sequence_validator3_ptr->error_count(); ++i)
-                     {
-                        std::pair<lexer::token,lexer::token> error_token = sequence_validator3_ptr->error(i);
+                     std::pair<lexer::token,lexer::token> error_token = sequence_validator3_ptr->error(i);
 
-                        set_error(make_error(
-                           parser_error::e_token,
-                           error_token.first,
-                           "ERR008 - Invalid token sequence: '" +
-                           error_token.first.value  + "' and '" +
-                           error_token.second.value + "'",
-                           exprtk_error_location));
-                     }
+                     set_error(make_error(
+                        parser_error::e_token,
+                        error_token.first,
+                        "ERR008 - Invalid token sequence: '" +
+                        error_token.first.value  + "' and '" +
+                        error_token.second.value + "'",
+                        exprtk_error_location));
+                  }
 
-                     if (sequence_validator3_ptr->error_count())
-                     {
-                        sequence_validator3_ptr->clear_errors();
-                     }
+                  if (sequence_validator3_ptr->error_count())
+                  {
+                     sequence_validator3_ptr->clear_errors();
                   }
                }
-
-               return false;
             }
+
+            return false;
          }
 
          return true;
@@ -25437,7 +28282,9 @@ namespace exprtk
             return error_node();
          }
 
-         expression_node_ptr expression = parse_branch(precedence);
+         const std::size_t begin_token_index = current_token_index();
+
+         expression_node_ptr expression = cse_process(begin_token_index, parse_branch(precedence));
 
          if (0 == expression)
          {
@@ -25681,6 +28528,8 @@ namespace exprtk
             }
             else
             {
+               new_expression = cse_process(begin_token_index, new_expression);
+
                if (
                     token_is(token_t::e_ternary,prsrhlpr_t::e_hold) &&
                     (e_level00 == precedence)
@@ -28515,6 +31364,98 @@ namespace exprtk
          return expression_generator_.vector_element(vector_name, vec, vec_node, index_expr);
       }
 
+      inline bool is_bitvector_aggregate_argument()
+      {
+         // Token layout: <aggregate> ( <bit-vector> ) - the current token being ')'
+         const std::size_t rbracket_index = lexer().next_token_index() - 1;
+
+         if ((rbracket_index < 3) || (token_t::e_rbracket != current_token().type))
+            return false;
+
+         const token_t& lbracket  = lexer()[rbracket_index - 2];
+         const token_t& aggregate = lexer()[rbracket_index - 3];
+
+         return (token_t::e_lbracket == lbracket .type) &&
+                (token_t::e_symbol   == aggregate.type) &&
+                (
+                  details::imatch(aggregate.value, "sum") ||
+                  details::imatch(aggregate.value, "avg") ||
+                  details::imatch(aggregate.value, "min") ||
+                  details::imatch(aggregate.value, "max")
+                );
+      }
+
+      inline expression_node_ptr parse_bitvector(scope_element& se)
+      {
+         const std::string bitvector_name = current_token().value;
+
+         details::bitvector_store* store = reinterpret_cast<details::bitvector_store*>(se.data);
+
+         assert(0 != store);
+
+         lodge_symbol(bitvector_name, e_st_local_vector);
+
+         const token_t bitvector_token = current_token();
+
+         next_token();
+
+         if (!token_is(token_t::e_lsqrbracket))
+         {
+            /*
+               A bit-vector is not a vector of T, so other than indexing
+               it may only appear as the sole argument of an aggregate
+               that has a bit-vector form: sum(x), avg(x), min(x), max(x)
+            */
+            if (!is_bitvector_aggregate_argument())
+            {
+               set_error(make_error(
+                  parser_error::e_syntax,
+                  bitvector_token,
+                  "ERR294 - Bit-vector '" + bitvector_name + "' can only be used as " +
+                  bitvector_name + "[i], " + bitvector_name + "[] or as the sole argument "
+                  "of sum, avg, min or max",
+                  exprtk_error_location));
+
+               return error_node();
+            }
+
+            return node_allocator_.allocate<bitvector_node_t>(store);
+         }
+         else if (token_is(token_t::e_rsqrbracket))
+         {
+            return expression_generator_(T(store->size()));
+         }
+
+         expression_node_ptr index_expr = parse_vector_index(bitvector_name);
+
+         if (0 == index_expr)
+         {
+            return error_node();
+         }
+
+         // Perform compile-time range check
+         if (details::is_constant_node(index_expr))
+         {
+            const std::size_t index = static_cast<std::size_t>(details::numeric::to_int32(index_expr->value()));
+
+            if (index >= store->size())
+            {
+               set_error(make_error(
+                  parser_error::e_syntax,
+                  current_token(),
+                  "ERR284 - Index of " + details::to_str(index) + " out of range for "
+                  "bit-vector '" + bitvector_name + "' of size " + details::to_str(store->size()),
+                  exprtk_error_location));
+
+               free_node(node_allocator_, index_expr);
+
+               return error_node();
+            }
+         }
+
+         return node_allocator_.allocate<bitvector_elem_node_t>(store, index_expr);
+      }
+
       inline expression_node_ptr parse_vararg_function_call(ivararg_function<T>* vararg_function, const std::string& vararg_function_name)
       {
          std::vector<expression_node_ptr> arg_list;
@@ -29399,6 +32340,137 @@ namespace exprtk
       }
       #endif
 
+      inline expression_node_ptr parse_define_bitvector_statement(const std::string& vec_name, const std::size_t vec_size)
+      {
+         const std::size_t predicted_total_lclsymb_size = ((vec_size + 7) / 8) + sem_.total_local_symb_size_bytes();
+
+         if (predicted_total_lclsymb_size > settings().max_total_local_symbol_size_bytes())
+         {
+            set_error(make_error(
+               parser_error::e_syntax,
+               current_token(),
+               "ERR286 - Adding bit-vector '" + vec_name + "' of size " + details::to_str(vec_size) + " "
+               "will exceed max total local symbol size of: " + details::to_str(settings().max_total_local_symbol_size_bytes())  + " bytes, "
+               "current total size: " + details::to_str(sem_.total_local_symb_size_bytes()) + " bytes",
+               exprtk_error_location));
+
+            return error_node();
+         }
+
+         details::bitvector_store* store = reinterpret_cast<details::bitvector_store*>(0);
+
+         scope_element& se = sem_.get_element(vec_name);
+
+         if (se.name == vec_name)
+         {
+            if (se.active)
+            {
+               set_error(make_error(
+                  parser_error::e_syntax,
+                  current_token(),
+                  "ERR287 - Illegal redefinition of local vector: '" + vec_name + "'",
+                  exprtk_error_location));
+
+               return error_node();
+            }
+            else if (
+                      (se.size == vec_size) &&
+                      (scope_element::e_bitvector == se.type)
+                    )
+            {
+               store     = reinterpret_cast<details::bitvector_store*>(se.data);
+               se.active = true;
+               se.depth  = state_.scope_depth;
+               se.ref_count++;
+            }
+         }
+
+         if (0 == store)
+         {
+            scope_element nse;
+            nse.name      = vec_name;
+            nse.active    = true;
+            nse.ref_count = 1;
+            nse.type      = scope_element::e_bitvector;
+            nse.depth     = state_.scope_depth;
+            nse.size      = vec_size;
+            nse.data      = new details::bitvector_store(vec_size);
+
+            if (!sem_.add_element(nse))
+            {
+               set_error(make_error(
+                  parser_error::e_syntax,
+                  current_token(),
+                  "ERR288 - Failed to add new local bit-vector '" + vec_name + "' to SEM",
+                  exprtk_error_location));
+
+               sem_.free_element(nse);
+
+               return error_node();
+            }
+
+            store = reinterpret_cast<details::bitvector_store*>(nse.data);
+
+            exprtk_debug(("parse_define_bitvector_statement() - INFO - Added new local bit-vector: %s[%d]\n",
+                          nse.name.c_str(),
+                          static_cast<int>(nse.size)));
+         }
+
+         state_.activate_side_effect("parse_define_bitvector_statement()");
+
+         lodge_symbol(vec_name, e_st_local_vector);
+
+         expression_node_ptr initialiser = error_node();
+
+         if (!token_is(token_t::e_eof, prsrhlpr_t::e_hold))
+         {
+            if (!token_is(token_t::e_assign))
+            {
+               set_error(make_error(
+                  parser_error::e_syntax,
+                  current_token(),
+                  "ERR289 - Expected ':=' as part of bit-vector definition",
+                  exprtk_error_location));
+
+               return error_node();
+            }
+            else if (!token_is(token_t::e_lsqrbracket))
+            {
+               set_error(make_error(
+                  parser_error::e_syntax,
+                  current_token(),
+                  "ERR290 - Expected '[' as part of bit-vector initialiser for: " + vec_name,
+                  exprtk_error_location));
+
+               return error_node();
+            }
+            else if (0 == (initialiser = parse_expression()))
+            {
+               set_error(make_error(
+                  parser_error::e_syntax,
+                  current_token(),
+                  "ERR291 - Failed to parse bit-vector initialiser for: " + vec_name,
+                  exprtk_error_location));
+
+               return error_node();
+            }
+            else if (!token_is(token_t::e_rsqrbracket))
+            {
+               free_node(node_allocator_, initialiser);
+
+               set_error(make_error(
+                  parser_error::e_syntax,
+                  current_token(),
+                  "ERR292 - Expected ']' to close bit-vector initialiser for: " + vec_name,
+                  exprtk_error_location));
+
+               return error_node();
+            }
+         }
+
+         return node_allocator_.allocate<bitvector_init_node_t>(store, initialiser);
+      }
+
       inline expression_node_ptr parse_define_vector_statement(const std::string& vec_name)
       {
          expression_node_ptr size_expression_node = error_node();
@@ -29470,6 +32542,30 @@ namespace exprtk
          typename symbol_table_t::vector_holder_ptr vec_holder = typename symbol_table_t::vector_holder_ptr(0);
 
          const std::size_t vec_size = static_cast<std::size_t>(details::numeric::to_int32(vector_size));
+
+         // Are we dealing with a bit-vector definition: var x[n] : bool
+         if (
+              token_is(token_t::e_rsqrbracket, prsrhlpr_t::e_hold) &&
+              peek_token_is(token_t::e_colon)
+            )
+         {
+            next_token();
+            next_token();
+
+            if (!token_is("bool"))
+            {
+               set_error(make_error(
+                  parser_error::e_syntax,
+                  current_token(),
+                  "ERR285 - Expected 'bool' as element type of vector '" + vec_name + "'",
+                  exprtk_error_location));
+
+               return error_node();
+            }
+
+            return parse_define_bitvector_statement(vec_name, vec_size);
+         }
+
          const std::size_t predicted_total_lclsymb_size = sizeof(T) * vec_size + sem_.total_local_symb_size_bytes();
 
          if (predicted_total_lclsymb_size > settings().max_total_local_symbol_size_bytes())
@@ -29520,7 +32616,7 @@ namespace exprtk
             nse.type      = scope_element::e_vector;
             nse.depth     = state_.scope_depth;
             nse.size      = vec_size;
-            nse.data      = new T[vec_size];
+            nse.data      = details::vector_storage<T>::create(vec_size);
             nse.vec_node  = new typename scope_element::vector_holder_t(reinterpret_cast<T*>(nse.data),nse.size);
 
             details::set_zero_value(reinterpret_cast<T*>(nse.data),vec_size);
@@ -31115,6 +34211,53 @@ namespace exprtk
          immutable_symtok_map_[interval] = token;
       }
 
+      /*
+         Literal parameters ($name) compile to a variable node over
+         storage owned by the expression, so the specialised variable
+         nodes are retained while the value remains patchable from the
+         host by way of expression::parameter/set_parameter.
+      */
+      inline expression_node_ptr parse_literal_parameter()
+      {
+         const std::string symbol = current_token().value;
+
+         if (!settings_.literal_parameters_enabled())
+         {
+            set_error(make_error(
+               parser_error::e_syntax,
+               current_token(),
+               "ERR293 - Literal parameter '" + symbol + "' encountered, however literal parameters are not enabled",
+               exprtk_error_location));
+
+            return error_node();
+         }
+
+         std::string name = symbol.substr(1);
+         details::case_normalise(name);
+
+         typename literal_parameter_map_t::iterator itr = literal_parameter_map_.find(name);
+
+         if (literal_parameter_map_.end() == itr)
+         {
+            literal_parameter_t parameter;
+            parameter.data = new T(T(0));
+            parameter.node = static_cast<variable_node_t*>(
+                                node_allocator_.allocate<variable_node_t>(*parameter.data));
+
+            itr = literal_parameter_map_.insert(std::make_pair(name, parameter)).first;
+         }
+
+         // Parameters are set by the host, not assigned-to by the expression
+         lodge_immutable_symbol(current_token(), make_memory_range(*itr->second.data));
+
+         if (!post_variable_process(symbol))
+            return error_node();
+
+         next_token();
+
+         return itr->second.node;
+      }
+
       inline expression_node_ptr parse_symtab_symbol()
       {
          const std::string symbol = current_token().value;
@@ -31177,6 +34320,10 @@ namespace exprtk
                {
                   return parse_vector();
                }
+               else if (scope_element::e_bitvector == se.type)
+               {
+                  return parse_bitvector(se);
+               }
                #ifndef exprtk_disable_string_capabilities
                else if (scope_element::e_string == se.type)
                {
@@ -31206,7 +34353,7 @@ namespace exprtk
                                       parse_function_invocation(function,symbol);
 
                if (func_node)
-                  return func_node;
+                  return cse_barrier(func_node);
                else
                {
                   set_error(make_error(
@@ -31232,7 +34379,7 @@ namespace exprtk
                                       parse_vararg_function_call(vararg_function, symbol);
 
                if (vararg_func_node)
-                  return vararg_func_node;
+                  return cse_barrier(vararg_func_node);
                else
                {
                   set_error(make_error(
@@ -31258,7 +34405,7 @@ namespace exprtk
                                       parse_generic_function_call(generic_function, symbol);
 
                if (genericfunc_node)
-                  return genericfunc_node;
+                  return cse_barrier(genericfunc_node);
                else
                {
                   set_error(make_error(
@@ -31513,21 +34660,24 @@ namespace exprtk
                    settings_.control_struct_enabled(symbol)
                  )
          {
-            return check_block_statement_closure(parse_while_loop());
+            const std::size_t loop_begin = licm_enter_loop();
+            return check_block_statement_closure(licm_exit_loop(loop_begin, parse_while_loop()));
          }
          else if (
                    details::imatch(symbol, symbol_repeat) &&
                    settings_.control_struct_enabled(symbol)
                  )
          {
-            return check_block_statement_closure(parse_repeat_until_loop());
+            const std::size_t loop_begin = licm_enter_loop();
+            return check_block_statement_closure(licm_exit_loop(loop_begin, parse_repeat_until_loop()));
          }
          else if (
                    details::imatch(symbol, symbol_for) &&
                    settings_.control_struct_enabled(symbol)
                  )
          {
-            return check_block_statement_closure(parse_for_loop());
+            const std::size_t loop_begin = licm_enter_loop();
+            return check_block_statement_closure(licm_exit_loop(loop_begin, parse_for_loop()));
          }
          else if (
                    details::imatch(symbol, symbol_switch) &&
@@ -31540,6 +34690,10 @@ namespace exprtk
          {
             return parse_special_function();
          }
+         else if ('$' == symbol[0])
+         {
+            return parse_literal_parameter();
+         }
          else if (details::imatch(symbol, symbol_null))
          {
             return parse_null_statement();
@@ -32080,6 +35234,14 @@ namespace exprtk
             }
             else if (details::is_constant_node(branch[0]))
             {
+               if (parser_->settings_.approximations_enabled())
+               {
+                  expression_node_ptr result = const_optimise_approx_unary(operation,branch);
+
+                  if (result)
+                     return result;
+               }
+
                return synthesize_expression<unary_node_t,1>(operation,branch);
             }
             else if (unary_optimisable(operation) && details::is_variable_node(branch[0]))
@@ -32571,6 +35733,12 @@ namespace exprtk
             {
                return synthesize_vecarithmetic_operation_expression(operation, branch);
             }
+            #ifndef exprtk_disable_string_capabilities
+            else if (is_string_set_expression(operation, branch))
+            {
+               return synthesize_string_set_expression(branch);
+            }
+            #endif
             else if (is_shortcircuit_expression(operation))
             {
                return synthesize_shortcircuit_expression(operation, branch);
@@ -32765,6 +35933,17 @@ namespace exprtk
                }
             }
 
+            #ifndef exprtk_disable_string_capabilities
+            {
+               expression_node_ptr string_switch = string_switch_conditional(condition, consequent, alternative);
+
+               if (string_switch)
+               {
+                  return string_switch;
+               }
+            }
+            #endif
+
             expression_node_ptr result = error_node();
             std::string node_name      = "Unknown!";
 
@@ -32794,6 +35973,261 @@ namespace exprtk
             return error_node();
          }
 
+         inline bool is_numeric_case(expression_node_ptr node, const Type*& var, Type& key) const
+         {
+            typedef details::voc_base_node<Type> voc_node_t;
+            typedef details::cov_base_node<Type> cov_node_t;
+
+            if (0 == node)
+               return false;
+            else if (const voc_node_t* voc = dynamic_cast<const voc_node_t*>(node))
+            {
+               if (details::e_eq != voc->operation())
+                  return false;
+
+               var = &voc->v();
+               key =  voc->c();
+               return true;
+            }
+            else if (const cov_node_t* cov = dynamic_cast<const cov_node_t*>(node))
+            {
+               if (details::e_eq != cov->operation())
+                  return false;
+
+               var = &cov->v();
+               key =  cov->c();
+               return true;
+            }
+
+            return false;
+         }
+
+         // Extracts the keys of cases of the form 'var == constant' over the same variable
+         template <typename Allocator,
+                   template <typename, typename> class Sequence>
+         inline bool is_numeric_switch(Sequence<expression_node_ptr,Allocator>& arg_list,
+                                       const std::size_t case_count,
+                                       const Type*& var,
+                                       std::vector<Type>& key_list) const
+         {
+            if (case_count < 2)
+               return false;
+
+            var = 0;
+            key_list.resize(case_count);
+
+            for (std::size_t i = 0; i < case_count; ++i)
+            {
+               const Type* case_var = 0;
+
+               if (
+                    !is_numeric_case(arg_list[2 * i], case_var, key_list[i]) ||
+                    ((0 != var) && (case_var != var))
+                  )
+                  return false;
+
+               var = case_var;
+            }
+
+            return true;
+         }
+
+         template <typename Allocator,
+                   template <typename, typename> class Sequence>
+         inline expression_node_ptr numeric_switch_statement(Sequence<expression_node_ptr,Allocator>& arg_list) const
+         {
+            typedef details::numeric_switch_node<Type> numeric_switch_node_t;
+
+            const std::size_t case_count = (arg_list.size() - 1) / 2;
+
+            const Type* var = 0;
+            std::vector<Type> key_list;
+
+            if (!is_numeric_switch(arg_list, case_count, var, key_list))
+               return error_node();
+
+            std::vector<expression_node_ptr> consequent_list(case_count);
+
+            for (std::size_t i = 0; i < case_count; ++i)
+            {
+               consequent_list[i] = arg_list[(2 * i) + 1];
+               details::free_node(*node_allocator_, arg_list[2 * i]);
+            }
+
+            return node_allocator_->
+                      allocate_rrrr<numeric_switch_node_t>(*var, key_list, consequent_list, arg_list.back());
+         }
+
+         template <typename Allocator,
+                   template <typename, typename> class Sequence>
+         inline expression_node_ptr numeric_multi_switch_statement(Sequence<expression_node_ptr,Allocator>& arg_list) const
+         {
+            typedef details::numeric_multi_switch_node<Type> numeric_multi_switch_node_t;
+
+            const std::size_t case_count = arg_list.size() / 2;
+
+            const Type* var = 0;
+            std::vector<Type> key_list;
+
+            if (!is_numeric_switch(arg_list, case_count, var, key_list))
+               return error_node();
+
+            std::vector<expression_node_ptr> consequent_list(case_count);
+
+            for (std::size_t i = 0; i < case_count; ++i)
+            {
+               consequent_list[i] = arg_list[(2 * i) + 1];
+               details::free_node(*node_allocator_, arg_list[2 * i]);
+            }
+
+            return node_allocator_->
+                      allocate_rrr<numeric_multi_switch_node_t>(*var, key_list, consequent_list);
+         }
+
+         #ifndef exprtk_disable_string_capabilities
+         inline bool is_string_case(expression_node_ptr node, const std::string*& str, std::string& literal) const
+         {
+            typedef details::sos_node<Type, std::string&, const std::string, details::eq_op<Type> > sol_node_t;
+            typedef details::sos_node<Type, const std::string, std::string&, details::eq_op<Type> > los_node_t;
+
+            if (0 == node)
+               return false;
+            else if (const sol_node_t* sol = dynamic_cast<const sol_node_t*>(node))
+            {
+               str     = &sol->s0();
+               literal =  sol->s1();
+               return true;
+            }
+            else if (const los_node_t* los = dynamic_cast<const los_node_t*>(node))
+            {
+               str     = &los->s1();
+               literal =  los->s0();
+               return true;
+            }
+
+            return false;
+         }
+
+         // if (s == 'a') x else if (s == 'b') y ... chains over the same string variable
+         inline expression_node_ptr string_switch_conditional(expression_node_ptr condition,
+                                                              expression_node_ptr consequent,
+                                                              expression_node_ptr alternative) const
+         {
+            typedef details::string_switch_node<Type> string_switch_node_t;
+
+            const std::string* str = 0;
+            std::string literal;
+
+            if (!is_string_case(condition, str, literal))
+               return error_node();
+
+            string_switch_node_t* chain = dynamic_cast<string_switch_node_t*>(alternative);
+
+            if (chain && (&chain->str() == str))
+            {
+               chain->add_case(literal, consequent, true);
+               details::free_node(*node_allocator_, condition);
+
+               return alternative;
+            }
+
+            string_switch_node_t* result = static_cast<string_switch_node_t*>(
+               node_allocator_->allocate_rc<string_switch_node_t>(*str, alternative));
+
+            result->add_case(literal, consequent, false);
+            details::free_node(*node_allocator_, condition);
+
+            return result;
+         }
+
+         // s == 'a' or s == 'b' ... chains over the same string variable
+         inline bool is_string_set_expression(const details::operator_type& operation, expression_node_ptr (&branch)[2]) const
+         {
+            typedef details::string_set_node<Type> string_set_node_t;
+
+            if ((details::e_or != operation) && (details::e_scor != operation))
+               return false;
+
+            const std::string* str0 = 0;
+            const std::string* str1 = 0;
+            std::string literal;
+
+            if (!is_string_case(branch[1], str1, literal))
+               return false;
+            else if (const string_set_node_t* set = dynamic_cast<const string_set_node_t*>(branch[0]))
+               return (&set->str() == str1);
+            else
+               return is_string_case(branch[0], str0, literal) && (str0 == str1);
+         }
+
+         inline expression_node_ptr synthesize_string_set_expression(expression_node_ptr (&branch)[2]) const
+         {
+            typedef details::string_set_node<Type> string_set_node_t;
+
+            const std::string* str = 0;
+            std::string literal;
+
+            string_set_node_t* result = dynamic_cast<string_set_node_t*>(branch[0]);
+
+            if (0 == result)
+            {
+               is_string_case(branch[0], str, literal);
+
+               result = static_cast<string_set_node_t*>(
+                  node_allocator_->allocate_c<string_set_node_t>(*str));
+
+               result->add_literal(literal);
+               details::free_node(*node_allocator_, branch[0]);
+            }
+
+            is_string_case(branch[1], str, literal);
+
+            result->add_literal(literal);
+            details::free_node(*node_allocator_, branch[1]);
+
+            return result;
+         }
+
+         template <typename Allocator,
+                   template <typename, typename> class Sequence>
+         inline expression_node_ptr string_switch_statement(Sequence<expression_node_ptr,Allocator>& arg_list) const
+         {
+            typedef details::string_switch_node<Type> string_switch_node_t;
+
+            const std::size_t case_count = (arg_list.size() - 1) / 2;
+
+            if (0 == case_count)
+               return error_node();
+
+            const std::string* str = 0;
+            std::vector<std::string> literal_list(case_count);
+
+            for (std::size_t i = 0; i < case_count; ++i)
+            {
+               const std::string* case_str = 0;
+
+               if (
+                    !is_string_case(arg_list[2 * i], case_str, literal_list[i]) ||
+                    ((0 != str) && (case_str != str))
+                  )
+                  return error_node();
+
+               str = case_str;
+            }
+
+            string_switch_node_t* result = static_cast<string_switch_node_t*>(
+               node_allocator_->allocate_rc<string_switch_node_t>(*str, arg_list.back()));
+
+            for (std::size_t i = 0; i < case_count; ++i)
+            {
+               result->add_case(literal_list[i], arg_list[(2 * i) + 1], false);
+               details::free_node(*node_allocator_, arg_list[2 * i]);
+            }
+
+            return result;
+         }
+         #endif
+
          #ifndef exprtk_disable_string_capabilities
          inline expression_node_ptr conditional_string(expression_node_ptr condition,
                                                        expression_node_ptr consequent,
@@ -33348,6 +36782,26 @@ namespace exprtk
             else if (is_constant_foldable(arg_list))
                return const_optimise_switch(arg_list);
 
+            {
+               expression_node_ptr numeric_switch = numeric_switch_statement(arg_list);
+
+               if (numeric_switch)
+               {
+                  return numeric_switch;
+               }
+            }
+
+            #ifndef exprtk_disable_string_capabilities
+            {
+               expression_node_ptr string_switch = string_switch_statement(arg_list);
+
+               if (string_switch)
+               {
+                  return string_switch;
+               }
+            }
+            #endif
+
             switch ((arg_list.size() - 1) / 2)
             {
                #define case_stmt(N)                                                       \
@@ -33381,8 +36835,17 @@ namespace exprtk
             }
             else if (is_constant_foldable(arg_list))
                return const_optimise_mswitch(arg_list);
-            else
-               return node_allocator_->allocate<details::multi_switch_node<Type> >(arg_list);
+
+            {
+               expression_node_ptr numeric_switch = numeric_multi_switch_statement(arg_list);
+
+               if (numeric_switch)
+               {
+                  return numeric_switch;
+               }
+            }
+
+            return node_allocator_->allocate<details::multi_switch_node<Type> >(arg_list);
          }
 
          inline expression_node_ptr assert_call(expression_node_ptr& assert_condition,
@@ -33449,52 +36912,120 @@ namespace exprtk
          case_stmt(details::e_frac  , details::frac_op ) \
          case_stmt(details::e_trunc , details::trunc_op) \
 
+         /*
+            With approximations enabled, these functions are evaluated by
+            the polynomial forms in details::numeric::approx.
+         */
+         #define approx_unary_opr_switch_statements            \
+         case_stmt(details::e_cos  , details::approx_cos_op ) \
+         case_stmt(details::e_erf  , details::approx_erf_op ) \
+         case_stmt(details::e_erfc , details::approx_erfc_op) \
+         case_stmt(details::e_exp  , details::approx_exp_op ) \
+         case_stmt(details::e_log  , details::approx_log_op ) \
+         case_stmt(details::e_ncdf , details::approx_ncdf_op) \
+         case_stmt(details::e_sin  , details::approx_sin_op ) \
+
          inline expression_node_ptr synthesize_uv_expression(const details::operator_type& operation,
                                                              expression_node_ptr (&branch)[1])
          {
             T& v = static_cast<details::variable_node<T>*>(branch[0])->ref();
 
-            switch (operation)
+            #define case_stmt(op0, op1)                                                         \
+            case op0 : return node_allocator_->                                                 \
+                          allocate<typename details::unary_variable_node<Type,op1<Type> > >(v); \
+
+            if (parser_->settings_.approximations_enabled())
             {
-               #define case_stmt(op0, op1)                                                         \
-               case op0 : return node_allocator_->                                                 \
-                             allocate<typename details::unary_variable_node<Type,op1<Type> > >(v); \
+               switch (operation)
+               {
+                  approx_unary_opr_switch_statements
+                  default : break;
+               }
+            }
 
+            switch (operation)
+            {
                unary_opr_switch_statements
-               #undef case_stmt
                default : return error_node();
             }
+
+            #undef case_stmt
          }
 
          inline expression_node_ptr synthesize_uvec_expression(const details::operator_type& operation,
                                                                expression_node_ptr (&branch)[1])
          {
-            switch (operation)
+            #define case_stmt(op0, op1)                                                   \
+            case op0 : return node_allocator_->                                           \
+                          allocate<typename details::unary_vector_node<Type,op1<Type> > > \
+                             (operation, branch[0]);                                      \
+
+            if (parser_->settings_.approximations_enabled())
             {
-               #define case_stmt(op0, op1)                                                   \
-               case op0 : return node_allocator_->                                           \
-                             allocate<typename details::unary_vector_node<Type,op1<Type> > > \
-                                (operation, branch[0]);                                      \
+               switch (operation)
+               {
+                  approx_unary_opr_switch_statements
+                  default : break;
+               }
+            }
 
+            switch (operation)
+            {
                unary_opr_switch_statements
-               #undef case_stmt
                default : return error_node();
             }
+
+            #undef case_stmt
          }
 
          inline expression_node_ptr synthesize_unary_expression(const details::operator_type& operation,
                                                                 expression_node_ptr (&branch)[1])
          {
-            switch (operation)
+            #define case_stmt(op0, op1)                                                               \
+            case op0 : return node_allocator_->                                                       \
+                          allocate<typename details::unary_branch_node<Type,op1<Type> > >(branch[0]); \
+
+            if (parser_->settings_.approximations_enabled())
             {
-               #define case_stmt(op0, op1)                                                               \
-               case op0 : return node_allocator_->                                                       \
-                             allocate<typename details::unary_branch_node<Type,op1<Type> > >(branch[0]); \
+               switch (operation)
+               {
+                  approx_unary_opr_switch_statements
+                  default : break;
+               }
+            }
 
+            switch (operation)
+            {
                unary_opr_switch_statements
-               #undef case_stmt
                default : return error_node();
             }
+
+            #undef case_stmt
+         }
+
+         // Constant arguments are folded through the same approximations as any other
+         inline expression_node_ptr const_optimise_approx_unary(const details::operator_type& operation,
+                                                                expression_node_ptr (&branch)[1])
+         {
+            expression_node_ptr temp_node = error_node();
+
+            #define case_stmt(op0, op1)                                                                \
+            case op0 : temp_node = node_allocator_->                                                   \
+                          allocate<typename details::unary_branch_node<Type,op1<Type> > >(branch[0]); \
+                       break;                                                                          \
+
+            switch (operation)
+            {
+               approx_unary_opr_switch_statements
+               default : return error_node();
+            }
+
+            #undef case_stmt
+
+            const Type v = temp_node->value();
+            details::free_node(*node_allocator_, temp_node);
+
+            return node_allocator_->allocate<literal_node_t>(v);
          }
 
          inline expression_node_ptr const_optimise_sf3(const details::operator_type& operation,
@@ -33801,6 +37332,27 @@ namespace exprtk
                return error_node();
          }
 
+         template <typename Allocator,
+                   template <typename, typename> class Sequence>
+         inline expression_node_ptr bitvector_func(const details::operator_type& operation,
+                                                   Sequence<expression_node_ptr,Allocator>& arg_list)
+         {
+            if (1 == arg_list.size())
+            {
+               switch (operation)
+               {
+                  case details::e_sum :
+                  case details::e_avg :
+                  case details::e_min :
+                  case details::e_max : return node_allocator_->
+                                           template allocate<bitvector_count_node_t>(operation, arg_list[0]);
+                  default             : return error_node();
+               }
+            }
+            else
+               return error_node();
+         }
+
          template <typename Allocator,
                    template <typename, typename> class Sequence>
          inline expression_node_ptr vararg_function(const details::operator_type& operation,
@@ -33816,6 +37368,8 @@ namespace exprtk
                return const_optimise_varargfunc(operation,arg_list);
             else if ((1 == arg_list.size()) && details::is_ivector_node(arg_list[0]))
                return vectorize_func(operation,arg_list);
+            else if ((1 == arg_list.size()) && details::is_bitvector_node(arg_list[0]))
+               return bitvector_func(operation,arg_list);
             else if ((1 == arg_list.size()) && special_one_parameter_vararg(operation))
                return arg_list[0];
             else if (all_nodes_variables(arg_list))
@@ -34181,6 +37735,8 @@ namespace exprtk
          {
             typedef details::return_envelope_node<Type> alloc_type;
 
+            mark_tail_return(body);
+
             expression_node_ptr result = node_allocator_->
                                             allocate_cr<alloc_type>(body,(*rc));
 
@@ -34188,6 +37744,31 @@ namespace exprtk
 
             return result;
          }
+
+         /*
+            Marks the return statement that is the last statement of the
+            program, directly or through nested statement sequences.
+         */
+         inline void mark_tail_return(expression_node_ptr node) const
+         {
+            typedef details::vararg_node<Type,details::vararg_multi_op<Type> > multi_node_t;
+
+            while (node)
+            {
+               if (details::expression_node<Type>::e_return == node->type())
+               {
+                  static_cast<details::return_node<Type>*>(node)->set_tail();
+                  return;
+               }
+
+               const multi_node_t* multi_node = dynamic_cast<const multi_node_t*>(node);
+
+               if ((0 == multi_node) || (0 == multi_node->size()))
+                  return;
+
+               node = (*multi_node)[multi_node->size() - 1];
+            }
+         }
          #else
          inline expression_node_ptr return_call(std::vector<expression_node_ptr>&)
          {
@@ -34561,6 +38142,11 @@ namespace exprtk
                lodge_assignment(e_st_vecelem,branch[0]);
                return synthesize_expression<assignment_rebasevec_celem_node_t, 2>(operation, branch);
             }
+            else if (details::is_bitvector_elem_node(branch[0]))
+            {
+               lodge_assignment(e_st_local_vector,branch[0]);
+               return synthesize_expression<assignment_bitvec_elem_node_t, 2>(operation, branch);
+            }
             #ifndef exprtk_disable_string_capabilities
             else if (details::is_string_node(branch[0]))
             {
@@ -41103,6 +44689,7 @@ namespace exprtk
          #undef basic_opr_switch_statements
          #undef extended_opr_switch_statements
          #undef unary_opr_switch_statements
+         #undef approx_unary_opr_switch_statements
 
          #ifndef exprtk_disable_string_capabilities
 
@@ -41256,6 +44843,16 @@ namespace exprtk
 
             details::free_node(*node_allocator_,branch[1]);
 
+            // Constant like/ilike patterns are compiled once here
+            if (details::e_like == opr)
+               return node_allocator_->
+                        allocate_tt<details::sos_match_node<Type,details::like_op<Type> >,std::string&,const details::wildcard_matcher&>
+                           (s0, details::wildcard_matcher(s1, false));
+            else if (details::e_ilike == opr)
+               return node_allocator_->
+                        allocate_tt<details::sos_match_node<Type,details::ilike_op<Type> >,std::string&,const details::wildcard_matcher&>
+                           (s0, details::wildcard_matcher(s1, true));
+
             return synthesize_sos_expression_impl<std::string&, const std::string>(opr, s0, s1);
          }
 
@@ -41715,142 +45312,686 @@ namespace exprtk
                return branch[0];
             }
 
-            details::free_node(*node_allocator_, branch[0]);
+            details::free_node(*node_allocator_, branch[0]);
+
+            if (
+                 (details::e_lt    == operation) || (details::e_lte  == operation) ||
+                 (details::e_gt    == operation) || (details::e_gte  == operation) ||
+                 (details::e_and   == operation) || (details::e_nand == operation) ||
+                 (details::e_or    == operation) || (details::e_nor  == operation) ||
+                 (details::e_xor   == operation) || (details::e_xnor == operation) ||
+                 (details::e_in    == operation) || (details::e_like == operation) ||
+                 (details::e_ilike == operation)
+               )
+            {
+               return node_allocator_->allocate_c<literal_node_t>(T(0));
+            }
+
+            return node_allocator_->allocate<details::null_node<Type> >();
+         }
+
+         template <typename NodeType, std::size_t N>
+         inline expression_node_ptr synthesize_expression(const details::operator_type& operation, expression_node_ptr (&branch)[N])
+         {
+            if (
+                 (details::e_in    == operation) ||
+                 (details::e_like  == operation) ||
+                 (details::e_ilike == operation)
+               )
+            {
+               free_all_nodes(*node_allocator_,branch);
+
+               return error_node();
+            }
+            else if (!details::all_nodes_valid<N>(branch))
+            {
+               free_all_nodes(*node_allocator_,branch);
+
+               return error_node();
+            }
+            else if ((details::e_default != operation))
+            {
+               // Attempt simple constant folding optimisation.
+               expression_node_ptr expression_point = node_allocator_->allocate<NodeType>(operation,branch);
+
+               if (is_constant_foldable<N>(branch))
+               {
+                  const Type v = expression_point->value();
+                  details::free_node(*node_allocator_,expression_point);
+
+                  return node_allocator_->allocate<literal_node_t>(v);
+               }
+
+               if (expression_point && expression_point->valid())
+               {
+                  return expression_point;
+               }
+
+               parser_->set_error(parser_error::make_error(
+                  parser_error::e_parser,
+                  token_t(),
+                  "ERR281 - Failed to synthesize node: NodeType",
+                  exprtk_error_location));
+
+               details::free_node(*node_allocator_, expression_point);
+            }
+
+            return error_node();
+         }
+
+         template <typename NodeType, std::size_t N>
+         inline expression_node_ptr synthesize_expression(F* f, expression_node_ptr (&branch)[N])
+         {
+            if (!details::all_nodes_valid<N>(branch))
+            {
+               free_all_nodes(*node_allocator_,branch);
+
+               return error_node();
+            }
+
+            typedef typename details::function_N_node<T,ifunction_t,N> function_N_node_t;
+
+            // Attempt simple constant folding optimisation.
+
+            expression_node_ptr expression_point = node_allocator_->allocate<NodeType>(f);
+            function_N_node_t* func_node_ptr = dynamic_cast<function_N_node_t*>(expression_point);
+
+            if (0 == func_node_ptr)
+            {
+               free_all_nodes(*node_allocator_,branch);
+
+               return error_node();
+            }
+            else
+               func_node_ptr->init_branches(branch);
+
+            if (is_constant_foldable<N>(branch) && !f->has_side_effects())
+            {
+               Type v = expression_point->value();
+               details::free_node(*node_allocator_,expression_point);
+
+               return node_allocator_->allocate<literal_node_t>(v);
+            }
+
+            parser_->state_.activate_side_effect("synthesize_expression(function<NT,N>)");
+
+            return expression_point;
+         }
+
+         bool                     strength_reduction_enabled_;
+         details::node_allocator* node_allocator_;
+         synthesize_map_t         synthesize_map_;
+         unary_op_map_t*          unary_op_map_;
+         binary_op_map_t*         binary_op_map_;
+         inv_binary_op_map_t*     inv_binary_op_map_;
+         sf3_map_t*               sf3_map_;
+         sf4_map_t*               sf4_map_;
+         parser_t*                parser_;
+      }; // class expression_generator
+
+      inline void set_error(const parser_error::type& error_type)
+      {
+         error_list_.push_back(error_type);
+      }
+
+      inline void remove_last_error()
+      {
+         if (!error_list_.empty())
+         {
+            error_list_.pop_back();
+         }
+      }
+
+      inline void set_synthesis_error(const std::string& synthesis_error_message)
+      {
+         if (synthesis_error_.empty())
+         {
+            synthesis_error_ = synthesis_error_message;
+         }
+      }
+
+      static inline std::string cse_symbol(const std::string& symbol)
+      {
+         std::string result = symbol;
+         details::case_normalise(result);
+         return result;
+      }
+
+      inline bool cse_key(const std::size_t begin, const std::size_t end,
+                          std::string& key, std::vector<std::string>& symbol_list,
+                          bool& local_symbols)
+      {
+         static const std::size_t max_cse_tokens = 64;
+
+         if ((end <= begin) || ((end - begin) > max_cse_tokens) || (end > lexer().size()))
+            return false;
+
+         // A bracketed group is recorded by way of its inner expression
+         if (
+              (token_t::e_lbracket == lexer()[begin  ].type) &&
+              (token_t::e_rbracket == lexer()[end - 1].type)
+            )
+         {
+            int depth = 0;
+
+            for (std::size_t i = begin; i < end; ++i)
+            {
+               if      (token_t::e_lbracket == lexer()[i].type) ++depth;
+               else if (token_t::e_rbracket == lexer()[i].type) --depth;
+
+               if ((0 == depth) && (i < (end - 1)))
+                  break;
+               else if ((0 == depth) && (i == (end - 1)))
+                  return false;
+            }
+         }
+
+         std::size_t operations    = 0;
+         bool        function_call = false;
+
+         key.clear();
+         symbol_list.clear();
+         local_symbols = false;
+
+         for (std::size_t i = begin; i < end; ++i)
+         {
+            const token_t& token = lexer()[i];
+
+            switch (token.type)
+            {
+               case token_t::e_number   : key += token.value;
+                                          break;
+
+               case token_t::e_symbol   : if (details::is_base_function(token.value))
+                                          {
+                                             if (details::imatch(token.value, "swap"))
+                                                return false;
+
+                                             function_call = true;
+                                          }
+                                          else if (sem_.get_active_element(token.value).active)
+                                          {
+                                             if (scope_element::e_variable != sem_.get_active_element(token.value).type)
+                                                return false;
+
+                                             symbol_list.push_back(cse_symbol(token.value));
+                                             local_symbols = true;
+                                          }
+                                          else if (symtab_store_.is_variable(token.value))
+                                             symbol_list.push_back(cse_symbol(token.value));
+                                          else
+                                             return false;
+
+                                          key += cse_symbol(token.value);
+                                          break;
+
+               case token_t::e_add      :
+               case token_t::e_sub      :
+               case token_t::e_mul      :
+               case token_t::e_div      :
+               case token_t::e_mod      :
+               case token_t::e_pow      :
+               case token_t::e_lt       :
+               case token_t::e_lte      :
+               case token_t::e_eq       :
+               case token_t::e_ne       :
+               case token_t::e_gte      :
+               case token_t::e_gt       : ++operations;
+                                          key += token.value;
+                                          break;
+
+               case token_t::e_lbracket :
+               case token_t::e_rbracket :
+               case token_t::e_comma    : key += token.value;
+                                          break;
+
+               default                  : return false;
+            }
+
+            key += ' ';
+         }
+
+         return !symbol_list.empty() && (function_call || (operations > 1));
+      }
+
+      inline expression_node_ptr cse_reference(cse_scope_node_t* scope, const std::size_t index, expression_node_ptr node)
+      {
+         if (!scope->define(index, node))
+         {
+            free_node(node_allocator_, node);
+         }
+
+         return node_allocator_.allocate_tt<cse_reference_node_t>(scope, index);
+      }
+
+      /*
+         A function from the symbol tables may modify the variables of a
+         shared definition, so the values of the scope are discarded once
+         the call returns.
+      */
+      inline expression_node_ptr cse_barrier(expression_node_ptr call)
+      {
+         if (!cse_.applying || (0 == cse_.scope) || details::is_constant_node(call))
+            return call;
+
+         return node_allocator_.allocate_tt<cse_barrier_node_t>(cse_.scope, call);
+      }
+
+      inline expression_node_ptr cse_process(const std::size_t begin, expression_node_ptr node)
+      {
+         if ((0 == node) || !(cse_.recording || cse_.applying))
+            return node;
+
+         const std::size_t end = current_token_index();
+         const typename cse_context::range_t range(begin, end);
+
+         std::string key;
+         std::vector<std::string> symbol_list;
+         bool local_symbols = false;
+
+         if (!cse_key(begin, end, key, symbol_list, local_symbols))
+            return node;
+
+         if (cse_.recording)
+         {
+            if (!local_symbols && settings_.common_subexpr_elim_enabled())
+            {
+               typename cse_context::range_list_t& range_list = cse_.occurrences[key];
+
+               if (range_list.empty() || (range_list.back() != range))
+               {
+                  range_list.push_back(range);
+               }
+
+               cse_.symbols[key] = symbol_list;
+            }
+
+            if (
+                 settings_.loop_invariant_motion_enabled() &&
+                 (cse_.invariants.empty() || (cse_.invariants.back().range != range))
+               )
+            {
+               typename cse_context::invariant_t invariant;
+               invariant.range   = range;
+               invariant.key     = key;
+               invariant.symbols = symbol_list;
+               invariant.local   = local_symbols;
+
+               cse_.invariants.push_back(invariant);
+            }
+
+            return node;
+         }
+
+         if (details::is_constant_node(node))
+            return node;
+
+         if (!local_symbols)
+         {
+            const typename cse_context::plan_t::const_iterator itr = cse_.plan.find(key);
+
+            if (cse_.plan.end() != itr)
+            {
+               exprtk_debug(("cse_process() - shared: %s\n", key.c_str()));
+
+               return cse_reference(cse_.scope, itr->second, node);
+            }
+         }
+
+         const typename cse_context::invariant_plan_t::const_iterator itr = cse_.invariant_plan.find(range);
+
+         if (cse_.invariant_plan.end() != itr)
+         {
+            const typename cse_context::loop_scope_map_t::const_iterator scope_itr =
+               cse_.loop_scopes.find(itr->second.first);
+
+            if (cse_.loop_scopes.end() != scope_itr)
+            {
+               exprtk_debug(("cse_process() - loop invariant: %s\n", key.c_str()));
+
+               return cse_reference(scope_itr->second, itr->second.second, node);
+            }
+         }
+
+         return node;
+      }
+
+      inline std::size_t licm_enter_loop()
+      {
+         const std::size_t loop_begin = current_token_index();
+
+         if (cse_.applying)
+         {
+            const std::map<std::size_t,std::size_t>::const_iterator itr = cse_.loop_slots.find(loop_begin);
+
+            if (cse_.loop_slots.end() != itr)
+            {
+               cse_.loop_scopes[loop_begin] = static_cast<cse_scope_node_t*>(
+                  node_allocator_.allocate_c<cse_scope_node_t>(itr->second));
+            }
+         }
+
+         return loop_begin;
+      }
+
+      inline expression_node_ptr licm_exit_loop(const std::size_t loop_begin, expression_node_ptr loop)
+      {
+         if (cse_.recording)
+         {
+            if (loop && settings_.loop_invariant_motion_enabled())
+            {
+               cse_.loops.push_back(typename cse_context::range_t(loop_begin, current_token_index()));
+            }
+
+            return loop;
+         }
+
+         const typename cse_context::loop_scope_map_t::iterator itr = cse_.loop_scopes.find(loop_begin);
+
+         if (cse_.loop_scopes.end() == itr)
+            return loop;
+
+         cse_scope_node_t* scope = itr->second;
+
+         cse_.loop_scopes.erase(itr);
+
+         if (0 == loop)
+         {
+            expression_node_ptr scope_node = scope;
+            destroy_node(scope_node);
+
+            return error_node();
+         }
+
+         scope->set_body(loop);
+
+         return scope;
+      }
+
+      inline void cse_collect_mutable_symbols(const std::size_t begin, const std::size_t end,
+                                              std::set<std::string>& mutable_symbols)
+      {
+         for (std::size_t i = begin; i < end; ++i)
+         {
+            const token_t& token = lexer()[i];
+
+            if (token_t::e_symbol != token.type)
+               continue;
+
+            const token_t::token_type next_type = ((i + 1) < lexer().size()) ?
+                                                  lexer()[i + 1].type : token_t::e_eof;
+
+            switch (next_type)
+            {
+               case token_t::e_assign :
+               case token_t::e_addass :
+               case token_t::e_subass :
+               case token_t::e_mulass :
+               case token_t::e_divass :
+               case token_t::e_modass :
+               case token_t::e_swap   : mutable_symbols.insert(cse_symbol(token.value));
+                                        continue;
+               default                : break;
+            }
+
+            if ((i > 0) && (token_t::e_swap == lexer()[i - 1].type))
+            {
+               mutable_symbols.insert(cse_symbol(token.value));
+            }
+            else if (details::imatch(token.value, "var") && (token_t::e_symbol == next_type))
+            {
+               mutable_symbols.insert(cse_symbol(lexer()[i + 1].value));
+            }
+            else if (
+                      (token_t::e_lbracket == next_type) &&
+                      (
+                        details::imatch(token.value, "swap") ||
+                        (0 != symtab_store_.get_generic_function(token.value))
+                      )
+                    )
+            {
+               // Arguments of generic functions may be modified by the callee
+               int depth = 0;
+
+               for (std::size_t j = i + 1; j < lexer().size(); ++j)
+               {
+                  const token_t& arg = lexer()[j];
+
+                  if      (token_t::e_lbracket == arg.type) ++depth;
+                  else if (token_t::e_rbracket == arg.type) --depth;
+                  else if (token_t::e_symbol   == arg.type)
+                     mutable_symbols.insert(cse_symbol(arg.value));
+
+                  if (0 == depth)
+                     break;
+               }
+            }
+         }
+      }
+
+      inline void cse_collect_calls(const std::size_t begin, const std::size_t end,
+                                    bool& scalar_call, bool& string_call)
+      {
+         for (std::size_t i = begin; i < end; ++i)
+         {
+            const token_t& token = lexer()[i];
+
+            if (token_t::e_symbol != token.type)
+               continue;
+            else if (
+                      symtab_store_.get_function        (token.value) ||
+                      symtab_store_.get_vararg_function (token.value) ||
+                      symtab_store_.get_generic_function(token.value)
+                    )
+               scalar_call = true;
+            else if (
+                      symtab_store_.get_string_function  (token.value) ||
+                      symtab_store_.get_overload_function(token.value)
+                    )
+               string_call = true;
+         }
+      }
+
+      inline bool cse_build_plan()
+      {
+         typedef typename cse_context::occurrence_map_t::const_iterator occ_itr_t;
+         typedef typename cse_context::range_list_t range_list_t;
+
+         std::set<std::string> mutable_symbols;
+         cse_collect_mutable_symbols(0, lexer().size(), mutable_symbols);
+
+         bool scalar_call = false;
+         bool string_call = false;
+         cse_collect_calls(0, lexer().size(), scalar_call, string_call);
+
+         std::vector<occ_itr_t> candidates;
+
+         /*
+            Calls returning scalars are wrapped in barriers that discard
+            the shared values, those that may return strings cannot be,
+            in which case nothing is shared.
+         */
+         for (occ_itr_t itr = cse_.occurrences.begin(); !string_call && (itr != cse_.occurrences.end()); ++itr)
+         {
+            if (itr->second.size() < 2)
+               continue;
+
+            const std::vector<std::string>& symbol_list = cse_.symbols[itr->first];
 
-            if (
-                 (details::e_lt    == operation) || (details::e_lte  == operation) ||
-                 (details::e_gt    == operation) || (details::e_gte  == operation) ||
-                 (details::e_and   == operation) || (details::e_nand == operation) ||
-                 (details::e_or    == operation) || (details::e_nor  == operation) ||
-                 (details::e_xor   == operation) || (details::e_xnor == operation) ||
-                 (details::e_in    == operation) || (details::e_like == operation) ||
-                 (details::e_ilike == operation)
-               )
+            bool pure = true;
+
+            for (std::size_t i = 0; pure && (i < symbol_list.size()); ++i)
             {
-               return node_allocator_->allocate_c<literal_node_t>(T(0));
+               pure = (mutable_symbols.end() == mutable_symbols.find(symbol_list[i]));
             }
 
-            return node_allocator_->allocate<details::null_node<Type> >();
+            if (pure)
+            {
+               candidates.push_back(itr);
+            }
          }
 
-         template <typename NodeType, std::size_t N>
-         inline expression_node_ptr synthesize_expression(const details::operator_type& operation, expression_node_ptr (&branch)[N])
+         cse_.plan.clear();
+
+         // Skip subexpressions that only ever occur within other candidates
+         for (std::size_t c = 0; c < candidates.size(); ++c)
          {
-            if (
-                 (details::e_in    == operation) ||
-                 (details::e_like  == operation) ||
-                 (details::e_ilike == operation)
-               )
-            {
-               free_all_nodes(*node_allocator_,branch);
+            const range_list_t& range_list = candidates[c]->second;
 
-               return error_node();
-            }
-            else if (!details::all_nodes_valid<N>(branch))
-            {
-               free_all_nodes(*node_allocator_,branch);
+            bool enclosed = true;
 
-               return error_node();
-            }
-            else if ((details::e_default != operation))
+            for (std::size_t r = 0; enclosed && (r < range_list.size()); ++r)
             {
-               // Attempt simple constant folding optimisation.
-               expression_node_ptr expression_point = node_allocator_->allocate<NodeType>(operation,branch);
+               bool inside = false;
 
-               if (is_constant_foldable<N>(branch))
+               for (std::size_t o = 0; !inside && (o < candidates.size()); ++o)
                {
-                  const Type v = expression_point->value();
-                  details::free_node(*node_allocator_,expression_point);
+                  if (o == c)
+                     continue;
 
-                  return node_allocator_->allocate<literal_node_t>(v);
-               }
+                  const range_list_t& outer_list = candidates[o]->second;
 
-               if (expression_point && expression_point->valid())
-               {
-                  return expression_point;
+                  for (std::size_t k = 0; !inside && (k < outer_list.size()); ++k)
+                  {
+                     inside = (outer_list[k].first  <= range_list[r].first ) &&
+                              (range_list[r].second <= outer_list[k].second) &&
+                              (outer_list[k]        != range_list[r]       );
+                  }
                }
 
-               parser_->set_error(parser_error::make_error(
-                  parser_error::e_parser,
-                  token_t(),
-                  "ERR281 - Failed to synthesize node: NodeType",
-                  exprtk_error_location));
-
-               details::free_node(*node_allocator_, expression_point);
+               enclosed = inside;
             }
 
-            return error_node();
+            if (!enclosed)
+            {
+               const std::size_t index = cse_.plan.size();
+               cse_.plan[candidates[c]->first] = index;
+            }
          }
 
-         template <typename NodeType, std::size_t N>
-         inline expression_node_ptr synthesize_expression(F* f, expression_node_ptr (&branch)[N])
+         licm_build_plan();
+
+         return !cse_.plan.empty() || !cse_.invariant_plan.empty();
+      }
+
+      inline void licm_build_plan()
+      {
+         typedef typename cse_context::range_t range_t;
+         typedef typename cse_context::invariant_t invariant_t;
+
+         cse_.invariant_plan.clear();
+         cse_.loop_slots    .clear();
+
+         if (cse_.loops.empty())
+            return;
+
+         // Enclosing loops precede the loops nested within them
+         std::sort(cse_.loops.begin(), cse_.loops.end());
+
+         std::vector<std::set<std::string> > loop_mutable_symbols(cse_.loops.size());
+         std::vector<bool> loop_impure(cse_.loops.size(), false);
+
+         for (std::size_t l = 0; l < cse_.loops.size(); ++l)
          {
-            if (!details::all_nodes_valid<N>(branch))
-            {
-               free_all_nodes(*node_allocator_,branch);
+            cse_collect_mutable_symbols(cse_.loops[l].first, cse_.loops[l].second, loop_mutable_symbols[l]);
 
-               return error_node();
-            }
+            // Nothing is hoisted out of a loop that calls a function not known to be pure
+            bool scalar_call = false;
+            bool string_call = false;
+            cse_collect_calls(cse_.loops[l].first, cse_.loops[l].second, scalar_call, string_call);
 
-            typedef typename details::function_N_node<T,ifunction_t,N> function_N_node_t;
+            loop_impure[l] = scalar_call || string_call;
+         }
 
-            // Attempt simple constant folding optimisation.
+         // Assign each invariant to the outermost loop it is invariant in
+         std::vector<std::pair<std::size_t,std::size_t> > selection;
 
-            expression_node_ptr expression_point = node_allocator_->allocate<NodeType>(f);
-            function_N_node_t* func_node_ptr = dynamic_cast<function_N_node_t*>(expression_point);
+         for (std::size_t i = 0; i < cse_.invariants.size(); ++i)
+         {
+            const invariant_t& invariant = cse_.invariants[i];
 
-            if (0 == func_node_ptr)
+            if (!invariant.local && (cse_.plan.end() != cse_.plan.find(invariant.key)))
+               continue;
+
+            for (std::size_t l = 0; l < cse_.loops.size(); ++l)
             {
-               free_all_nodes(*node_allocator_,branch);
+               const range_t& loop = cse_.loops[l];
 
-               return error_node();
+               if (
+                    loop_impure[l] ||
+                    (invariant.range.first <= loop.first) ||
+                    (loop.second < invariant.range.second)
+                  )
+                  continue;
+
+               bool invariant_in_loop = true;
+
+               for (std::size_t j = 0; invariant_in_loop && (j < invariant.symbols.size()); ++j)
+               {
+                  invariant_in_loop = (loop_mutable_symbols[l].end() == loop_mutable_symbols[l].find(invariant.symbols[j]));
+               }
+
+               if (invariant_in_loop)
+               {
+                  selection.push_back(std::make_pair(i,l));
+                  break;
+               }
             }
-            else
-               func_node_ptr->init_branches(branch);
+         }
 
-            if (is_constant_foldable<N>(branch) && !f->has_side_effects())
+         // Within a loop, only the largest invariant subexpressions are hoisted
+         for (std::size_t i = 0; i < selection.size(); ++i)
+         {
+            const range_t& range = cse_.invariants[selection[i].first].range;
+
+            bool enclosed = false;
+
+            for (std::size_t j = 0; !enclosed && (j < selection.size()); ++j)
             {
-               Type v = expression_point->value();
-               details::free_node(*node_allocator_,expression_point);
+               const range_t& outer = cse_.invariants[selection[j].first].range;
 
-               return node_allocator_->allocate<literal_node_t>(v);
+               enclosed = (i != j)                           &&
+                          (selection[i].second == selection[j].second) &&
+                          (outer.first  <= range.first )     &&
+                          (range.second <= outer.second)     &&
+                          (outer        != range       );
             }
 
-            parser_->state_.activate_side_effect("synthesize_expression(function<NT,N>)");
+            if (!enclosed)
+            {
+               const std::size_t loop_begin = cse_.loops[selection[i].second].first;
 
-            return expression_point;
+               cse_.invariant_plan[range] = std::make_pair(loop_begin, cse_.loop_slots[loop_begin]++);
+            }
          }
-
-         bool                     strength_reduction_enabled_;
-         details::node_allocator* node_allocator_;
-         synthesize_map_t         synthesize_map_;
-         unary_op_map_t*          unary_op_map_;
-         binary_op_map_t*         binary_op_map_;
-         inv_binary_op_map_t*     inv_binary_op_map_;
-         sf3_map_t*               sf3_map_;
-         sf4_map_t*               sf4_map_;
-         parser_t*                parser_;
-      }; // class expression_generator
-
-      inline void set_error(const parser_error::type& error_type)
-      {
-         error_list_.push_back(error_type);
       }
 
-      inline void remove_last_error()
+      inline void register_literal_parameters(expression<T>& e)
       {
-         if (!error_list_.empty())
+         typename literal_parameter_map_t::iterator itr = literal_parameter_map_.begin();
+
+         for ( ; literal_parameter_map_.end() != itr; ++itr)
          {
-            error_list_.pop_back();
+            e.register_local_var (itr->second.node   );
+            e.register_local_data(itr->second.data, 1, 0);
+            e.register_parameter (itr->first, itr->second.data);
          }
+
+         // Ownership now rests with the expression
+         literal_parameter_map_.clear();
       }
 
-      inline void set_synthesis_error(const std::string& synthesis_error_message)
+      inline void literal_parameter_cleanup()
       {
-         if (synthesis_error_.empty())
+         typename literal_parameter_map_t::iterator itr = literal_parameter_map_.begin();
+
+         for ( ; literal_parameter_map_.end() != itr; ++itr)
          {
-            synthesis_error_ = synthesis_error_message;
+            delete itr->second.node;
+            delete itr->second.data;
          }
+
+         literal_parameter_map_.clear();
       }
 
       inline void register_local_vars(expression<T>& e)
@@ -41903,6 +46044,13 @@ namespace exprtk
                }
             }
             #endif
+            else if (scope_element::e_bitvector == se.type)
+            {
+               if (se.data)
+               {
+                  e.register_local_data(se.data, 0, 3);
+               }
+            }
 
             se.var_node  = 0;
             se.vec_node  = 0;
@@ -42154,6 +46302,8 @@ namespace exprtk
       sf4_map_t sf4_map_;
       std::string synthesis_error_;
       scope_element_manager sem_;
+      cse_context cse_;
+      literal_parameter_map_t literal_parameter_map_;
       std::vector<state_t> current_state_stack_;
 
       immutable_memory_map_t immutable_memory_map_;
@@ -42382,28 +46532,635 @@ namespace exprtk
       return true;
    }
 
+   /*
+      Lists the variables, vectors, strings and functions an expression
+      depends on from its tokens alone, without compiling it. Symbols
+      defined by var statements are local and are not listed. They are
+      visible to the end of the enclosing block, and a for loop's own
+      variables to the end of the block containing the loop. Calls to the
+      built-in functions are listed with the functions. The kind of
+      a symbol comes from the registered symbol tables when they hold
+      it, otherwise from its use: a call is a function, a range s[r0:r1]
+      or an operand next to a string literal is a string, an index v[i]
+      is a vector, and anything else is a variable. The expression is
+      only checked for lexical errors and mismatched brackets.
+   */
+   template <typename T>
+   class dependency_extractor
+   {
+   public:
+
+      typedef exprtk::symbol_table<T> symbol_table_t;
+      typedef std::vector<std::string> symbol_list_t;
+
+      struct dependencies
+      {
+         inline void clear()
+         {
+            variable_list.clear();
+            vector_list  .clear();
+            string_list  .clear();
+            function_list.clear();
+         }
+
+         symbol_list_t variable_list;
+         symbol_list_t vector_list;
+         symbol_list_t string_list;
+         symbol_list_t function_list;
+      };
+
+      dependency_extractor()
+      : operator_joiner_2_(2)
+      , operator_joiner_3_(3)
+      {
+         for (std::size_t i = 0; i < details::reserved_symbols_size; ++i)
+         {
+            reserved_set_.insert(details::reserved_symbols[i]);
+         }
+
+         for (std::size_t i = 0; i < details::base_function_list_size; ++i)
+         {
+            base_function_set_.insert(details::base_function_list[i]);
+         }
+
+         helper_assembly_.register_joiner (&operator_joiner_2_);
+         helper_assembly_.register_joiner (&operator_joiner_3_);
+         helper_assembly_.register_scanner(&bracket_checker_  );
+      }
+
+      inline bool register_symbol_table(symbol_table_t& symbol_table)
+      {
+         for (std::size_t i = 0; i < symtab_list_.size(); ++i)
+         {
+            if (symbol_table == symtab_list_[i])
+               return false;
+         }
+
+         symtab_list_.push_back(symbol_table);
+
+         return true;
+      }
+
+      inline bool extract(const std::string& expression_string, dependencies& result)
+      {
+         result.clear();
+         error_.clear();
+         symbol_map_  .clear();
+         local_map_   .clear();
+         scope_list_  .clear();
+         pending_list_.clear();
+
+         if (!lexer_.process(expression_string))
+         {
+            error_ = "Invalid token at position " + details::to_str(static_cast<int>(error_position()));
+            return false;
+         }
+
+         if (!helper_assembly_.run_pipeline(lexer_))
+         {
+            error_ = "Mismatched brackets: '" + bracket_checker_.error_token().value + "' at position " +
+                     details::to_str(static_cast<int>(bracket_checker_.error_token().position));
+            return false;
+         }
+
+         scope_list_.push_back(scope_t());
+
+         for (std::size_t i = 0; i < lexer_.size(); ++i)
+         {
+            process_token(i);
+         }
+
+         for (typename symbol_map_t::const_iterator itr = symbol_map_.begin(); itr != symbol_map_.end(); ++itr)
+         {
+            switch (resolve(itr->first, itr->second))
+            {
+               case e_function : result.function_list.push_back(itr->first); break;
+               case e_string   : result.string_list  .push_back(itr->first); break;
+               case e_vector   : result.vector_list  .push_back(itr->first); break;
+               default         : result.variable_list.push_back(itr->first); break;
+            }
+         }
+
+         return true;
+      }
+
+      inline std::string error() const
+      {
+         return error_;
+      }
+
+   private:
+
+      typedef lexer::token token_t;
+
+      enum usage_mode
+      {
+         e_variable = 0,
+         e_vector   = 1,
+         e_string   = 2,
+         e_function = 4
+      };
+
+      typedef std::map<std::string, int, details::ilesscompare> symbol_map_t;
+      typedef std::map<std::string, std::size_t, details::ilesscompare> local_map_t;
+
+      struct scope_t
+      {
+         scope_t()
+         : depth(0)
+         {}
+
+         std::vector<std::string> local_list;
+         std::size_t depth;
+      };
+
+      // A var definition, local once its statement ends
+      struct pending_t
+      {
+         std::string name;
+         std::size_t scope;
+         std::size_t depth;
+      };
+
+      inline std::size_t error_position() const
+      {
+         for (std::size_t i = 0; i < lexer_.size(); ++i)
+         {
+            if (lexer_[i].is_error())
+               return lexer_[i].position;
+         }
+
+         return 0;
+      }
+
+      inline const token_t* token_at(const std::size_t index)
+      {
+         return (index < lexer_.size()) ? &lexer_[index] : reinterpret_cast<const token_t*>(0);
+      }
+
+      inline void process_token(const std::size_t index)
+      {
+         const token_t& t = lexer_[index];
+
+         switch (t.type)
+         {
+            case token_t::e_lbracket    :
+            case token_t::e_lsqrbracket : ++scope_list_.back().depth;
+                                          return;
+
+            case token_t::e_rbracket    :
+            case token_t::e_rsqrbracket : if (scope_list_.back().depth)
+                                             --scope_list_.back().depth;
+                                          activate_pending(scope_list_.back().depth + 1);
+                                          return;
+
+            case token_t::e_lcrlbracket : scope_list_.push_back(scope_t());
+                                          return;
+
+            case token_t::e_rcrlbracket : close_scope();
+                                          return;
+
+            // The statement separator ';'
+            case token_t::e_eof         : activate_pending(scope_list_.back().depth);
+                                          return;
+
+            case token_t::e_symbol      : break;
+
+            default                     : return;
+         }
+
+         if (t.value.empty() || ('$' == t.value[0]) || ('[' == t.value[0]))
+            return;
+
+         const token_t* prev = (index > 0) ? &lexer_[index - 1] : reinterpret_cast<const token_t*>(0);
+
+         if (prev && (token_t::e_symbol == prev->type) && details::imatch(prev->value, "var"))
+         {
+            pending_t pending;
+            pending.name  = t.value;
+            pending.scope = scope_list_.size() - 1;
+            pending.depth = scope_list_.back().depth;
+            pending_list_.push_back(pending);
+            return;
+         }
+
+         const token_t* next = token_at(index + 1);
+
+         // Calls to the built-in functions are listed, the other reserved symbols are not
+         if (reserved_set_.end() != reserved_set_.find(t.value))
+         {
+            if (
+                 next && (token_t::e_lbracket == next->type) &&
+                 (base_function_set_.end() != base_function_set_.find(t.value))
+               )
+            {
+               symbol_map_[t.value] |= e_function;
+            }
+
+            return;
+         }
+
+         if (local_map_.end() != local_map_.find(t.value))
+            return;
+
+         int& usage = symbol_map_[t.value];
+
+         if (next && (token_t::e_lbracket == next->type))
+         {
+            usage |= e_function;
+         }
+         else if (next && (token_t::e_lsqrbracket == next->type))
+         {
+            usage |= is_range(index + 1) ? e_string : e_vector;
+         }
+
+         if (
+              (prev && (index > 1) && string_operator(*prev) && (token_t::e_string == lexer_[index - 2].type)) ||
+              (next && string_operator(*next) && token_at(index + 2) && (token_t::e_string == lexer_[index + 2].type))
+            )
+         {
+            usage |= e_string;
+         }
+      }
+
+      // Whether the square brackets opened at index hold a range r0:r1
+      inline bool is_range(const std::size_t index) const
+      {
+         std::size_t depth = 0;
+
+         for (std::size_t i = index; i < lexer_.size(); ++i)
+         {
+            switch (lexer_[i].type)
+            {
+               case token_t::e_lbracket    :
+               case token_t::e_lsqrbracket :
+               case token_t::e_lcrlbracket : ++depth;
+                                             break;
+
+               case token_t::e_rbracket    :
+               case token_t::e_rsqrbracket :
+               case token_t::e_rcrlbracket : if (0 == --depth)
+                                                return false;
+                                             break;
+
+               case token_t::e_colon       : if (1 == depth)
+                                                return true;
+                                             break;
+
+               default                     : break;
+            }
+         }
+
+         return false;
+      }
+
+      inline bool string_operator(const token_t& t) const
+      {
+         switch (t.type)
+         {
+            case token_t::e_add    :
+            case token_t::e_assign :
+            case token_t::e_addass :
+            case token_t::e_eq     :
+            case token_t::e_ne     :
+            case token_t::e_lt     :
+            case token_t::e_lte    :
+            case token_t::e_gt     :
+            case token_t::e_gte    : return true;
+
+            case token_t::e_symbol : return details::imatch(t.value, "like" ) ||
+                                            details::imatch(t.value, "ilike") ||
+                                            details::imatch(t.value, "in"   ) ;
+
+            default                : return false;
+         }
+      }
+
+      // Makes the pending definitions of the current scope at or below depth local
+      inline void activate_pending(const std::size_t depth)
+      {
+         const std::size_t scope = scope_list_.size() - 1;
+
+         while (
+                 !pending_list_.empty() &&
+                 (pending_list_.back().scope == scope) &&
+                 (pending_list_.back().depth >= depth)
+               )
+         {
+            const std::string& name = pending_list_.back().name;
+
+            ++local_map_[name];
+            scope_list_.back().local_list.push_back(name);
+
+            pending_list_.pop_back();
+         }
+      }
+
+      inline void close_scope()
+      {
+         activate_pending(0);
+
+         if (scope_list_.size() < 2)
+            return;
+
+         const std::vector<std::string>& local_list = scope_list_.back().local_list;
+
+         for (std::size_t i = 0; i < local_list.size(); ++i)
+         {
+            const typename local_map_t::iterator itr = local_map_.find(local_list[i]);
+
+            if ((local_map_.end() != itr) && (0 == --itr->second))
+            {
+               local_map_.erase(itr);
+            }
+         }
+
+         scope_list_.pop_back();
+      }
+
+      inline usage_mode resolve(const std::string& name, const int usage) const
+      {
+         for (std::size_t i = 0; i < symtab_list_.size(); ++i)
+         {
+            const symbol_table_t& symbol_table = symtab_list_[i];
+
+            if (symbol_table.is_variable(name))
+               return e_variable;
+            else if (symbol_table.is_vector(name))
+               return e_vector;
+            #ifndef exprtk_disable_string_capabilities
+            else if (symbol_table.is_stringvar(name))
+               return e_string;
+            #endif
+            else if (
+                      symbol_table.is_function       (name) ||
+                      symbol_table.is_vararg_function(name) ||
+                      symbol_table.get_generic_function (name) ||
+                      symbol_table.get_string_function  (name) ||
+                      symbol_table.get_overload_function(name)
+                    )
+               return e_function;
+         }
+
+         if (usage & e_function)
+            return e_function;
+         else if (usage & e_string)
+            return e_string;
+         else if (usage & e_vector)
+            return e_vector;
+         else
+            return e_variable;
+      }
+
+      lexer::generator                  lexer_;
+      lexer::helper::helper_assembly    helper_assembly_;
+      lexer::helper::operator_joiner    operator_joiner_2_;
+      lexer::helper::operator_joiner    operator_joiner_3_;
+      lexer::helper::bracket_checker    bracket_checker_;
+      std::set<std::string,details::ilesscompare> reserved_set_;
+      std::set<std::string,details::ilesscompare> base_function_set_;
+      std::vector<symbol_table_t>       symtab_list_;
+      symbol_map_t                      symbol_map_;
+      local_map_t                       local_map_;
+      std::vector<scope_t>              scope_list_;
+      std::vector<pending_t>            pending_list_;
+      std::string                       error_;
+   };
+
+   namespace details
+   {
+      /*
+         Composite Simpson's rule in a single pass over the 2n + 1
+         sample points, each evaluated once. The even samples also
+         form the rule at twice the step, from which the Richardson
+         estimate of the error, (fine - coarse) / 15, is derived. The
+         coarse rule needs an even number of intervals, so when an
+         estimate is requested an odd n is rounded up to the next even.
+      */
+      template <typename T>
+      inline T simpson_integrate(const expression<T>& e,
+                                 T& x,
+                                 const T& r0, const T& r1,
+                                 const std::size_t number_of_intervals,
+                                 T* error_estimate)
+      {
+         std::size_t n = std::max<std::size_t>(number_of_intervals, 1);
+
+         if (error_estimate && (n & 1))
+         {
+            ++n;
+         }
+
+         const std::size_t samples = 2 * n;
+         const T h = (r1 - r0) / T(samples);
+
+         T fine   = T(0);
+         T coarse = T(0);
+
+         for (std::size_t k = 0; k <= samples; ++k)
+         {
+            x = r0 + T(k) * h;
+            const T y = e.value();
+
+            if ((0 == k) || (samples == k))
+            {
+               fine   += y;
+               coarse += y;
+            }
+            else if (k & 1)
+               fine += T(4) * y;
+            else
+            {
+               fine   += T(2) * y;
+               coarse += ((k & 2) ? T(4) : T(2)) * y;
+            }
+         }
+
+         fine *= h / T(3);
+
+         if (error_estimate)
+         {
+            coarse *= (T(2) * h) / T(3);
+            (*error_estimate) = details::numeric::abs(fine - coarse) / T(15);
+         }
+
+         return fine;
+      }
+
+      // 15-point Kronrod rule with its embedded 7-point Gauss rule
+      template <typename T>
+      inline T gauss_kronrod_15(const expression<T>& e,
+                                T& x,
+                                const T& r0, const T& r1,
+                                T& error_estimate)
+      {
+         static const double xgk[8] =
+            {
+              0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+              0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+              0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+              0.207784955007898467600689403773245, 0.000000000000000000000000000000000
+            };
+
+         static const double wgk[8] =
+            {
+              0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+              0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+              0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+              0.204432940075298892414161999234649, 0.209482141084727828012999174891714
+            };
+
+         static const double wg[4] =
+            {
+              0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+              0.381830050505118944950369775488975, 0.417959183673469387755102040816327
+            };
+
+         const T centre      = (r0 + r1) / T(2);
+         const T half_length = (r1 - r0) / T(2);
+
+         x = centre;
+         const T fc = e.value();
+
+         T kronrod = fc * T(wgk[7]);
+         T gauss   = fc * T(wg [3]);
+
+         for (std::size_t j = 0; j < 7; ++j)
+         {
+            const T dx = half_length * T(xgk[j]);
+
+            x = centre - dx;
+            const T f0 = e.value();
+            x = centre + dx;
+            const T f1 = e.value();
+
+            kronrod += T(wgk[j]) * (f0 + f1);
+
+            if (j & 1)
+               gauss += T(wg[j / 2]) * (f0 + f1);
+         }
+
+         error_estimate = details::numeric::abs((kronrod - gauss) * half_length);
+
+         return kronrod * half_length;
+      }
+
+      template <typename T>
+      struct integration_interval
+      {
+         T r0;
+         T r1;
+         T area;
+         T error;
+
+         bool operator<(const integration_interval<T>& interval) const
+         {
+            return error < interval.error;
+         }
+      };
+   }
+
+   template <typename T>
+   inline T integrate(const expression<T>& e,
+                      T& x,
+                      const T& r0, const T& r1,
+                      const std::size_t number_of_intervals = 1000000)
+   {
+      if (r0 > r1)
+         return T(0);
+
+      return details::simpson_integrate(e, x, r0, r1, number_of_intervals, reinterpret_cast<T*>(0));
+   }
+
    template <typename T>
    inline T integrate(const expression<T>& e,
                       T& x,
                       const T& r0, const T& r1,
+                      T& error_estimate,
                       const std::size_t number_of_intervals = 1000000)
    {
+      error_estimate = T(0);
+
+      if (r0 > r1)
+         return T(0);
+
+      return details::simpson_integrate(e, x, r0, r1, number_of_intervals, &error_estimate);
+   }
+
+   /*
+      Globally adaptive Gauss-Kronrod quadrature: the interval with the
+      largest error estimate is bisected until the total estimate is at
+      most tolerance * max(1,|area|), or max_intervals is reached. The
+      error_estimate is set in either case, so callers can check it.
+   */
+   template <typename T>
+   inline T integrate_adaptive(const expression<T>& e,
+                               T& x,
+                               const T& r0, const T& r1,
+                               T& error_estimate,
+                               const T& tolerance = T(1e-10),
+                               const std::size_t max_intervals = 1000)
+   {
+      typedef details::integration_interval<T> interval_t;
+
+      error_estimate = T(0);
+
       if (r0 > r1)
          return T(0);
 
-      const T h = (r1 - r0) / (T(2) * number_of_intervals);
-      T total_area = T(0);
+      std::vector<interval_t> heap(1);
+
+      heap[0].r0   = r0;
+      heap[0].r1   = r1;
+      heap[0].area = details::gauss_kronrod_15(e, x, r0, r1, heap[0].error);
+
+      T area  = heap[0].area;
+      T error = heap[0].error;
+
+      while (
+              (error > tolerance * std::max(T(1), details::numeric::abs(area))) &&
+              (heap.size() < max_intervals)
+            )
+      {
+         std::pop_heap(heap.begin(), heap.end());
+
+         const interval_t worst = heap.back();
+         const T middle = (worst.r0 + worst.r1) / T(2);
+
+         interval_t lower;
+         interval_t upper;
+
+         lower.r0   = worst.r0;
+         lower.r1   = middle;
+         lower.area = details::gauss_kronrod_15(e, x, lower.r0, lower.r1, lower.error);
+
+         upper.r0   = middle;
+         upper.r1   = worst.r1;
+         upper.area = details::gauss_kronrod_15(e, x, upper.r0, upper.r1, upper.error);
+
+         area  += (lower.area  + upper.area ) - worst.area;
+         error += (lower.error + upper.error) - worst.error;
+
+         heap.back() = lower;
+         std::push_heap(heap.begin(), heap.end());
+
+         heap.push_back(upper);
+         std::push_heap(heap.begin(), heap.end());
+      }
+
+      // Resum to drop the drift of the running totals
+      area  = T(0);
+      error = T(0);
 
-      for (std::size_t i = 0; i < number_of_intervals; ++i)
+      for (std::size_t i = 0; i < heap.size(); ++i)
       {
-         x = r0 + T(2) * i * h;
-         const T y0 = e.value(); x += h;
-         const T y1 = e.value(); x += h;
-         const T y2 = e.value(); x += h;
-         total_area += h * (y0 + T(4) * y1 + y2) / T(3);
+         area  += heap[i].area;
+         error += heap[i].error;
       }
 
-      return total_area;
+      error_estimate = error;
+
+      return area;
    }
 
    template <typename T>
@@ -42434,6 +47191,65 @@ namespace exprtk
       return std::numeric_limits<T>::quiet_NaN();
    }
 
+   template <typename T>
+   inline T integrate(const expression<T>& e,
+                      const std::string& variable_name,
+                      const T& r0, const T& r1,
+                      T& error_estimate,
+                      const std::size_t number_of_intervals = 1000000)
+   {
+      const symbol_table<T>& sym_table = e.get_symbol_table();
+
+      if (!sym_table.valid())
+      {
+         return std::numeric_limits<T>::quiet_NaN();
+      }
+
+      details::variable_node<T>* var = sym_table.get_variable(variable_name);
+
+      if (var)
+      {
+         T& x = var->ref();
+         const T x_original = x;
+         const T result = integrate(e, x, r0, r1, error_estimate, number_of_intervals);
+         x = x_original;
+
+         return result;
+      }
+
+      return std::numeric_limits<T>::quiet_NaN();
+   }
+
+   template <typename T>
+   inline T integrate_adaptive(const expression<T>& e,
+                               const std::string& variable_name,
+                               const T& r0, const T& r1,
+                               T& error_estimate,
+                               const T& tolerance = T(1e-10),
+                               const std::size_t max_intervals = 1000)
+   {
+      const symbol_table<T>& sym_table = e.get_symbol_table();
+
+      if (!sym_table.valid())
+      {
+         return std::numeric_limits<T>::quiet_NaN();
+      }
+
+      details::variable_node<T>* var = sym_table.get_variable(variable_name);
+
+      if (var)
+      {
+         T& x = var->ref();
+         const T x_original = x;
+         const T result = integrate_adaptive(e, x, r0, r1, error_estimate, tolerance, max_intervals);
+         x = x_original;
+
+         return result;
+      }
+
+      return std::numeric_limits<T>::quiet_NaN();
+   }
+
    template <typename T>
    inline T derivative(const expression<T>& e,
                        T& x,
@@ -42498,6 +47314,116 @@ namespace exprtk
       return (y0 + T(2) * (y2 - y1) - y3) / (T(2) * h * h * h);
    }
 
+   /*
+      Batch forms of the derivatives: one pass over the points, with
+      x restored on return. The error_list, when given, receives the
+      difference between the five-point result and the three-point
+      central difference of the same samples, which estimates the error
+      of the latter and so over-estimates that of the former.
+   */
+   template <typename T>
+   inline void derivative(const expression<T>& e,
+                          T& x,
+                          const std::vector<T>& x_list,
+                          std::vector<T>& result_list,
+                          const T& h = T(0.00000001),
+                          std::vector<T>* error_list = 0)
+   {
+      const T x_init = x;
+      const T _2h    = T(2) * h;
+
+      result_list.resize(x_list.size());
+
+      if (error_list)
+         error_list->resize(x_list.size());
+
+      for (std::size_t i = 0; i < x_list.size(); ++i)
+      {
+         x = x_list[i] + _2h;
+         const T y0 = e.value();
+         x = x_list[i] + h;
+         const T y1 = e.value();
+         x = x_list[i] - h;
+         const T y2 = e.value();
+         x = x_list[i] - _2h;
+         const T y3 = e.value();
+
+         result_list[i] = (-y0 + T(8) * (y1 - y2) + y3) / (T(12) * h);
+
+         if (error_list)
+            (*error_list)[i] = details::numeric::abs(result_list[i] - (y1 - y2) / _2h);
+      }
+
+      x = x_init;
+   }
+
+   template <typename T>
+   inline void second_derivative(const expression<T>& e,
+                                 T& x,
+                                 const std::vector<T>& x_list,
+                                 std::vector<T>& result_list,
+                                 const T& h = T(0.00001),
+                                 std::vector<T>* error_list = 0)
+   {
+      const T x_init = x;
+      const T _2h    = T(2) * h;
+
+      result_list.resize(x_list.size());
+
+      if (error_list)
+         error_list->resize(x_list.size());
+
+      for (std::size_t i = 0; i < x_list.size(); ++i)
+      {
+         x = x_list[i];
+         const T y  = e.value();
+         x = x_list[i] + _2h;
+         const T y0 = e.value();
+         x = x_list[i] + h;
+         const T y1 = e.value();
+         x = x_list[i] - h;
+         const T y2 = e.value();
+         x = x_list[i] - _2h;
+         const T y3 = e.value();
+
+         result_list[i] = (-y0 + T(16) * (y1 + y2) - T(30) * y - y3) / (T(12) * h * h);
+
+         if (error_list)
+            (*error_list)[i] = details::numeric::abs(result_list[i] - (y1 - T(2) * y + y2) / (h * h));
+      }
+
+      x = x_init;
+   }
+
+   template <typename T>
+   inline void third_derivative(const expression<T>& e,
+                                T& x,
+                                const std::vector<T>& x_list,
+                                std::vector<T>& result_list,
+                                const T& h = T(0.0001))
+   {
+      const T x_init = x;
+      const T _2h    = T(2) * h;
+
+      result_list.resize(x_list.size());
+
+      for (std::size_t i = 0; i < x_list.size(); ++i)
+      {
+         x = x_list[i] + _2h;
+         const T y0 = e.value();
+         x = x_list[i] + h;
+         const T y1 = e.value();
+         x = x_list[i] - h;
+         const T y2 = e.value();
+         x = x_list[i] - _2h;
+         const T y3 = e.value();
+
+         result_list[i] = (y0 + T(2) * (y2 - y1) - y3) / (T(2) * h * h * h);
+      }
+
+      x = x_init;
+   }
+
    template <typename T>
    inline T derivative(const expression<T>& e,
                        const std::string& variable_name,
@@ -43191,6 +48117,7 @@ namespace exprtk
                   case ctrlblk_t::e_unknown   : continue;
                   case ctrlblk_t::e_expr      : continue;
                   case ctrlblk_t::e_vecholder : continue;
+                  case ctrlblk_t::e_bitvecdata: continue;
                   default                     : break;
                }
 
@@ -43790,6 +48717,14 @@ namespace exprtk
          else
             mod_expression += "~{" + expression + "};";
 
+         /*
+            Function bodies may be re-entered by way of recursion, and
+            values shared within a body would be shared across frames.
+         */
+         parser_.settings()
+            .disable_common_subexpr_elim  ()
+            .disable_loop_invariant_motion();
+
          if (!parser_.compile(mod_expression,compiled_expression))
          {
             exprtk_debug(("Compositor Error: %s\n", parser_.error().c_str()));
@@ -43935,6 +48870,672 @@ namespace exprtk
 
 } // namespace exprtk
 
+#if defined(exprtk_enable_parallel_expression_graph) && (__cplusplus >= 201103L)
+#   define exprtk_parallel_expression_graph_enabled
+#   include <atomic>
+#   include <thread>
+#endif
+
+namespace exprtk
+{
+   /*
+      Incremental evaluation of many expressions bound to shared
+      symbol tables. Each expression's read and write sets are taken
+      from the parser's dependent entity collector. An expression
+      depends on every writer of a variable it reads, and writers of
+      the same variable are ordered as they were added. When
+      host variables change, only the expressions downstream of them
+      are re-evaluated, in topological order. Expressions that share
+      no written variables form independent components, which may be
+      evaluated concurrently.
+
+      Note: Writes made through functions (e.g. in-place vector
+            functions or user functions modifying their arguments)
+            are not visible to the collector, and hence do not create
+            dependencies.
+   */
+   template <typename T>
+   class expression_graph
+   {
+   public:
+
+      typedef exprtk::symbol_table<T> symbol_table_t;
+      typedef exprtk::expression<T>   expression_t;
+      typedef exprtk::parser<T>       parser_t;
+      typedef typename parser_t::dependent_entity_collector::symbol_t symbol_t;
+
+      static const std::size_t npos = static_cast<std::size_t>(-1);
+
+      expression_graph()
+      : build_required_(false)
+      {
+         parser_.dec().collect_variables  () = true;
+         parser_.dec().collect_assignments() = true;
+      }
+
+      explicit expression_graph(symbol_table_t& symbol_table)
+      : build_required_(false)
+      {
+         parser_.dec().collect_variables  () = true;
+         parser_.dec().collect_assignments() = true;
+         add_symbol_table(symbol_table);
+      }
+
+      inline void add_symbol_table(symbol_table_t& symbol_table)
+      {
+         symtab_list_.push_back(&symbol_table);
+      }
+
+      inline parser_t& parser()
+      {
+         return parser_;
+      }
+
+      // Compiles the expression, returns its index or npos upon error
+      inline std::size_t add(const std::string& expression_string)
+      {
+         node_list_.push_back(node_t());
+
+         node_t& node = node_list_.back();
+
+         for (std::size_t i = 0; i < symtab_list_.size(); ++i)
+         {
+            node.expression.register_symbol_table(*symtab_list_[i]);
+         }
+
+         if (!parser_.compile(expression_string, node.expression))
+         {
+            error_ = parser_.error();
+            node_list_.pop_back();
+
+            return npos;
+         }
+
+         const std::size_t index = node_list_.size() - 1;
+
+         std::deque<symbol_t> symbol_list;
+         std::deque<symbol_t> assignment_list;
+
+         parser_.dec().symbols           (symbol_list    );
+         parser_.dec().assignment_symbols(assignment_list);
+
+         // Every symbol of an expression is read, unless it is local
+         for (std::size_t i = 0; i < symbol_list.size(); ++i)
+         {
+            switch (symbol_list[i].second)
+            {
+               case parser_t::e_st_variable :
+               case parser_t::e_st_vector   :
+               case parser_t::e_st_string   : symbol_entry(symbol_list[i].first).reader_list
+                                                 .push_back(index);
+                                              break;
+
+               default                      : break;
+            }
+         }
+
+         for (std::size_t i = 0; i < assignment_list.size(); ++i)
+         {
+            symbol_entry(assignment_list[i].first).writer_list.push_back(index);
+         }
+
+         parser_.dec().clear();
+
+         node.dirty      = true;
+         build_required_ = true;
+
+         return index;
+      }
+
+      // Orders the expressions, returns false if the dependencies are cyclic
+      inline bool build()
+      {
+         const std::size_t n = node_list_.size();
+
+         for (std::size_t i = 0; i < n; ++i)
+         {
+            node_list_[i].successor_list.clear();
+         }
+
+         typename symbol_map_t::iterator itr = symbol_map_.begin();
+
+         for ( ; symbol_map_.end() != itr; ++itr)
+         {
+            const std::vector<std::size_t>& writer_list = itr->second.writer_list;
+            const std::vector<std::size_t>& reader_list = itr->second.reader_list;
+
+            for (std::size_t w = 0; w < writer_list.size(); ++w)
+            {
+               if ((w + 1) < writer_list.size())
+               {
+                  add_edge(writer_list[w], writer_list[w + 1]);
+               }
+
+               for (std::size_t r = 0; r < reader_list.size(); ++r)
+               {
+                  if (!is_writer(writer_list, reader_list[r]))
+                  {
+                     add_edge(writer_list[w], reader_list[r]);
+                  }
+               }
+            }
+         }
+
+         std::vector<std::size_t> in_degree(n, 0);
+
+         for (std::size_t i = 0; i < n; ++i)
+         {
+            std::vector<std::size_t>& successor_list = node_list_[i].successor_list;
+
+            std::sort(successor_list.begin(), successor_list.end());
+            successor_list.erase(std::unique(successor_list.begin(), successor_list.end()), successor_list.end());
+
+            for (std::size_t j = 0; j < successor_list.size(); ++j)
+            {
+               ++in_degree[successor_list[j]];
+            }
+         }
+
+         order_.clear();
+
+         for (std::size_t i = 0; i < n; ++i)
+         {
+            if (0 == in_degree[i])
+            {
+               order_.push_back(i);
+            }
+         }
+
+         for (std::size_t i = 0; i < order_.size(); ++i)
+         {
+            const std::vector<std::size_t>& successor_list = node_list_[order_[i]].successor_list;
+
+            for (std::size_t j = 0; j < successor_list.size(); ++j)
+            {
+               if (0 == --in_degree[successor_list[j]])
+               {
+                  order_.push_back(successor_list[j]);
+               }
+            }
+         }
+
+         if (order_.size() != n)
+         {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+               if (0 != in_degree[i])
+               {
+                  error_ = "Cyclic dependency involving expression " + details::to_str(static_cast<int>(i));
+                  break;
+               }
+            }
+
+            order_.clear();
+
+            return false;
+         }
+
+         build_components();
+
+         build_required_ = false;
+
+         return true;
+      }
+
+      // Marks the dependents of the given host symbol for re-evaluation
+      inline bool changed(const std::string& symbol_name)
+      {
+         std::string name = symbol_name;
+         details::case_normalise(name);
+
+         typename symbol_map_t::const_iterator itr = symbol_map_.find(name);
+
+         if (symbol_map_.end() == itr)
+            return false;
+
+         const std::vector<std::size_t>& reader_list = itr->second.reader_list;
+
+         for (std::size_t i = 0; i < reader_list.size(); ++i)
+         {
+            mark_dirty(reader_list[i]);
+         }
+
+         return true;
+      }
+
+      inline void invalidate()
+      {
+         for (std::size_t i = 0; i < node_list_.size(); ++i)
+         {
+            node_list_[i].dirty = true;
+         }
+      }
+
+      // Re-evaluates the dirty expressions, returns the number evaluated or npos upon error
+      inline std::size_t evaluate()
+      {
+         if (build_required_ && !build())
+            return npos;
+
+         std::size_t count = 0;
+
+         for (std::size_t i = 0; i < order_.size(); ++i)
+         {
+            count += evaluate_node(order_[i]);
+         }
+
+         return count;
+      }
+
+      #ifdef exprtk_parallel_expression_graph_enabled
+      // Components with dirty expressions are shared out among the threads
+      inline std::size_t evaluate(const std::size_t thread_count)
+      {
+         if (build_required_ && !build())
+            return npos;
+
+         std::vector<std::size_t> dirty_component_list;
+
+         for (std::size_t c = 0; c < component_list_.size(); ++c)
+         {
+            const std::vector<std::size_t>& component = component_list_[c];
+
+            for (std::size_t i = 0; i < component.size(); ++i)
+            {
+               if (node_list_[component[i]].dirty)
+               {
+                  dirty_component_list.push_back(c);
+                  break;
+               }
+            }
+         }
+
+         const std::size_t worker_count = std::max<std::size_t>(1,
+            std::min(thread_count, dirty_component_list.size()));
+
+         if (worker_count < 2)
+            return evaluate();
+
+         std::atomic<std::size_t> next_component(0);
+         std::atomic<std::size_t> count(0);
+
+         const auto worker = [&]()
+         {
+            std::size_t local_count = 0;
+
+            for ( ; ; )
+            {
+               const std::size_t c = next_component++;
+
+               if (c >= dirty_component_list.size())
+                  break;
+
+               const std::vector<std::size_t>& component = component_list_[dirty_component_list[c]];
+
+               for (std::size_t i = 0; i < component.size(); ++i)
+               {
+                  local_count += evaluate_node(component[i]);
+               }
+            }
+
+            count += local_count;
+         };
+
+         std::vector<std::thread> thread_list;
+         thread_list.reserve(worker_count - 1);
+
+         for (std::size_t i = 1; i < worker_count; ++i)
+         {
+            thread_list.emplace_back(worker);
+         }
+
+         worker();
+
+         for (std::size_t i = 0; i < thread_list.size(); ++i)
+         {
+            thread_list[i].join();
+         }
+
+         return count;
+      }
+      #endif
+
+      inline std::size_t size() const
+      {
+         return node_list_.size();
+      }
+
+      // Result of the most recent evaluation of the expression
+      inline T value(const std::size_t index) const
+      {
+         return node_list_[index].value;
+      }
+
+      inline expression_t& expression(const std::size_t index)
+      {
+         return node_list_[index].expression;
+      }
+
+      inline bool dirty(const std::size_t index) const
+      {
+         return node_list_[index].dirty;
+      }
+
+      inline std::size_t component_count() const
+      {
+         return component_list_.size();
+      }
+
+      inline const std::string& error() const
+      {
+         return error_;
+      }
+
+   private:
+
+      struct node_t
+      {
+         node_t()
+         : value(std::numeric_limits<T>::quiet_NaN())
+         , dirty(false)
+         {}
+
+         expression_t             expression;
+         T                        value;
+         bool                     dirty;
+         std::vector<std::size_t> successor_list;
+      };
+
+      struct symbol_entry_t
+      {
+         std::vector<std::size_t> reader_list;
+         std::vector<std::size_t> writer_list;
+      };
+
+      typedef std::map<std::string, symbol_entry_t> symbol_map_t;
+
+      inline symbol_entry_t& symbol_entry(const std::string& symbol_name)
+      {
+         return symbol_map_[symbol_name];
+      }
+
+      static inline bool is_writer(const std::vector<std::size_t>& writer_list, const std::size_t index)
+      {
+         return std::find(writer_list.begin(), writer_list.end(), index) != writer_list.end();
+      }
+
+      inline void add_edge(const std::size_t from, const std::size_t to)
+      {
+         if (from != to)
+         {
+            node_list_[from].successor_list.push_back(to);
+         }
+      }
+
+      inline void mark_dirty(const std::size_t index)
+      {
+         if (node_list_[index].dirty)
+            return;
+
+         std::vector<std::size_t> pending(1, index);
+         node_list_[index].dirty = true;
+
+         while (!pending.empty())
+         {
+            const std::vector<std::size_t>& successor_list = node_list_[pending.back()].successor_list;
+            pending.pop_back();
+
+            for (std::size_t i = 0; i < successor_list.size(); ++i)
+            {
+               if (!node_list_[successor_list[i]].dirty)
+               {
+                  node_list_[successor_list[i]].dirty = true;
+                  pending.push_back(successor_list[i]);
+               }
+            }
+         }
+      }
+
+      inline std::size_t evaluate_node(const std::size_t index)
+      {
+         node_t& node = node_list_[index];
+
+         if (!node.dirty)
+            return 0;
+
+         node.value = node.expression.value();
+         node.dirty = false;
+
+         return 1;
+      }
+
+      // Weakly connected components, each listed in topological order
+      inline void build_components()
+      {
+         const std::size_t n = node_list_.size();
+
+         std::vector<std::size_t> parent(n);
+
+         for (std::size_t i = 0; i < n; ++i)
+         {
+            parent[i] = i;
+         }
+
+         for (std::size_t i = 0; i < n; ++i)
+         {
+            const std::vector<std::size_t>& successor_list = node_list_[i].successor_list;
+
+            for (std::size_t j = 0; j < successor_list.size(); ++j)
+            {
+               const std::size_t root0 = find_root(parent, i);
+               const std::size_t root1 = find_root(parent, successor_list[j]);
+
+               if (root0 != root1)
+               {
+                  parent[root1] = root0;
+               }
+            }
+         }
+
+         std::vector<std::size_t> component_index(n, npos);
+
+         component_list_.clear();
+
+         for (std::size_t i = 0; i < order_.size(); ++i)
+         {
+            const std::size_t root = find_root(parent, order_[i]);
+
+            if (npos == component_index[root])
+            {
+               component_index[root] = component_list_.size();
+               component_list_.push_back(std::vector<std::size_t>());
+            }
+
+            component_list_[component_index[root]].push_back(order_[i]);
+         }
+      }
+
+      static inline std::size_t find_root(std::vector<std::size_t>& parent, std::size_t i)
+      {
+         while (parent[i] != i)
+         {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+         }
+
+         return i;
+      }
+
+      parser_t                               parser_;
+      std::vector<symbol_table_t*>           symtab_list_;
+      std::deque<node_t>                     node_list_;
+      symbol_map_t                           symbol_map_;
+      std::vector<std::size_t>               order_;
+      std::vector<std::vector<std::size_t> > component_list_;
+      std::string                            error_;
+      bool                                   build_required_;
+   };
+
+   /*
+      Compiles a set of expressions over shared symbol tables as a
+      single program with common subexpression elimination enabled,
+      so pure sub-trees repeated across the expressions (e.g. the d1
+      and d2 terms of a family of option greeks) are evaluated at
+      most once per evaluation of the set. The value of expression i
+      is written to element i of the results vector.
+   */
+   template <typename T>
+   class program_set
+   {
+   public:
+
+      typedef exprtk::symbol_table<T>           symbol_table_t;
+      typedef exprtk::expression<T>             expression_t;
+      typedef exprtk::parser<T>                 parser_t;
+      typedef typename parser_t::settings_store settings_t;
+
+      program_set()
+      : parser_(settings_t::default_compile_all_opts +
+                settings_t::e_common_subexpr_elim)
+      {}
+
+      explicit program_set(symbol_table_t& symbol_table)
+      : parser_(settings_t::default_compile_all_opts +
+                settings_t::e_common_subexpr_elim)
+      {
+         add_symbol_table(symbol_table);
+      }
+
+      inline void add_symbol_table(symbol_table_t& symbol_table)
+      {
+         symtab_list_.push_back(&symbol_table);
+      }
+
+      inline parser_t& parser()
+      {
+         return parser_;
+      }
+
+      // Returns the index of the expression's value in the results
+      inline std::size_t add(const std::string& expression_string)
+      {
+         expression_list_.push_back(expression_string);
+         return expression_list_.size() - 1;
+      }
+
+      inline bool compile()
+      {
+         if (expression_list_.empty())
+         {
+            error_ = "No expressions to compile";
+            return false;
+         }
+
+         for (std::size_t i = 0; i < symtab_list_.size(); ++i)
+         {
+            if (symtab_list_[i]->symbol_exists(results_name()))
+            {
+               error_ = "Symbol '" + results_name() + "' is reserved";
+               return false;
+            }
+         }
+
+         results_.assign(expression_list_.size(), T(0));
+
+         results_symtab_ = symbol_table_t();
+         results_symtab_.add_vector(results_name(), results_);
+
+         expression_ = expression_t();
+         expression_.register_symbol_table(results_symtab_);
+
+         for (std::size_t i = 0; i < symtab_list_.size(); ++i)
+         {
+            expression_.register_symbol_table(*symtab_list_[i]);
+         }
+
+         std::string program;
+
+         for (std::size_t i = 0; i < expression_list_.size(); ++i)
+         {
+            program += results_name() + "[" + details::to_str(static_cast<int>(i)) + "] := {" +
+                       expression_list_[i] + "\n};\n";
+         }
+
+         if (parser_.compile(program, expression_))
+         {
+            error_.clear();
+            return true;
+         }
+
+         // Locate the offending expression, so the error refers to its own text
+         for (std::size_t i = 0; i < expression_list_.size(); ++i)
+         {
+            expression_t expression;
+
+            for (std::size_t j = 0; j < symtab_list_.size(); ++j)
+            {
+               expression.register_symbol_table(*symtab_list_[j]);
+            }
+
+            if (!parser_.compile(expression_list_[i], expression))
+            {
+               error_ = "Expression " + details::to_str(static_cast<int>(i)) + ": " + parser_.error();
+               return false;
+            }
+         }
+
+         error_ = parser_.error();
+
+         return false;
+      }
+
+      // Evaluates every expression of the set, filling the results
+      inline const std::vector<T>& evaluate()
+      {
+         expression_.value();
+         return results_;
+      }
+
+      inline void evaluate(T* results)
+      {
+         expression_.value();
+         std::copy(results_.begin(), results_.end(), results);
+      }
+
+      inline const std::vector<T>& results() const
+      {
+         return results_;
+      }
+
+      inline std::size_t size() const
+      {
+         return expression_list_.size();
+      }
+
+      inline const std::string& error() const
+      {
+         return error_;
+      }
+
+   private:
+
+      static inline std::string results_name()
+      {
+         return "program_set_results";
+      }
+
+      parser_t                     parser_;
+      std::vector<symbol_table_t*> symtab_list_;
+      std::vector<std::string>     expression_list_;
+      std::vector<T>               results_;
+      symbol_table_t               results_symtab_;
+      expression_t                 expression_;
+      std::string                  error_;
+   };
+
+
+} // namespace exprtk
+
 #if defined(_MSC_VER) || defined(_WIN32) || defined(__WIN32__) || defined(WIN32)
 #   ifndef NOMINMAX
 #      define NOMINMAX
@@ -44723,6 +50324,26 @@ namespace exprtk
 #endif
 
 #ifndef exprtk_disable_rtl_vecops
+
+#if defined(exprtk_enable_parallel_vecops) && (__cplusplus >= 201103L)
+#   define exprtk_parallel_vecops_enabled
+#   include <thread>
+#endif
+
+#ifndef exprtk_parallel_vecops_threshold
+#   define exprtk_parallel_vecops_threshold 1000000
+#endif
+
+#ifndef exprtk_disable_simd_vecops
+#   if defined(__AVX__)
+#      define exprtk_simd_vecops_avx
+#      include <immintrin.h>
+#   elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#      define exprtk_simd_vecops_sse2
+#      include <emmintrin.h>
+#   endif
+#endif
+
 namespace exprtk
 {
    namespace rtl { namespace vecops {
@@ -44785,6 +50406,515 @@ namespace exprtk
          sum = y;
       }
 
+      #ifdef exprtk_parallel_vecops_enabled
+      inline std::size_t parallel_thread_count(const std::size_t size, const std::size_t threshold)
+      {
+         if (size < threshold)
+            return 1;
+
+         const std::size_t hw_threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+         const std::size_t min_chunk  = std::max<std::size_t>(1, threshold / 4);
+
+         return std::max<std::size_t>(1, std::min(hw_threads, size / min_chunk));
+      }
+
+      template <typename Function>
+      inline void parallel_for(const std::size_t thread_count, const Function& f)
+      {
+         std::vector<std::thread> thread_list;
+         thread_list.reserve(thread_count - 1);
+
+         for (std::size_t i = 1; i < thread_count; ++i)
+         {
+            thread_list.emplace_back(f, i);
+         }
+
+         f(0);
+
+         for (std::size_t i = 0; i < thread_list.size(); ++i)
+         {
+            thread_list[i].join();
+         }
+      }
+
+      /*
+         Each thread sorts a contiguous chunk, the sorted chunks are
+         then merged pairwise in log2(thread_count) parallel rounds.
+      */
+      template <typename T, typename Compare>
+      inline void parallel_sort(T* begin, T* end, Compare comp, const std::size_t threshold)
+      {
+         const std::size_t size         = static_cast<std::size_t>(end - begin);
+         const std::size_t thread_count = parallel_thread_count(size, threshold);
+
+         if (thread_count < 2)
+         {
+            std::sort(begin, end, comp);
+            return;
+         }
+
+         std::vector<std::size_t> bounds(thread_count + 1);
+
+         for (std::size_t i = 0; i <= thread_count; ++i)
+         {
+            bounds[i] = (size * i) / thread_count;
+         }
+
+         parallel_for(thread_count, [&](const std::size_t i)
+         {
+            std::sort(begin + bounds[i], begin + bounds[i + 1], comp);
+         });
+
+         for (std::size_t width = 1; width < thread_count; width *= 2)
+         {
+            const std::size_t merge_count = (thread_count + (2 * width) - 1) / (2 * width);
+
+            parallel_for(merge_count, [&](const std::size_t i)
+            {
+               const std::size_t lo  = 2 * width * i;
+               const std::size_t mid = std::min(lo + width    , thread_count);
+               const std::size_t hi  = std::min(lo + 2 * width, thread_count);
+
+               if (mid < hi)
+               {
+                  std::inplace_merge(begin + bounds[lo], begin + bounds[mid], begin + bounds[hi], comp);
+               }
+            });
+         }
+      }
+
+      /*
+         Quickselect where each partitioning round is a parallel three-way
+         (less/equal/greater) scatter through a scratch buffer. Once the
+         remaining window drops below the threshold, std::nth_element
+         finishes the selection.
+      */
+      template <typename T>
+      inline void parallel_nth_element(T* begin, T* nth, T* end, const std::size_t threshold)
+      {
+         if (nth >= end)
+            return;
+
+         std::vector<T> buffer;
+
+         while (parallel_thread_count(static_cast<std::size_t>(end - begin), threshold) > 1)
+         {
+            const std::size_t size         = static_cast<std::size_t>(end - begin);
+            const std::size_t thread_count = parallel_thread_count(size, threshold);
+
+            const std::size_t sample_size = 127;
+            T sample[sample_size];
+
+            for (std::size_t i = 0; i < sample_size; ++i)
+            {
+               sample[i] = begin[(i * (size - 1)) / (sample_size - 1)];
+            }
+
+            const std::size_t pivot_index = (static_cast<std::size_t>(nth - begin) * (sample_size - 1)) / (size - 1);
+            std::nth_element(sample, sample + pivot_index, sample + sample_size);
+            const T pivot = sample[pivot_index];
+
+            std::vector<std::size_t> bounds(thread_count + 1);
+
+            for (std::size_t i = 0; i <= thread_count; ++i)
+            {
+               bounds[i] = (size * i) / thread_count;
+            }
+
+            std::vector<std::size_t> lt_count(thread_count, 0);
+            std::vector<std::size_t> gt_count(thread_count, 0);
+
+            parallel_for(thread_count, [&](const std::size_t i)
+            {
+               std::size_t lt = 0;
+               std::size_t gt = 0;
+
+               for (std::size_t j = bounds[i]; j < bounds[i + 1]; ++j)
+               {
+                  if (begin[j] < pivot)
+                     ++lt;
+                  else if (pivot < begin[j])
+                     ++gt;
+               }
+
+               lt_count[i] = lt;
+               gt_count[i] = gt;
+            });
+
+            std::vector<std::size_t> lt_offset(thread_count, 0);
+            std::vector<std::size_t> eq_offset(thread_count, 0);
+            std::vector<std::size_t> gt_offset(thread_count, 0);
+
+            std::size_t total_lt = 0;
+            std::size_t total_gt = 0;
+
+            for (std::size_t i = 0; i < thread_count; ++i)
+            {
+               total_lt += lt_count[i];
+               total_gt += gt_count[i];
+            }
+
+            const std::size_t total_eq = size - total_lt - total_gt;
+
+            for (std::size_t i = 1; i < thread_count; ++i)
+            {
+               const std::size_t eq_count = (bounds[i] - bounds[i - 1]) - lt_count[i - 1] - gt_count[i - 1];
+
+               lt_offset[i] = lt_offset[i - 1] + lt_count[i - 1];
+               eq_offset[i] = eq_offset[i - 1] + eq_count;
+               gt_offset[i] = gt_offset[i - 1] + gt_count[i - 1];
+            }
+
+            buffer.resize(size);
+
+            parallel_for(thread_count, [&](const std::size_t i)
+            {
+               T* lt_itr = &buffer[0] + lt_offset[i];
+               T* eq_itr = &buffer[0] + total_lt + eq_offset[i];
+               T* gt_itr = &buffer[0] + total_lt + total_eq + gt_offset[i];
+
+               for (std::size_t j = bounds[i]; j < bounds[i + 1]; ++j)
+               {
+                  if (begin[j] < pivot)
+                     *(lt_itr++) = begin[j];
+                  else if (pivot < begin[j])
+                     *(gt_itr++) = begin[j];
+                  else
+                     *(eq_itr++) = begin[j];
+               }
+            });
+
+            parallel_for(thread_count, [&](const std::size_t i)
+            {
+               std::copy(buffer.begin() + bounds[i], buffer.begin() + bounds[i + 1], begin + bounds[i]);
+            });
+
+            const std::size_t nth_index = static_cast<std::size_t>(nth - begin);
+
+            if (nth_index < total_lt)
+               end = begin + total_lt;
+            else if (nth_index >= (total_lt + total_eq))
+               begin = begin + total_lt + total_eq;
+            else
+            {
+               // Equal band: holds only pivot-equivalent (or unordered) values
+               begin = begin + total_lt;
+               end   = begin + total_eq;
+               break;
+            }
+         }
+
+         std::nth_element(begin, nth, end);
+      }
+      #endif
+
+      template <typename T, typename Compare>
+      inline void sort_range(T* begin, T* end, Compare comp, const std::size_t threshold)
+      {
+         #ifdef exprtk_parallel_vecops_enabled
+         parallel_sort(begin, end, comp, threshold);
+         #else
+         (void)threshold;
+         std::sort(begin, end, comp);
+         #endif
+      }
+
+      template <typename T>
+      inline void nth_element_range(T* begin, T* nth, T* end, const std::size_t threshold)
+      {
+         #ifdef exprtk_parallel_vecops_enabled
+         parallel_nth_element(begin, nth, end, threshold);
+         #else
+         (void)threshold;
+         std::nth_element(begin, nth, end);
+         #endif
+      }
+
+      /*
+         BLAS level-1 kernels backing the axpy family. Each computes into z,
+         which may alias either input provided it does not precede it, ie:
+         z == x, z == y or z < y (as is the case for the shifted variants).
+      */
+      template <typename T>
+      struct scalar_blas1
+      {
+         // z[i] <- a * x[i] + y[i]
+         static inline void axpy(const T a, const T* x, const T* y, T* z, const std::size_t n)
+         {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+               z[i] = (a * x[i]) + y[i];
+            }
+         }
+
+         // z[i] <- a * x[i] + b * y[i]
+         static inline void axpby(const T a, const T* x, const T b, const T* y, T* z, const std::size_t n)
+         {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+               z[i] = (a * x[i]) + (b * y[i]);
+            }
+         }
+
+         // z[i] <- a * x[i] + b
+         static inline void axpb(const T a, const T* x, const T b, T* z, const std::size_t n)
+         {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+               z[i] = (a * x[i]) + b;
+            }
+         }
+      };
+
+      template <typename T>
+      struct blas1 : public scalar_blas1<T> {};
+
+      #if defined(exprtk_simd_vecops_avx) || defined(exprtk_simd_vecops_sse2)
+      template <typename T> struct simd_traits;
+
+      #ifdef exprtk_simd_vecops_avx
+      template <>
+      struct simd_traits<double>
+      {
+         typedef __m256d reg_t;
+         static const std::size_t width = 4;
+
+         static inline reg_t set1  (const double  v)            { return _mm256_set1_pd(v);     }
+         static inline reg_t load  (const double* p)            { return _mm256_load_pd(p);     }
+         static inline reg_t loadu (const double* p)            { return _mm256_loadu_pd(p);    }
+         static inline void  store (double* p, const reg_t v)   { _mm256_store_pd(p,v);         }
+         static inline void  storeu(double* p, const reg_t v)   { _mm256_storeu_pd(p,v);        }
+         static inline reg_t add   (const reg_t a, const reg_t b) { return _mm256_add_pd(a,b);  }
+         static inline reg_t mul   (const reg_t a, const reg_t b) { return _mm256_mul_pd(a,b);  }
+      };
+
+      template <>
+      struct simd_traits<float>
+      {
+         typedef __m256 reg_t;
+         static const std::size_t width = 8;
+
+         static inline reg_t set1  (const float  v)             { return _mm256_set1_ps(v);     }
+         static inline reg_t load  (const float* p)             { return _mm256_load_ps(p);     }
+         static inline reg_t loadu (const float* p)             { return _mm256_loadu_ps(p);    }
+         static inline void  store (float* p, const reg_t v)    { _mm256_store_ps(p,v);         }
+         static inline void  storeu(float* p, const reg_t v)    { _mm256_storeu_ps(p,v);        }
+         static inline reg_t add   (const reg_t a, const reg_t b) { return _mm256_add_ps(a,b);  }
+         static inline reg_t mul   (const reg_t a, const reg_t b) { return _mm256_mul_ps(a,b);  }
+      };
+      #else
+      template <>
+      struct simd_traits<double>
+      {
+         typedef __m128d reg_t;
+         static const std::size_t width = 2;
+
+         static inline reg_t set1  (const double  v)            { return _mm_set1_pd(v);        }
+         static inline reg_t load  (const double* p)            { return _mm_load_pd(p);        }
+         static inline reg_t loadu (const double* p)            { return _mm_loadu_pd(p);       }
+         static inline void  store (double* p, const reg_t v)   { _mm_store_pd(p,v);            }
+         static inline void  storeu(double* p, const reg_t v)   { _mm_storeu_pd(p,v);           }
+         static inline reg_t add   (const reg_t a, const reg_t b) { return _mm_add_pd(a,b);     }
+         static inline reg_t mul   (const reg_t a, const reg_t b) { return _mm_mul_pd(a,b);     }
+      };
+
+      template <>
+      struct simd_traits<float>
+      {
+         typedef __m128 reg_t;
+         static const std::size_t width = 4;
+
+         static inline reg_t set1  (const float  v)             { return _mm_set1_ps(v);        }
+         static inline reg_t load  (const float* p)             { return _mm_load_ps(p);        }
+         static inline reg_t loadu (const float* p)             { return _mm_loadu_ps(p);       }
+         static inline void  store (float* p, const reg_t v)    { _mm_store_ps(p,v);            }
+         static inline void  storeu(float* p, const reg_t v)    { _mm_storeu_ps(p,v);           }
+         static inline reg_t add   (const reg_t a, const reg_t b) { return _mm_add_ps(a,b);     }
+         static inline reg_t mul   (const reg_t a, const reg_t b) { return _mm_mul_ps(a,b);     }
+      };
+      #endif
+
+      template <typename T, bool Aligned>
+      struct simd_access
+      {
+         typedef simd_traits<T> traits;
+         typedef typename traits::reg_t reg_t;
+
+         static inline reg_t load (const T* p)           { return traits::loadu(p); }
+         static inline void  store(T* p, const reg_t v)  { traits::storeu(p,v);     }
+      };
+
+      template <typename T>
+      struct simd_access<T,true>
+      {
+         typedef simd_traits<T> traits;
+         typedef typename traits::reg_t reg_t;
+
+         static inline reg_t load (const T* p)           { return traits::load(p);  }
+         static inline void  store(T* p, const reg_t v)  { traits::store(p,v);      }
+      };
+
+      /*
+         Both registers of an unrolled step are loaded before either is
+         stored, so the forward-aliasing contract of blas1 is preserved.
+      */
+      template <typename T, bool Aligned>
+      struct simd_blas1_kernel
+      {
+         typedef simd_traits<T>           traits;
+         typedef simd_access<T,Aligned>   access;
+         typedef typename traits::reg_t   reg_t;
+
+         static const std::size_t width = traits::width;
+
+         static inline std::size_t axpy(const T a, const T* x, const T* y, T* z, const std::size_t n)
+         {
+            const reg_t va = traits::set1(a);
+            std::size_t i = 0;
+
+            for ( ; (i + 2 * width) <= n; i += 2 * width)
+            {
+               const reg_t x0 = access::load(x + i        );
+               const reg_t x1 = access::load(x + i + width);
+               const reg_t y0 = access::load(y + i        );
+               const reg_t y1 = access::load(y + i + width);
+
+               access::store(z + i        , traits::add(traits::mul(va,x0),y0));
+               access::store(z + i + width, traits::add(traits::mul(va,x1),y1));
+            }
+
+            for ( ; (i + width) <= n; i += width)
+            {
+               access::store(z + i, traits::add(traits::mul(va,access::load(x + i)),access::load(y + i)));
+            }
+
+            return i;
+         }
+
+         static inline std::size_t axpby(const T a, const T* x, const T b, const T* y, T* z, const std::size_t n)
+         {
+            const reg_t va = traits::set1(a);
+            const reg_t vb = traits::set1(b);
+            std::size_t i = 0;
+
+            for ( ; (i + 2 * width) <= n; i += 2 * width)
+            {
+               const reg_t x0 = access::load(x + i        );
+               const reg_t x1 = access::load(x + i + width);
+               const reg_t y0 = access::load(y + i        );
+               const reg_t y1 = access::load(y + i + width);
+
+               access::store(z + i        , traits::add(traits::mul(va,x0),traits::mul(vb,y0)));
+               access::store(z + i + width, traits::add(traits::mul(va,x1),traits::mul(vb,y1)));
+            }
+
+            for ( ; (i + width) <= n; i += width)
+            {
+               access::store(z + i, traits::add(traits::mul(va,access::load(x + i)),
+                                                traits::mul(vb,access::load(y + i))));
+            }
+
+            return i;
+         }
+
+         static inline std::size_t axpb(const T a, const T* x, const T b, T* z, const std::size_t n)
+         {
+            const reg_t va = traits::set1(a);
+            const reg_t vb = traits::set1(b);
+            std::size_t i = 0;
+
+            for ( ; (i + 2 * width) <= n; i += 2 * width)
+            {
+               const reg_t x0 = access::load(x + i        );
+               const reg_t x1 = access::load(x + i + width);
+
+               access::store(z + i        , traits::add(traits::mul(va,x0),vb));
+               access::store(z + i + width, traits::add(traits::mul(va,x1),vb));
+            }
+
+            for ( ; (i + width) <= n; i += width)
+            {
+               access::store(z + i, traits::add(traits::mul(va,access::load(x + i)),vb));
+            }
+
+            return i;
+         }
+      };
+
+      template <typename T>
+      struct simd_blas1
+      {
+         static const std::size_t alignment = sizeof(typename simd_traits<T>::reg_t);
+
+         static inline bool is_aligned(const T* p)
+         {
+            return 0 == (reinterpret_cast<std::size_t>(p) % alignment);
+         }
+
+         // Number of leading scalar iterations required to bring z onto a register boundary
+         static inline std::size_t peel_count(const T* z, const std::size_t n)
+         {
+            const std::size_t misalignment = reinterpret_cast<std::size_t>(z) % alignment;
+
+            if ((0 == misalignment) || (0 != (misalignment % sizeof(T))))
+               return 0;
+
+            return std::min(n, (alignment - misalignment) / sizeof(T));
+         }
+
+         static inline void axpy(const T a, const T* x, const T* y, T* z, const std::size_t n)
+         {
+            const std::size_t p = peel_count(z, n);
+            scalar_blas1<T>::axpy(a, x, y, z, p);
+
+            std::size_t i = p;
+
+            if (is_aligned(x + p) && is_aligned(y + p) && is_aligned(z + p))
+               i += simd_blas1_kernel<T,true >::axpy(a, x + p, y + p, z + p, n - p);
+            else
+               i += simd_blas1_kernel<T,false>::axpy(a, x + p, y + p, z + p, n - p);
+
+            scalar_blas1<T>::axpy(a, x + i, y + i, z + i, n - i);
+         }
+
+         static inline void axpby(const T a, const T* x, const T b, const T* y, T* z, const std::size_t n)
+         {
+            const std::size_t p = peel_count(z, n);
+            scalar_blas1<T>::axpby(a, x, b, y, z, p);
+
+            std::size_t i = p;
+
+            if (is_aligned(x + p) && is_aligned(y + p) && is_aligned(z + p))
+               i += simd_blas1_kernel<T,true >::axpby(a, x + p, b, y + p, z + p, n - p);
+            else
+               i += simd_blas1_kernel<T,false>::axpby(a, x + p, b, y + p, z + p, n - p);
+
+            scalar_blas1<T>::axpby(a, x + i, b, y + i, z + i, n - i);
+         }
+
+         static inline void axpb(const T a, const T* x, const T b, T* z, const std::size_t n)
+         {
+            const std::size_t p = peel_count(z, n);
+            scalar_blas1<T>::axpb(a, x, b, z, p);
+
+            std::size_t i = p;
+
+            if (is_aligned(x + p) && is_aligned(z + p))
+               i += simd_blas1_kernel<T,true >::axpb(a, x + p, b, z + p, n - p);
+            else
+               i += simd_blas1_kernel<T,false>::axpb(a, x + p, b, z + p, n - p);
+
+            scalar_blas1<T>::axpb(a, x + i, b, z + i, n - i);
+         }
+      };
+
+      template <>
+      struct blas1<double> : public simd_blas1<double> {};
+
+      template <>
+      struct blas1<float> : public simd_blas1<float> {};
+      #endif
+
    } // namespace exprtk::rtl::details
 
    template <typename T>
@@ -45425,7 +51555,7 @@ namespace exprtk
 
       using igfun_t::operator();
 
-      sort()
+      explicit sort(const std::size_t parallel_threshold = exprtk_parallel_vecops_threshold)
       : exprtk::igeneric_function<T>("V|VTT|VS|VSTT")
         /*
            Overloads:
@@ -45434,6 +51564,7 @@ namespace exprtk
            2. VS   - vector, string
            3. VSTT - vector, string, r0, r1
         */
+      , parallel_threshold_(parallel_threshold)
       {}
 
       inline T operator() (const std::size_t& ps_index, parameter_list_t parameters) exprtk_override
@@ -45461,18 +51592,24 @@ namespace exprtk
          }
 
          if (ascending)
-            std::sort(
+            details::sort_range(
                vec.begin() + r0,
                vec.begin() + r1 + 1,
-               std::less<T>());
+               std::less<T>(),
+               parallel_threshold_);
          else
-            std::sort(
+            details::sort_range(
                vec.begin() + r0,
                vec.begin() + r1 + 1,
-               std::greater<T>());
+               std::greater<T>(),
+               parallel_threshold_);
 
          return T(1);
       }
+
+   private:
+
+      std::size_t parallel_threshold_;
    };
 
    template <typename T>
@@ -45488,13 +51625,14 @@ namespace exprtk
 
       using igfun_t::operator();
 
-      nthelement()
+      explicit nthelement(const std::size_t parallel_threshold = exprtk_parallel_vecops_threshold)
       : exprtk::igeneric_function<T>("VT|VTTT")
         /*
            Overloads:
            0. VT   - vector, nth-element
            1. VTTT - vector, nth-element, r0, r1
         */
+      , parallel_threshold_(parallel_threshold)
       {}
 
       inline T operator() (const std::size_t& ps_index, parameter_list_t parameters) exprtk_override
@@ -45513,13 +51651,18 @@ namespace exprtk
             return std::numeric_limits<T>::quiet_NaN();
          }
 
-         std::nth_element(
+         details::nth_element_range(
             vec.begin() + r0,
             vec.begin() + r0 + n ,
-            vec.begin() + r1 + 1);
+            vec.begin() + r1 + 1,
+            parallel_threshold_);
 
          return T(1);
       }
+
+   private:
+
+      std::size_t parallel_threshold_;
    };
 
    template <typename T>
@@ -45725,10 +51868,7 @@ namespace exprtk
 
          const T a = scalar_t(parameters[0])();
 
-         for (std::size_t i = r0; i <= r1; ++i)
-         {
-            y[i] = (a * x[i]) + y[i];
-         }
+         details::blas1<T>::axpy(a, x.begin() + r0, y.begin() + r0, y.begin() + r0, r1 - r0 + 1);
 
          return T(1);
       }
@@ -45773,10 +51913,7 @@ namespace exprtk
          const T a = scalar_t(parameters[0])();
          const T b = scalar_t(parameters[2])();
 
-         for (std::size_t i = r0; i <= r1; ++i)
-         {
-            y[i] = (a * x[i]) + (b * y[i]);
-         }
+         details::blas1<T>::axpby(a, x.begin() + r0, b, y.begin() + r0, y.begin() + r0, r1 - r0 + 1);
 
          return T(1);
       }
@@ -45823,10 +51960,7 @@ namespace exprtk
 
          const T a = scalar_t(parameters[0])();
 
-         for (std::size_t i = r0; i <= r1; ++i)
-         {
-            z[i] = (a * x[i]) + y[i];
-         }
+         details::blas1<T>::axpy(a, x.begin() + r0, y.begin() + r0, z.begin() + r0, r1 - r0 + 1);
 
          return T(1);
       }
@@ -45874,10 +52008,7 @@ namespace exprtk
          const T a = scalar_t(parameters[0])();
          const T b = scalar_t(parameters[2])();
 
-         for (std::size_t i = r0; i <= r1; ++i)
-         {
-            z[i] = (a * x[i]) + (b * y[i]);
-         }
+         details::blas1<T>::axpby(a, x.begin() + r0, b, y.begin() + r0, z.begin() + r0, r1 - r0 + 1);
 
          return T(1);
       }
@@ -45924,10 +52055,7 @@ namespace exprtk
 
          const std::size_t s = static_cast<std::size_t>(scalar_t(parameters[3])());
 
-         for (std::size_t i = r0; i <= r1; ++i)
-         {
-            y[i] = (a * x[i]) + (b * y[i + s]);
-         }
+         details::blas1<T>::axpby(a, x.begin() + r0, b, y.begin() + r0 + s, y.begin() + r0, r1 - r0 + 1);
 
          return T(1);
       }
@@ -45977,10 +52105,7 @@ namespace exprtk
 
          const std::size_t s = static_cast<std::size_t>(scalar_t(parameters[3])());
 
-         for (std::size_t i = r0; i <= r1; ++i)
-         {
-            z[i] = (a * x[i]) + (b * y[i + s]);
-         }
+         details::blas1<T>::axpby(a, x.begin() + r0, b, y.begin() + r0 + s, z.begin() + r0, r1 - r0 + 1);
 
          return T(1);
       }
@@ -46025,10 +52150,7 @@ namespace exprtk
          const T a = scalar_t(parameters[0])();
          const T b = scalar_t(parameters[2])();
 
-         for (std::size_t i = r0; i <= r1; ++i)
-         {
-            z[i] = (a * x[i]) + b;
-         }
+         details::blas1<T>::axpb(a, x.begin() + r0, b, z.begin() + r0, r1 - r0 + 1);
 
          return T(1);
       }
@@ -46568,6 +52690,673 @@ namespace exprtk
 }    // namespace exprtk
 #endif
 
+#ifndef exprtk_disable_rtl_random
+namespace exprtk
+{
+   namespace rtl { namespace random {
+
+   namespace details
+   {
+      typedef unsigned int               word_t;
+      typedef exprtk::details::_uint64_t dword_t;
+
+      /*
+         Philox4x32-10 counter-based generator (Salmon et al. 2011).
+         Each (key, counter) pair maps to an independent block of four
+         32-bit words, hence any element of a stream can be computed
+         without generating its predecessors.
+      */
+      inline void philox4x32(const word_t (&key)[2], const word_t (&ctr)[4], word_t (&out)[4])
+      {
+         word_t c0 = ctr[0];
+         word_t c1 = ctr[1];
+         word_t c2 = ctr[2];
+         word_t c3 = ctr[3];
+         word_t k0 = key[0];
+         word_t k1 = key[1];
+
+         for (std::size_t round = 0; round < 10; ++round)
+         {
+            const dword_t p0 = dword_t(0xD2511F53U) * c0;
+            const dword_t p1 = dword_t(0xCD9E8D57U) * c2;
+
+            c0 = static_cast<word_t>(p1 >> 32) ^ c1 ^ k0;
+            c1 = static_cast<word_t>(p1      );
+            c2 = static_cast<word_t>(p0 >> 32) ^ c3 ^ k1;
+            c3 = static_cast<word_t>(p0      );
+
+            k0 += 0x9E3779B9U;
+            k1 += 0xBB67AE85U;
+         }
+
+         out[0] = c0;
+         out[1] = c1;
+         out[2] = c2;
+         out[3] = c3;
+      }
+
+      // Uniform in [0,1) with 53 bits of precision
+      inline double to_unit(const word_t hi, const word_t lo)
+      {
+         return ((hi >> 5) * 67108864.0 + (lo >> 6)) * (1.0 / 9007199254740992.0);
+      }
+
+      inline double log_gamma(const double x)
+      {
+         static const double a[] =
+            {
+               8.333333333333333e-02, -2.777777777777778e-03,
+               7.936507936507937e-04, -5.952380952380952e-04,
+               8.417508417508418e-04, -1.917526917526918e-03,
+               6.410256410256410e-03, -2.955065359477124e-02,
+               1.796443723688307e-01, -1.392432216905900e+00
+            };
+
+         if ((1.0 == x) || (2.0 == x))
+            return 0.0;
+
+         double x0 = x;
+         std::size_t n = 0;
+
+         if (x <= 7.0)
+         {
+            n  = static_cast<std::size_t>(7.0 - x);
+            x0 = x + n;
+         }
+
+         const double x2 = 1.0 / (x0 * x0);
+
+         double gl0 = a[9];
+
+         for (int k = 8; k >= 0; --k)
+         {
+            gl0 = gl0 * x2 + a[k];
+         }
+
+         double gl = gl0 / x0 + 0.5 * std::log(2.0 * exprtk::details::numeric::constant::pi) +
+                     (x0 - 0.5) * std::log(x0) - x0;
+
+         for (std::size_t k = 0; k < n; ++k)
+         {
+            x0 -= 1.0;
+            gl -= std::log(x0);
+         }
+
+         return gl;
+      }
+   } // namespace exprtk::rtl::random::details
+
+   /*
+      A seeded stream of Philox blocks. Every call or vector fill
+      reserves a contiguous range of block indices, so the values
+      produced depend only on (seed, stream) and the sequence of
+      calls - never on the number of threads used to fill a vector.
+      Distinct streams of the same seed are independent, giving one
+      reproducible stream per thread.
+   */
+   class generator
+   {
+   public:
+
+      typedef details::word_t  word_t;
+      typedef details::dword_t dword_t;
+
+      explicit generator(const dword_t seed = 0x853C49E6748FEA9BULL, const word_t stream = 0)
+      {
+         reseed(seed, stream);
+      }
+
+      inline void reseed(const dword_t seed, const word_t stream = 0)
+      {
+         key_[0] = static_cast<word_t>(seed      );
+         key_[1] = static_cast<word_t>(seed >> 32);
+         stream_ = stream;
+         index_  = 0;
+      }
+
+      inline dword_t reserve(const dword_t block_count)
+      {
+         const dword_t index = index_;
+         index_ += block_count;
+         return index;
+      }
+
+      inline void block(const dword_t index, const word_t sub_index, word_t (&out)[4]) const
+      {
+         const word_t ctr[4] =
+            {
+               static_cast<word_t>(index      ),
+               static_cast<word_t>(index >> 32),
+               stream_,
+               sub_index
+            };
+
+         details::philox4x32(key_, ctr, out);
+      }
+
+   private:
+
+      word_t  key_[2];
+      word_t  stream_;
+      dword_t index_;
+   };
+
+   namespace details
+   {
+      /*
+         Uniform and normal variates are produced two per block: the
+         element at offset i of a fill uses block (base + i / 2).
+      */
+      template <typename T>
+      struct uniform_kernel
+      {
+         uniform_kernel(const T& a, const T& b)
+         : a_(a)
+         , d_(b - a)
+         {}
+
+         inline void operator()(const word_t (&w)[4], T& x0, T& x1) const
+         {
+            x0 = a_ + d_ * T(to_unit(w[0], w[1]));
+            x1 = a_ + d_ * T(to_unit(w[2], w[3]));
+         }
+
+         T a_;
+         T d_;
+      };
+
+      template <typename T>
+      struct normal_kernel
+      {
+         normal_kernel(const T& mean, const T& stddev)
+         : mean_  (mean  )
+         , stddev_(stddev)
+         {}
+
+         // Box-Muller transform
+         inline void operator()(const word_t (&w)[4], T& x0, T& x1) const
+         {
+            const double r     = std::sqrt(-2.0 * std::log(1.0 - to_unit(w[0], w[1])));
+            const double theta = 2.0 * exprtk::details::numeric::constant::pi * to_unit(w[2], w[3]);
+
+            x0 = mean_ + stddev_ * T(r * std::cos(theta));
+            x1 = mean_ + stddev_ * T(r * std::sin(theta));
+         }
+
+         T mean_;
+         T stddev_;
+      };
+
+      template <typename T, typename Kernel>
+      inline void fill_pairs(const generator& g, const dword_t base,
+                             T* data, const std::size_t size, const Kernel& kernel)
+      {
+         word_t w[4];
+
+         std::size_t i = 0;
+
+         for ( ; (i + 1) < size; i += 2)
+         {
+            g.block(base + (i / 2), 0, w);
+            kernel(w, data[i], data[i + 1]);
+         }
+
+         if (i < size)
+         {
+            T discard = T(0);
+            g.block(base + (i / 2), 0, w);
+            kernel(w, data[i], discard);
+         }
+      }
+
+      /*
+         Poisson variates consume a variable number of uniforms, so the
+         element at offset i of a fill owns block index (base + i) and
+         walks the sub-index counter, which is never used by the paired
+         kernels above.
+      */
+      class element_source
+      {
+      public:
+
+         element_source(const generator& g, const dword_t index)
+         : g_(g)
+         , index_(index)
+         , sub_index_(0)
+         , lane_(2)
+         {}
+
+         inline double operator()()
+         {
+            if (2 == lane_)
+            {
+               word_t w[4];
+               g_.block(index_, ++sub_index_, w);
+               u_[0] = to_unit(w[0], w[1]);
+               u_[1] = to_unit(w[2], w[3]);
+               lane_ = 0;
+            }
+
+            return u_[lane_++];
+         }
+
+      private:
+
+         element_source(const element_source&) exprtk_delete;
+         element_source& operator=(const element_source&) exprtk_delete;
+
+         const generator& g_;
+         const dword_t index_;
+         word_t sub_index_;
+         std::size_t lane_;
+         double u_[2];
+      };
+
+      /*
+         Multiplication method for small means, and the transformed
+         rejection method with squeeze (PTRS, Hormann 1993) otherwise.
+      */
+      inline double poisson_variate(element_source& u, const double lambda)
+      {
+         if (!(lambda > 0.0))
+            return 0.0;
+         else if (lambda < 10.0)
+         {
+            const double limit = std::exp(-lambda);
+
+            double k    = 0.0;
+            double prod = u();
+
+            while (prod > limit)
+            {
+               k    += 1.0;
+               prod *= u();
+            }
+
+            return k;
+         }
+
+         const double slam     = std::sqrt(lambda);
+         const double loglam   = std::log (lambda);
+         const double b        = 0.931 + 2.53 * slam;
+         const double a        = -0.059 + 0.02483 * b;
+         const double invalpha = 1.1239 + 1.1328 / (b - 3.4);
+         const double vr       = 0.9277 - 3.6224 / (b - 2.0);
+
+         for ( ; ; )
+         {
+            const double U  = u() - 0.5;
+            const double V  = u();
+            const double us = 0.5 - std::abs(U);
+            const double k  = std::floor((2.0 * a / us + b) * U + lambda + 0.43);
+
+            if ((us >= 0.07) && (V <= vr))
+               return k;
+            else if ((k < 0.0) || ((us < 0.013) && (V > us)))
+               continue;
+            else if (
+                      (std::log(V) + std::log(invalpha) - std::log(a / (us * us) + b)) <=
+                      (-lambda + k * loglam - log_gamma(k + 1.0))
+                    )
+               return k;
+         }
+      }
+
+      template <typename T>
+      inline void fill_poisson(const generator& g, const dword_t base,
+                               T* data, const std::size_t size, const double lambda)
+      {
+         for (std::size_t i = 0; i < size; ++i)
+         {
+            element_source u(g, base + i);
+            data[i] = T(poisson_variate(u, lambda));
+         }
+      }
+
+      #ifdef exprtk_parallel_vecops_enabled
+      template <typename T, typename Kernel>
+      inline void parallel_fill_pairs(const generator& g, const dword_t base,
+                                      T* data, const std::size_t size, const Kernel& kernel)
+      {
+         const std::size_t thread_count = exprtk::rtl::vecops::details::
+            parallel_thread_count(size, exprtk_parallel_vecops_threshold);
+
+         if (thread_count <= 1)
+         {
+            fill_pairs(g, base, data, size, kernel);
+            return;
+         }
+
+         // Chunks start on even offsets so as to preserve block alignment
+         const std::size_t chunk_size = (((size / thread_count) + 1) / 2) * 2;
+
+         exprtk::rtl::vecops::details::parallel_for(thread_count,
+            [&](const std::size_t t)
+            {
+               const std::size_t begin = std::min(size, t * chunk_size);
+               const std::size_t end   = (t + 1 == thread_count) ? size : std::min(size, begin + chunk_size);
+
+               fill_pairs(g, base + (begin / 2), data + begin, end - begin, kernel);
+            });
+      }
+
+      template <typename T>
+      inline void parallel_fill_poisson(const generator& g, const dword_t base,
+                                        T* data, const std::size_t size, const double lambda)
+      {
+         const std::size_t thread_count = exprtk::rtl::vecops::details::
+            parallel_thread_count(size, exprtk_parallel_vecops_threshold);
+
+         if (thread_count <= 1)
+         {
+            fill_poisson(g, base, data, size, lambda);
+            return;
+         }
+
+         const std::size_t chunk_size = (size + thread_count - 1) / thread_count;
+
+         exprtk::rtl::vecops::details::parallel_for(thread_count,
+            [&](const std::size_t t)
+            {
+               const std::size_t begin = std::min(size, t * chunk_size);
+               const std::size_t end   = std::min(size, begin + chunk_size);
+
+               fill_poisson(g, base + begin, data + begin, end - begin, lambda);
+            });
+      }
+      #endif
+
+      template <typename T, typename Kernel>
+      inline void fill_vector(generator& g, T* data, const std::size_t size, const Kernel& kernel)
+      {
+         const dword_t base = g.reserve((size + 1) / 2);
+
+         #ifdef exprtk_parallel_vecops_enabled
+         parallel_fill_pairs(g, base, data, size, kernel);
+         #else
+         fill_pairs(g, base, data, size, kernel);
+         #endif
+      }
+
+      template <typename T>
+      inline void fill_vector_poisson(generator& g, T* data, const std::size_t size, const double lambda)
+      {
+         const dword_t base = g.reserve(size);
+
+         #ifdef exprtk_parallel_vecops_enabled
+         parallel_fill_poisson(g, base, data, size, lambda);
+         #else
+         fill_poisson(g, base, data, size, lambda);
+         #endif
+      }
+
+      template <typename T, typename Kernel>
+      inline T scalar_variate(generator& g, const Kernel& kernel)
+      {
+         word_t w[4];
+         T x0 = T(0);
+         T x1 = T(0);
+
+         g.block(g.reserve(1), 0, w);
+         kernel(w, x0, x1);
+
+         return x0;
+      }
+   } // namespace exprtk::rtl::random::details
+
+   template <typename T>
+   class seed exprtk_final : public exprtk::igeneric_function<T>
+   {
+   public:
+
+      typedef typename exprtk::igeneric_function<T> igfun_t;
+      typedef typename igfun_t::parameter_list_t    parameter_list_t;
+      typedef typename igfun_t::generic_type        generic_type;
+      typedef typename generic_type::scalar_view    scalar_t;
+
+      using igfun_t::operator();
+
+      explicit seed(generator& g)
+      : exprtk::igeneric_function<T>("T|TT")
+      /*
+         Overloads:
+         0. T  - seed
+         1. TT - seed, stream
+      */
+      , generator_(g)
+      {}
+
+      inline T operator() (const std::size_t& ps_index, parameter_list_t parameters) exprtk_override
+      {
+         const details::dword_t seed_value = exprtk::details::numeric::to_uint64(scalar_t(parameters[0])());
+         const details::word_t  stream     = (1 == ps_index) ?
+                                             static_cast<details::word_t>(exprtk::details::numeric::to_uint64(scalar_t(parameters[1])())) :
+                                             details::word_t(0);
+
+         generator_.reseed(seed_value, stream);
+
+         return T(1);
+      }
+
+   private:
+
+      generator& generator_;
+   };
+
+   template <typename T>
+   class uniform exprtk_final : public exprtk::igeneric_function<T>
+   {
+   public:
+
+      typedef typename exprtk::igeneric_function<T> igfun_t;
+      typedef typename igfun_t::parameter_list_t    parameter_list_t;
+      typedef typename igfun_t::generic_type        generic_type;
+      typedef typename generic_type::scalar_view    scalar_t;
+      typedef typename generic_type::vector_view    vector_t;
+
+      using igfun_t::operator();
+
+      explicit uniform(generator& g)
+      : exprtk::igeneric_function<T>("Z|TT|V|VTT")
+      /*
+         Overloads:
+         0. Z   - U[0,1)
+         1. TT  - U[a,b)
+         2. V   - fill vector with U[0,1)
+         3. VTT - fill vector with U[a,b)
+      */
+      , generator_(g)
+      {}
+
+      inline T operator() (const std::size_t& ps_index, parameter_list_t parameters) exprtk_override
+      {
+         switch (ps_index)
+         {
+            case 0  : return details::scalar_variate<T>(generator_, kernel_t(T(0), T(1)));
+
+            case 1  : return details::scalar_variate<T>(generator_,
+                                kernel_t(scalar_t(parameters[0])(), scalar_t(parameters[1])()));
+
+            case 2  : {
+                         vector_t vec(parameters[0]);
+                         details::fill_vector(generator_, vec.begin(), vec.size(), kernel_t(T(0), T(1)));
+                      }
+                      break;
+
+            case 3  : {
+                         vector_t vec(parameters[0]);
+                         details::fill_vector(generator_, vec.begin(), vec.size(),
+                            kernel_t(scalar_t(parameters[1])(), scalar_t(parameters[2])()));
+                      }
+                      break;
+
+            default : return std::numeric_limits<T>::quiet_NaN();
+         }
+
+         return T(1);
+      }
+
+   private:
+
+      typedef details::uniform_kernel<T> kernel_t;
+
+      generator& generator_;
+   };
+
+   template <typename T>
+   class normal exprtk_final : public exprtk::igeneric_function<T>
+   {
+   public:
+
+      typedef typename exprtk::igeneric_function<T> igfun_t;
+      typedef typename igfun_t::parameter_list_t    parameter_list_t;
+      typedef typename igfun_t::generic_type        generic_type;
+      typedef typename generic_type::scalar_view    scalar_t;
+      typedef typename generic_type::vector_view    vector_t;
+
+      using igfun_t::operator();
+
+      explicit normal(generator& g)
+      : exprtk::igeneric_function<T>("Z|TT|V|VTT")
+      /*
+         Overloads:
+         0. Z   - N(0,1)
+         1. TT  - N(mean,stddev)
+         2. V   - fill vector with N(0,1)
+         3. VTT - fill vector with N(mean,stddev)
+      */
+      , generator_(g)
+      {}
+
+      inline T operator() (const std::size_t& ps_index, parameter_list_t parameters) exprtk_override
+      {
+         switch (ps_index)
+         {
+            case 0  : return details::scalar_variate<T>(generator_, kernel_t(T(0), T(1)));
+
+            case 1  : return details::scalar_variate<T>(generator_,
+                                kernel_t(scalar_t(parameters[0])(), scalar_t(parameters[1])()));
+
+            case 2  : {
+                         vector_t vec(parameters[0]);
+                         details::fill_vector(generator_, vec.begin(), vec.size(), kernel_t(T(0), T(1)));
+                      }
+                      break;
+
+            case 3  : {
+                         vector_t vec(parameters[0]);
+                         details::fill_vector(generator_, vec.begin(), vec.size(),
+                            kernel_t(scalar_t(parameters[1])(), scalar_t(parameters[2])()));
+                      }
+                      break;
+
+            default : return std::numeric_limits<T>::quiet_NaN();
+         }
+
+         return T(1);
+      }
+
+   private:
+
+      typedef details::normal_kernel<T> kernel_t;
+
+      generator& generator_;
+   };
+
+   template <typename T>
+   class poisson exprtk_final : public exprtk::igeneric_function<T>
+   {
+   public:
+
+      typedef typename exprtk::igeneric_function<T> igfun_t;
+      typedef typename igfun_t::parameter_list_t    parameter_list_t;
+      typedef typename igfun_t::generic_type        generic_type;
+      typedef typename generic_type::scalar_view    scalar_t;
+      typedef typename generic_type::vector_view    vector_t;
+
+      using igfun_t::operator();
+
+      explicit poisson(generator& g)
+      : exprtk::igeneric_function<T>("T|VT")
+      /*
+         Overloads:
+         0. T  - Poisson(lambda)
+         1. VT - fill vector with Poisson(lambda)
+      */
+      , generator_(g)
+      {}
+
+      inline T operator() (const std::size_t& ps_index, parameter_list_t parameters) exprtk_override
+      {
+         if (0 == ps_index)
+         {
+            details::element_source u(generator_, generator_.reserve(1));
+            return T(details::poisson_variate(u, static_cast<double>(scalar_t(parameters[0])())));
+         }
+
+         vector_t vec(parameters[0]);
+
+         details::fill_vector_poisson(generator_, vec.begin(), vec.size(),
+                                      static_cast<double>(scalar_t(parameters[1])()));
+
+         return T(1);
+      }
+
+   private:
+
+      generator& generator_;
+   };
+
+   template <typename T>
+   struct package
+   {
+      explicit package(const generator::dword_t seed_value = 0x853C49E6748FEA9BULL,
+                       const generator::word_t  stream     = 0)
+      : gen (seed_value, stream)
+      , sd  (gen)
+      , unf (gen)
+      , nrm (gen)
+      , psn (gen)
+      {}
+
+      generator  gen;
+      seed   <T> sd;
+      uniform<T> unf;
+      normal <T> nrm;
+      poisson<T> psn;
+
+      bool register_package(exprtk::symbol_table<T>& symtab)
+      {
+         #define exprtk_register_function(FunctionName, FunctionType)                 \
+         if (!symtab.add_function(FunctionName,FunctionType))                         \
+         {                                                                            \
+            exprtk_debug((                                                            \
+              "exprtk::rtl::random::register_package - Failed to add function: %s\n", \
+              FunctionName));                                                         \
+            return false;                                                             \
+         }                                                                            \
+
+         exprtk_register_function("rnd_seed"    , sd )
+         exprtk_register_function("rnd_uniform" , unf)
+         exprtk_register_function("rnd_normal"  , nrm)
+         exprtk_register_function("rnd_poisson" , psn)
+
+         #undef exprtk_register_function
+
+         return true;
+      }
+
+   private:
+
+      package(const package<T>&) exprtk_delete;
+      package<T>& operator=(const package<T>&) exprtk_delete;
+   };
+
+   } // namespace exprtk::rtl::random
+   } // namespace exprtk::rtl
+}    // namespace exprtk
+#endif
+
 namespace exprtk
 {
    namespace information
@@ -46617,6 +53406,22 @@ namespace exprtk
    #undef exprtk_delete
    #endif
 
+   #ifdef exprtk_parallel_vecops_enabled
+   #undef exprtk_parallel_vecops_enabled
+   #endif
+
+   #ifdef exprtk_parallel_expression_graph_enabled
+   #undef exprtk_parallel_expression_graph_enabled
+   #endif
+
+   #ifdef exprtk_simd_vecops_avx
+   #undef exprtk_simd_vecops_avx
+   #endif
+
+   #ifdef exprtk_simd_vecops_sse2
+   #undef exprtk_simd_vecops_sse2
+   #endif
+
 } // namespace exprtk
 
 #endif
@@ -0,0 +1,228 @@
+/*
+ **************************************************************
+ *         C++ Mathematical Expression Toolkit Library        *
+ *                                                            *
+ * ExprTk Steady-State Allocation Check                       *
+ * Author: Arash Partow (1999-2025)                           *
+ * URL: https://www.partow.net/programming/exprtk/index.html  *
+ *                                                            *
+ * Copyright notice:                                          *
+ * Free use of the Mathematical Expression Toolkit Library is *
+ * permitted under the guidelines and in accordance with the  *
+ * most current version of the MIT License.                   *
+ * https://www.opensource.org/licenses/MIT                    *
+ * SPDX-License-Identifier: MIT                               *
+ *                                                            *
+ **************************************************************
+*/
+
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "exprtk.hpp"
+#include "exprtk_allocation_counter.hpp"
+
+
+// Sum of |v[i]|^p over [r0,r1], with the same overloads as the L-norm example
+template <typename T>
+struct power_sum : public exprtk::igeneric_function<T>
+{
+   typedef typename exprtk::igeneric_function<T> igfun_t;
+   typedef typename igfun_t::parameter_list_t    parameter_list_t;
+   typedef typename igfun_t::generic_type        generic_type;
+   typedef typename generic_type::scalar_view    scalar_t;
+   typedef typename generic_type::vector_view    vector_t;
+
+   using exprtk::igeneric_function<T>::operator();
+
+   power_sum()
+   : exprtk::igeneric_function<T>("V|VTT|VT|VTTT")
+   {}
+
+   inline T operator()(const std::size_t& ps_index, parameter_list_t parameters)
+   {
+      const vector_t vec(parameters[0]);
+
+      T p = T(1);
+
+      std::size_t r0 = 0;
+      std::size_t r1 = vec.size() - 1;
+
+      if ((2 == ps_index) || (3 == ps_index))
+      {
+         p = scalar_t(parameters[1])();
+      }
+
+      if ((1 == ps_index) || (3 == ps_index))
+      {
+         if (
+              !scalar_t(parameters[(1 == ps_index) ? 1 : 2]).to_uint(r0) ||
+              !scalar_t(parameters[(1 == ps_index) ? 2 : 3]).to_uint(r1)
+            )
+            return std::numeric_limits<T>::quiet_NaN();
+      }
+
+      T sum = T(0);
+
+      for (std::size_t i = r0; i <= r1; ++i)
+      {
+         sum += std::pow(std::abs(vec[i]), p);
+      }
+
+      return sum;
+   }
+};
+
+template <typename T>
+bool allocation_check(const std::string& title,
+                      exprtk::symbol_table<T>& symbol_table,
+                      const std::string program[],
+                      const std::size_t program_count)
+{
+   typedef exprtk::expression<T> expression_t;
+   typedef exprtk::parser<T>     parser_t;
+
+   printf("--- %s ---\n", title.c_str());
+
+   parser_t parser;
+
+   std::size_t failures = 0;
+
+   for (std::size_t i = 0; i < program_count; ++i)
+   {
+      expression_t expression;
+      expression.register_symbol_table(symbol_table);
+
+      if (!parser.compile(program[i], expression))
+      {
+         printf("Error: %s\tExpression: %s\n",
+                parser.error().c_str(),
+                program[i].c_str());
+
+         ++failures;
+         continue;
+      }
+
+      const std::size_t before = allocation_counter::count;
+
+      T result = T(0);
+
+      for (std::size_t j = 0; j < 1000; ++j)
+      {
+         result = expression.value();
+      }
+
+      const std::size_t allocations = allocation_counter::count - before;
+
+      printf("[%02d] result: %12.4f allocations over 1000 evaluations: %d %s\n",
+             static_cast<int>(i),
+             result,
+             static_cast<int>(allocations),
+             (0 == allocations) ? "OK" : "FAIL");
+
+      if (allocations)
+      {
+         ++failures;
+      }
+   }
+
+   return (0 == failures);
+}
+
+template <typename T>
+bool generic_function_allocation_check()
+{
+   typedef exprtk::symbol_table<T> symbol_table_t;
+
+   T x[] = { T(1), T(2), T(3), T(4), T(5) };
+
+   std::vector<T> y(5, T(3));
+
+   symbol_table_t symbol_table;
+   symbol_table.add_vector("x", x);
+   symbol_table.add_vector("y", y);
+
+   power_sum<T> power_sum_;
+
+   symbol_table.add_function("psum", power_sum_);
+
+   // Every overload, with vector temporaries and returned results
+   const std::string program[] =
+      {
+         " psum(x)                                      ",
+         " psum(x,1,3)                                  ",
+         " psum(x,3)                                    ",
+         " psum(2x+y,4,1,3)                             ",
+         " psum(2x+y/3-4,40)                            ",
+         " return [psum(x), psum(x,3), x, 'psum']       ",
+         " var v[5] := x + y; return [psum(v,1,3), v];  "
+      };
+
+   return allocation_check<T>("generic functions and return",
+                              symbol_table,
+                              program, sizeof(program) / sizeof(std::string));
+}
+
+template <typename T>
+bool string_allocation_check()
+{
+   typedef exprtk::symbol_table<T> symbol_table_t;
+
+   std::string expression = "12 + 345 * 6789 - 10 / 2 + 7 * 11 - 13";
+   std::string prefix     = "evaluating the arithmetic expression: ";
+
+   symbol_table_t symbol_table;
+   symbol_table.add_stringvar("expression", expression);
+   symbol_table.add_stringvar("prefix"    , prefix    );
+
+   /*
+      Local strings, concatenations and ranged comparisons longer than
+      the small-string buffer. Their buffers are sized when compiled,
+      so not even the first evaluation allocates.
+   */
+   const std::string program[] =
+      {
+         " var s := prefix + expression; s[]                                        ",
+         " var s := prefix; s := s + expression + prefix; s[]                       ",
+         " var s := ''; s := (prefix + expression)[3:40]; s[]                       ",
+         " var s := expression[] > 10 ? prefix + expression : expression; s[]       ",
+         " prefix[0:30] == (prefix + expression)[0:30]                              ",
+         " (prefix + expression) like '*arithmetic*'                                ",
+         " var n := 0;                                                              "
+         " for (var i := 0; i < expression[]; i += 1)                               "
+         " {                                                                        "
+         "    var c := expression[i : i + 1];                                       "
+         "    var t := expression[i : expression[] - 1];                            "
+         "    if ((c == '+') and (t[] > 16)) n += 1;                                "
+         " };                                                                       "
+         " n                                                                        "
+      };
+
+   return allocation_check<T>("strings",
+                              symbol_table,
+                              program, sizeof(program) / sizeof(std::string));
+}
+
+int main()
+{
+   const bool generic_function_result = generic_function_allocation_check<double>();
+   const bool string_result           = string_allocation_check<double>();
+
+   const bool passed = generic_function_result && string_result;
+
+   printf("allocation check: %s\n", passed ? "PASSED" : "FAILED");
+
+   return passed ? 0 : 1;
+}
+
+
+/*
+
+   Build:
+   c++ -pedantic-errors -Wall -Wextra -Werror -O3 -DNDEBUG -o exprtk_allocation_benchmark exprtk_allocation_benchmark.cpp -L/usr/lib -lstdc++ -lm
+
+*/
@@ -0,0 +1,107 @@
+/*
+ **************************************************************
+ *           C++ Mathematical Expression Toolkit Library      *
+ *                                                            *
+ * Author: Arash Partow (1999-2025)                           *
+ * URL: https://www.partow.net/programming/exprtk/index.html  *
+ *                                                            *
+ * Copyright notice:                                          *
+ * Free use of the Mathematical Expression Toolkit Library is *
+ * permitted under the guidelines and in accordance with the  *
+ * most current version of the MIT License.                   *
+ * https://www.opensource.org/licenses/MIT                    *
+ * SPDX-License-Identifier: MIT                               *
+ *                                                            *
+ **************************************************************
+*/
+
+
+#ifndef INCLUDE_EXPRTK_ALLOCATION_COUNTER_HPP
+#define INCLUDE_EXPRTK_ALLOCATION_COUNTER_HPP
+
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+
+/*
+   Replaces the global operator new and delete with versions that
+   record the number of allocations, the bytes currently held and
+   their peak. Being replacements of the global operators, this
+   header must be included in exactly one translation unit of a
+   program, and the counters are not thread-safe.
+*/
+
+// The size header lies outside the bounds GCC sees for the allocated object
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#if (__GNUC__ >= 11)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+#endif
+
+namespace allocation_counter
+{
+   static std::size_t count = 0;
+   static std::size_t bytes = 0;
+   static std::size_t peak  = 0;
+
+   // Each block is prefixed with its size, padded to keep the alignment of new
+   static const std::size_t header_size = 16;
+
+   inline void reset_peak()
+   {
+      peak = bytes;
+   }
+
+   inline void release(void* ptr)
+   {
+      if (0 == ptr)
+         return;
+
+      char* base = static_cast<char*>(ptr) - header_size;
+
+      bytes -= *reinterpret_cast<std::size_t*>(base);
+
+      std::free(base);
+   }
+}
+
+void* operator new(std::size_t size)
+{
+   char* ptr = static_cast<char*>(std::malloc(size + allocation_counter::header_size));
+
+   if (0 == ptr)
+   {
+      throw std::bad_alloc();
+   }
+
+   *reinterpret_cast<std::size_t*>(ptr) = size;
+
+   ++allocation_counter::count;
+
+   if ((allocation_counter::bytes += size) > allocation_counter::peak)
+   {
+      allocation_counter::peak = allocation_counter::bytes;
+   }
+
+   return ptr + allocation_counter::header_size;
+}
+
+void operator delete(void* ptr) noexcept
+{
+   allocation_counter::release(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+   allocation_counter::release(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
@@ -17,8 +17,10 @@
 */
 
 
+#include <cmath>
 #include <cstdio>
 #include <string>
+#include <vector>
 
 #include "exprtk.hpp"
 
@@ -147,6 +149,8 @@ void black_scholes_merton_model()
    expression_t bsm_expression_opt1(symbol_table);
    expression_t bsm_expression_opt2(symbol_table);
    expression_t bsm_expression_opt3(symbol_table);
+   expression_t bsm_expression_cse (symbol_table);
+   expression_t bsm_expression_apx (symbol_table);
 
    parser_t parser;
 
@@ -155,6 +159,18 @@ void black_scholes_merton_model()
    parser.compile(bsm_model_program_opt2, bsm_expression_opt2);
    parser.compile(bsm_model_program_opt3, bsm_expression_opt3);
 
+   // The naive program, with repeated subexpressions eliminated by the parser
+   parser_t cse_parser(parser_t::settings_t::default_compile_all_opts +
+                       parser_t::settings_t::e_common_subexpr_elim);
+
+   cse_parser.compile(bsm_model_program, bsm_expression_cse);
+
+   // The opt1 program, with exp, log and ncdf evaluated by polynomial approximations
+   parser_t approx_parser(parser_t::settings_t::default_compile_all_opts +
+                          parser_t::settings_t::e_approximations);
+
+   approx_parser.compile(bsm_model_program_opt1, bsm_expression_apx);
+
    {
       exprtk::timer timer;
       timer.start();
@@ -266,6 +282,62 @@ void black_scholes_merton_model()
              (2.0 * rounds) / timer.time(),
              1e9 / ((2.0 * rounds) / timer.time()));
    }
+
+   {
+      exprtk::timer timer;
+      timer.start();
+
+      T total = T(0);
+
+      for (std::size_t i = 0; i < rounds; ++i)
+      {
+         const bsm_parameters<T>& current_parameters = bsm_list[i % bsm_list_size];
+
+         parameters = current_parameters;
+
+         callput_flag = "call";
+         total += bsm_expression_cse.value();
+
+         callput_flag = "put";
+         total += bsm_expression_cse.value();
+      }
+
+      timer.stop();
+
+      printf("[exprtkC] Total: %13.5f Time:%6.3fsec Rate:%13.3fbsm/sec execrt: %6.3fns\n",
+             total,
+             timer.time(),
+             (2.0 * rounds) / timer.time(),
+             1e9 / ((2.0 * rounds) / timer.time()));
+   }
+
+   {
+      exprtk::timer timer;
+      timer.start();
+
+      T total = T(0);
+
+      for (std::size_t i = 0; i < rounds; ++i)
+      {
+         const bsm_parameters<T>& current_parameters = bsm_list[i % bsm_list_size];
+
+         parameters = current_parameters;
+
+         callput_flag = "call";
+         total += bsm_expression_apx.value();
+
+         callput_flag = "put";
+         total += bsm_expression_apx.value();
+      }
+
+      timer.stop();
+
+      printf("[exprtkA] Total: %13.5f Time:%6.3fsec Rate:%13.3fbsm/sec execrt: %6.3fns\n",
+             total,
+             timer.time(),
+             (2.0 * rounds) / timer.time(),
+             1e9 / ((2.0 * rounds) / timer.time()));
+   }
 }
 
 template <typename T>
@@ -319,10 +391,131 @@ void bsm_native()
           1e9 / ((2.0 * rounds) / timer.time()));
 }
 
+long double reference_exp (long double x) { return std::exp (x); }
+long double reference_log (long double x) { return std::log (x); }
+long double reference_sin (long double x) { return std::sin (x); }
+long double reference_cos (long double x) { return std::cos (x); }
+long double reference_erf (long double x) { return std::erf (x); }
+long double reference_ncdf(long double x) { return 0.5L * std::erfc(-x / std::sqrt(2.0L)); }
+
+// Error of value in units of the last place of the double nearest to reference
+double ulp_error(const double value, const long double reference)
+{
+   if (value == static_cast<double>(reference))
+      return 0.0;
+
+   int exponent = 0;
+   std::frexp(static_cast<double>(reference), &exponent);
+
+   const long double ulp = std::ldexp(1.0L, std::max(exponent - 53, -1074));
+
+   return static_cast<double>(std::abs(value - reference) / ulp);
+}
+
+void approximation_table()
+{
+   namespace numeric = exprtk::details::numeric;
+   namespace approx  = exprtk::details::numeric::approx;
+
+   typedef double      (*function_t )(const double);
+   typedef void        (*batch_t    )(const double*, double*, const std::size_t);
+   typedef long double (*reference_t)(long double);
+
+   struct approximation_t
+   {
+      const char* name;
+      function_t  standard;
+      function_t  scalar;
+      batch_t     batch;
+      reference_t reference;
+      double      lower;
+      double      upper;
+   };
+
+   const approximation_t approximation_list[] =
+      {
+         { "exp" , numeric::exp <double>, approx::exp , approx::exp , reference_exp , -20.0, 20.0 },
+         { "log" , numeric::log <double>, approx::log , approx::log , reference_log ,   0.0, 10.0 },
+         { "sin" , numeric::sin <double>, approx::sin , approx::sin , reference_sin , -10.0, 10.0 },
+         { "cos" , numeric::cos <double>, approx::cos , approx::cos , reference_cos , -10.0, 10.0 },
+         { "erf" , numeric::erf <double>, approx::erf , approx::erf , reference_erf ,  -4.0,  4.0 },
+         { "ncdf", numeric::ncdf<double>, approx::ncdf, approx::ncdf, reference_ncdf, -10.0, 10.0 }
+      };
+
+   const std::size_t approximation_count = sizeof(approximation_list) / sizeof(approximation_t);
+
+   const std::size_t count  = 100000;
+   const std::size_t passes = 100;
+
+   std::vector<double> x(count);
+   std::vector<double> y(count);
+
+   printf("\nfunction  std max ulp  apx max ulp   std ns/call  apx ns/call  batch ns/value\n");
+
+   for (std::size_t i = 0; i < approximation_count; ++i)
+   {
+      const approximation_t& a = approximation_list[i];
+
+      for (std::size_t j = 0; j < count; ++j)
+      {
+         x[j] = a.lower + (a.upper - a.lower) * (j + 0.5) / count;
+      }
+
+      double standard_ulp = 0.0;
+      double scalar_ulp   = 0.0;
+
+      for (std::size_t j = 0; j < count; ++j)
+      {
+         const long double reference = a.reference(x[j]);
+
+         standard_ulp = std::max(standard_ulp, ulp_error(a.standard(x[j]), reference));
+         scalar_ulp   = std::max(scalar_ulp  , ulp_error(a.scalar  (x[j]), reference));
+      }
+
+      double time[3] = { 0.0, 0.0, 0.0 };
+      double total   = 0.0;
+
+      for (std::size_t form = 0; form < 3; ++form)
+      {
+         exprtk::timer timer;
+         timer.start();
+
+         for (std::size_t pass = 0; pass < passes; ++pass)
+         {
+            if (2 == form)
+               a.batch(&x[0], &y[0], count);
+            else
+            {
+               const function_t f = (0 == form) ? a.standard : a.scalar;
+
+               for (std::size_t j = 0; j < count; ++j)
+               {
+                  y[j] = f(x[j]);
+               }
+            }
+
+            total += y[pass];
+         }
+
+         timer.stop();
+
+         time[form] = 1e9 * timer.time() / (passes * count);
+      }
+
+      printf("%-8s %12.3f %12.3f %13.3f %12.3f %15.3f %s\n",
+             a.name,
+             standard_ulp,
+             scalar_ulp,
+             time[0], time[1], time[2],
+             (total != total) ? "NaN" : "");
+   }
+}
+
 int main()
 {
    black_scholes_merton_model<double>();
    bsm_native<double>();
+   approximation_table();
    return 0;
 }
 
@@ -0,0 +1,433 @@
+/*
+ **************************************************************
+ *         C++ Mathematical Expression Toolkit Library        *
+ *                                                            *
+ * ExprTk Compile-Time Scaling Benchmark                      *
+ * Author: Arash Partow (1999-2025)                           *
+ * URL: https://www.partow.net/programming/exprtk/index.html  *
+ *                                                            *
+ * Copyright notice:                                          *
+ * Free use of the Mathematical Expression Toolkit Library is *
+ * permitted under the guidelines and in accordance with the  *
+ * most current version of the MIT License.                   *
+ * https://www.opensource.org/licenses/MIT                    *
+ * SPDX-License-Identifier: MIT                               *
+ *                                                            *
+ **************************************************************
+*/
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "exprtk.hpp"
+#include "exprtk_allocation_counter.hpp"
+
+
+template <typename T>
+struct compile_benchmark
+{
+   typedef exprtk::symbol_table<T>         symbol_table_t;
+   typedef exprtk::expression<T>           expression_t;
+   typedef exprtk::parser<T>               parser_t;
+   typedef exprtk::function_compositor<T>  compositor_t;
+   typedef typename compositor_t::function function_t;
+
+   enum stage_t { e_total, e_lexer, e_helpers, e_parser, e_definitions, e_stage_count };
+
+   struct sample_t
+   {
+      std::size_t size;
+      std::size_t tokens;
+      std::size_t nodes;
+      std::size_t peak_bytes;
+      double      time[e_stage_count];
+   };
+
+   typedef std::string (*generator_t)(const std::size_t);
+
+   compile_benchmark()
+   : x(T(1))
+   , y(T(2))
+   , z(T(3))
+   , operator_joiner_2(2)
+   , operator_joiner_3(3)
+   {
+      symbol_table.add_variable("x", x);
+      symbol_table.add_variable("y", y);
+      symbol_table.add_variable("z", z);
+      symbol_table.add_constants();
+
+      for (std::size_t i = 0; i < exprtk::details::reserved_words_size; ++i)
+      {
+         commutative_inserter.ignore_symbol(exprtk::details::reserved_words[i]);
+      }
+
+      symbol_replacer.add_replace("true" , "1", exprtk::lexer::token::e_number);
+      symbol_replacer.add_replace("false", "0", exprtk::lexer::token::e_number);
+
+      // The token helpers the parser registers under its default settings
+      helper_assembly.register_inserter(&commutative_inserter    );
+      helper_assembly.register_joiner  (&operator_joiner_2       );
+      helper_assembly.register_joiner  (&operator_joiner_3       );
+      helper_assembly.register_modifier(&symbol_replacer         );
+      helper_assembly.register_scanner (&numeric_checker         );
+      helper_assembly.register_scanner (&bracket_checker         );
+      helper_assembly.register_scanner (&sequence_validator      );
+      helper_assembly.register_scanner (&sequence_validator_3tkns);
+   }
+
+   // n statements over the same three variables
+   static std::string statements(const std::size_t n)
+   {
+      std::string program;
+
+      for (std::size_t i = 0; i < n; ++i)
+      {
+         program += "x := (x + 1.5) * y - sin(z) / (y + " + exprtk::details::to_str(static_cast<int>(i % 7)) + "); ";
+      }
+
+      return program + "x;";
+   }
+
+   // Conditionals and blocks nested d deep
+   static std::string nesting(const std::size_t d)
+   {
+      std::string program = "x";
+
+      for (std::size_t i = 0; i < d; ++i)
+      {
+         const std::string i_str = exprtk::details::to_str(static_cast<int>(i));
+
+         program = "if (x > " + i_str + ") { x += (y * " + i_str + "); " + program + "; } else (x - " + i_str + ")";
+      }
+
+      return program;
+   }
+
+   // n local variables, each defined from the previous one
+   static std::string symbols(const std::size_t n)
+   {
+      std::string program = "var v0 := x; ";
+
+      for (std::size_t i = 1; i < n; ++i)
+      {
+         program += "var v" + exprtk::details::to_str(static_cast<int>(i    )) + " := v" +
+                              exprtk::details::to_str(static_cast<int>(i - 1)) + " + y; ";
+      }
+
+      return program + "v" + exprtk::details::to_str(static_cast<int>(n - 1)) + ";";
+   }
+
+   // A call to each of n functions defined through the compositor
+   static std::string function_calls(const std::size_t n)
+   {
+      std::string program = "0";
+
+      for (std::size_t i = 0; i < n; ++i)
+      {
+         program += " + f" + exprtk::details::to_str(static_cast<int>(i)) + "(x)";
+      }
+
+      return program + ";";
+   }
+
+   bool define_functions(compositor_t& compositor, const std::size_t n)
+   {
+      for (std::size_t i = 0; i < n; ++i)
+      {
+         const std::string body = (0 == i) ? "a + 1" :
+                                  "f" + exprtk::details::to_str(static_cast<int>(i - 1)) + "(a) / 2 + " +
+                                  exprtk::details::to_str(static_cast<int>(i));
+
+         if (!compositor.add(function_t("f" + exprtk::details::to_str(static_cast<int>(i))).var("a").expression(body)))
+         {
+            return false;
+         }
+      }
+
+      return true;
+   }
+
+   /*
+      Compiles the program generated for the given size, repeating each
+      measurement until it has run for at least 50ms, and records the
+      mean time of each stage. The parser stage is the remainder of the
+      compile after lexing and the token helpers.
+   */
+   bool measure(generator_t generator, const std::size_t size, const bool with_functions, sample_t& sample)
+   {
+      const std::string program = generator(size);
+
+      parser_t parser;
+      parser.settings().set_max_stack_depth(100 * size + 400);
+      parser.settings().set_max_node_depth (100 * size + 10000);
+
+      sample.size = size;
+
+      for (std::size_t i = 0; i < e_stage_count; ++i)
+      {
+         sample.time[i] = 0.0;
+      }
+
+      std::size_t rounds = 0;
+
+      exprtk::timer timer;
+
+      while ((0 == rounds) || (sample.time[e_total] < 0.05))
+      {
+         symbol_table_t function_symtab;
+         compositor_t   compositor(function_symtab);
+
+         timer.start();
+
+         if (with_functions && !define_functions(compositor, size))
+         {
+            printf("Error: failed to define %d functions\n", static_cast<int>(size));
+            return false;
+         }
+
+         timer.stop();
+
+         sample.time[e_definitions] += timer.time();
+
+         expression_t expression;
+         expression.register_symbol_table(symbol_table   );
+         expression.register_symbol_table(function_symtab);
+
+         const std::size_t base_bytes = allocation_counter::bytes;
+         allocation_counter::reset_peak();
+
+         timer.start();
+
+         if (!parser.compile(program, expression))
+         {
+            printf("Error: %s\n", parser.error().c_str());
+            return false;
+         }
+
+         timer.stop();
+
+         sample.time[e_total] += timer.time();
+         sample.peak_bytes     = allocation_counter::peak - base_bytes;
+         sample.nodes          = expression.node_count();
+
+         ++rounds;
+      }
+
+      for (std::size_t i = 0; i < rounds; ++i)
+      {
+         exprtk::lexer::generator lexer;
+
+         timer.start();
+         lexer.process(program);
+         timer.stop();
+
+         sample.time[e_lexer] += timer.time();
+         sample.tokens = lexer.size();
+
+         timer.start();
+         helper_assembly.run_pipeline(lexer);
+         timer.stop();
+
+         sample.time[e_helpers] += timer.time();
+      }
+
+      for (std::size_t i = 0; i < e_stage_count; ++i)
+      {
+         sample.time[i] /= rounds;
+      }
+
+      sample.time[e_parser] = std::max(0.0, sample.time[e_total] - sample.time[e_lexer] - sample.time[e_helpers]);
+
+      return true;
+   }
+
+   /*
+      Least squares slope of log(time) against log(size) over the samples
+      that took at least 1ms, the exponent k of time ~ size^k.
+   */
+   static double scaling_exponent(const std::vector<sample_t>& samples, const stage_t stage)
+   {
+      double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+      std::size_t n = 0;
+
+      for (std::size_t i = 0; i < samples.size(); ++i)
+      {
+         if (samples[i].time[stage] < 0.001)
+            continue;
+
+         const double lx = std::log(static_cast<double>(samples[i].size));
+         const double ly = std::log(samples[i].time[stage]);
+
+         sx  += lx;
+         sy  += ly;
+         sxx += lx * lx;
+         sxy += lx * ly;
+         ++n;
+      }
+
+      if (n < 3)
+         return 0.0;
+
+      return (n * sxy - sx * sy) / (n * sxx - sx * sx);
+   }
+
+   bool run(const std::string& name, generator_t generator,
+            const std::size_t* sizes, const std::size_t size_count,
+            const bool with_functions, std::ofstream& data)
+   {
+      static const char* stage_name[] = { "compile", "lexer", "helpers", "parser", "definitions" };
+
+      std::vector<sample_t> samples;
+
+      printf("[%s]\n", name.c_str());
+      printf("   %7s %9s %9s %11s %9s %9s %9s %9s %11s\n",
+             "size", "tokens", "nodes", "compile(ms)", "lexer", "helpers", "parser",
+             with_functions ? "defs" : "", "peak(KB)");
+
+      data << "# " << name << "\n";
+
+      for (std::size_t i = 0; i < size_count; ++i)
+      {
+         sample_t sample;
+
+         if (!measure(generator, sizes[i], with_functions, sample))
+            return false;
+
+         samples.push_back(sample);
+
+         printf("   %7d %9d %9d %11.3f %9.3f %9.3f %9.3f ",
+                static_cast<int>(sample.size  ),
+                static_cast<int>(sample.tokens),
+                static_cast<int>(sample.nodes ),
+                1000.0 * sample.time[e_total  ],
+                1000.0 * sample.time[e_lexer  ],
+                1000.0 * sample.time[e_helpers],
+                1000.0 * sample.time[e_parser ]);
+
+         if (with_functions)
+            printf("%9.3f ", 1000.0 * sample.time[e_definitions]);
+         else
+            printf("%9s ", "");
+
+         printf("%11.1f\n", sample.peak_bytes / 1024.0);
+
+         data << sample.tokens << "\t"
+              << 1000.0 * (sample.time[e_total] + sample.time[e_definitions]) << "\t"
+              << sample.size << "\n";
+      }
+
+      data << "\n\n";
+
+      printf("   scaling:");
+
+      for (std::size_t stage = e_total; stage < e_stage_count; ++stage)
+      {
+         if ((e_definitions == stage) && !with_functions)
+            continue;
+
+         const double k = scaling_exponent(samples, static_cast<stage_t>(stage));
+
+         if (0.0 == k)
+            printf(" %s: n/a", stage_name[stage]);
+         else
+         {
+            printf(" %s: n^%4.2f%s", stage_name[stage], k, (k > 1.25) ? " (super-linear)" : "");
+         }
+      }
+
+      printf("\n\n");
+
+      return true;
+   }
+
+   T x;
+   T y;
+   T z;
+
+   symbol_table_t symbol_table;
+
+
+   exprtk::lexer::helper::operator_joiner            operator_joiner_2;
+   exprtk::lexer::helper::operator_joiner            operator_joiner_3;
+   exprtk::lexer::helper::helper_assembly            helper_assembly;
+   exprtk::lexer::helper::commutative_inserter       commutative_inserter;
+   exprtk::lexer::helper::symbol_replacer            symbol_replacer;
+   exprtk::lexer::helper::numeric_checker<T>         numeric_checker;
+   exprtk::lexer::helper::bracket_checker            bracket_checker;
+   exprtk::lexer::helper::sequence_validator         sequence_validator;
+   exprtk::lexer::helper::sequence_validator_3tokens sequence_validator_3tkns;
+};
+
+template <typename T>
+void compile_scaling_benchmark()
+{
+   typedef compile_benchmark<T> benchmark_t;
+
+   const std::size_t statement_sizes[] = { 1000, 2000, 4000, 8000, 16000, 32000 };
+   const std::size_t nesting_sizes  [] = {   25,   50,  100,  200,   400,   800 };
+   const std::size_t symbol_sizes   [] = {  250,  500, 1000, 2000,  4000,  8000 };
+   const std::size_t function_sizes [] = {   50,  100,  200,  400,   800,  1600 };
+
+   const std::size_t size_count = sizeof(statement_sizes) / sizeof(std::size_t);
+
+   std::ofstream data("compile_benchmark.dat");
+
+   if (!data)
+   {
+      printf("Error: failed to create compile_benchmark.dat\n");
+      return;
+   }
+
+   benchmark_t benchmark;
+
+   if (
+        !benchmark.run("statements", benchmark_t::statements    , statement_sizes, size_count, false, data) ||
+        !benchmark.run("nesting"   , benchmark_t::nesting       , nesting_sizes  , size_count, false, data) ||
+        !benchmark.run("symbols"   , benchmark_t::symbols       , symbol_sizes   , size_count, false, data) ||
+        !benchmark.run("functions" , benchmark_t::function_calls, function_sizes , size_count, true , data)
+      )
+   {
+      return;
+   }
+
+   std::ofstream script("compile_benchmark.gp");
+
+   if (!script)
+   {
+      printf("Error: failed to create compile_benchmark.gp\n");
+      return;
+   }
+
+   script << "set term png\n";
+   script << "set output 'compile_benchmark.png'\n";
+   script << "set logscale xy\n";
+   script << "set xlabel 'tokens'\n";
+   script << "set ylabel 'compile time (ms)'\n";
+   script << "set key left top\n";
+   script << "plot 'compile_benchmark.dat' index 0 using 1:2 with linespoints title 'statements', \\\n";
+   script << "     'compile_benchmark.dat' index 1 using 1:2 with linespoints title 'nesting'   , \\\n";
+   script << "     'compile_benchmark.dat' index 2 using 1:2 with linespoints title 'symbols'   , \\\n";
+   script << "     'compile_benchmark.dat' index 3 using 1:2 with linespoints title 'functions'   \n";
+
+   printf("Complexity curves: gnuplot compile_benchmark.gp\n");
+}
+
+int main()
+{
+   compile_scaling_benchmark<double>();
+   return 0;
+}
+
+
+/*
+
+   Build:
+   c++ -pedantic-errors -Wall -Wextra -Werror -O3 -DNDEBUG -o exprtk_compile_benchmark exprtk_compile_benchmark.cpp -L/usr/lib -lstdc++ -lm
+
+*/
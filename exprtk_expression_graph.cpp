@@ -0,0 +1,214 @@
+/*
+ **************************************************************
+ *         C++ Mathematical Expression Toolkit Library        *
+ *                                                            *
+ * ExprTk Incremental Expression Graph Evaluation             *
+ * Author: Arash Partow (1999-2025)                           *
+ * URL: https://www.partow.net/programming/exprtk/index.html  *
+ *                                                            *
+ * Copyright notice:                                          *
+ * Free use of the Mathematical Expression Toolkit Library is *
+ * permitted under the guidelines and in accordance with the  *
+ * most current version of the MIT License.                   *
+ * https://www.opensource.org/licenses/MIT                    *
+ * SPDX-License-Identifier: MIT                               *
+ *                                                            *
+ **************************************************************
+*/
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define exprtk_enable_parallel_expression_graph
+#include "exprtk.hpp"
+
+
+template <typename T>
+void expression_graph_example()
+{
+   typedef exprtk::symbol_table<T>     symbol_table_t;
+   typedef exprtk::expression_graph<T> expression_graph_t;
+
+   const std::size_t input_count   = 200;
+   const std::size_t formula_count = 20000;
+   const std::size_t tick_count    = 1000;
+
+   std::vector<T> x(input_count  , T(1));
+   std::vector<T> y(input_count  , T(0));
+   std::vector<T> z(formula_count, T(0));
+
+   symbol_table_t symbol_table;
+
+   for (std::size_t i = 0; i < input_count; ++i)
+   {
+      symbol_table.add_variable("x" + std::to_string(i), x[i]);
+      symbol_table.add_variable("y" + std::to_string(i), y[i]);
+   }
+
+   for (std::size_t i = 0; i < formula_count; ++i)
+   {
+      symbol_table.add_variable("z" + std::to_string(i), z[i]);
+   }
+
+   expression_graph_t graph(symbol_table);
+
+   /*
+      Formulas are added out of dependency order, the graph orders
+      the intermediate y's ahead of the z's that read them.
+   */
+   for (std::size_t i = 0; i < formula_count; ++i)
+   {
+      const std::string y0 = "y" + std::to_string((i    ) % input_count);
+      const std::string y1 = "y" + std::to_string((i * 7) % input_count);
+
+      const std::string formula =
+         "z" + std::to_string(i) + " := " +
+         y0 + " * exp(-" + y1 + " / 100) + sqrt(abs(" + y0 + " - " + y1 + "))";
+
+      if (expression_graph_t::npos == graph.add(formula))
+      {
+         printf("Error: %s\tExpression: %s\n", graph.error().c_str(), formula.c_str());
+         return;
+      }
+   }
+
+   for (std::size_t i = 0; i < input_count; ++i)
+   {
+      const std::string formula =
+         "y" + std::to_string(i) + " := 2x" + std::to_string(i) +
+         " + x" + std::to_string((i + 1) % input_count);
+
+      if (expression_graph_t::npos == graph.add(formula))
+      {
+         printf("Error: %s\tExpression: %s\n", graph.error().c_str(), formula.c_str());
+         return;
+      }
+   }
+
+   if (!graph.build())
+   {
+      printf("Error: %s\n", graph.error().c_str());
+      return;
+   }
+
+   printf("formulas: %d components: %d\n",
+          static_cast<int>(graph.size()),
+          static_cast<int>(graph.component_count()));
+
+   graph.evaluate();
+
+   std::mt19937 engine(12345);
+   std::uniform_int_distribution<std::size_t> pick(0, input_count - 1);
+   std::uniform_real_distribution<T> value(T(-10), T(10));
+
+   std::vector<std::size_t> tick_inputs(2 * tick_count);
+   std::vector<T>           tick_values(2 * tick_count);
+
+   for (std::size_t i = 0; i < tick_inputs.size(); ++i)
+   {
+      tick_inputs[i] = pick (engine);
+      tick_values[i] = value(engine);
+   }
+
+   // Full re-evaluation of every formula on each tick, in dependency order
+   std::vector<T> full_z;
+   {
+      const std::size_t order_offset = formula_count;
+
+      exprtk::timer timer;
+      timer.start();
+
+      for (std::size_t t = 0; t < tick_count; ++t)
+      {
+         x[tick_inputs[2 * t    ]] = tick_values[2 * t    ];
+         x[tick_inputs[2 * t + 1]] = tick_values[2 * t + 1];
+
+         for (std::size_t i = 0; i < input_count; ++i)
+         {
+            graph.expression(order_offset + i).value();
+         }
+
+         for (std::size_t i = 0; i < formula_count; ++i)
+         {
+            graph.expression(i).value();
+         }
+      }
+
+      timer.stop();
+
+      full_z = z;
+
+      printf("[full       ] ticks: %d time: %8.4fsec evals/tick: %d\n",
+             static_cast<int>(tick_count),
+             timer.time(),
+             static_cast<int>(formula_count + input_count));
+   }
+
+   // Incremental re-evaluation of the dependents of the changed inputs
+   for (unsigned int thread_count = 1; thread_count <= 2; ++thread_count)
+   {
+      std::fill(x.begin(), x.end(), T(1));
+      graph.invalidate();
+      graph.evaluate();
+
+      std::size_t total_evals = 0;
+
+      exprtk::timer timer;
+      timer.start();
+
+      for (std::size_t t = 0; t < tick_count; ++t)
+      {
+         const std::size_t i0 = tick_inputs[2 * t    ];
+         const std::size_t i1 = tick_inputs[2 * t + 1];
+
+         x[i0] = tick_values[2 * t    ];
+         x[i1] = tick_values[2 * t + 1];
+
+         graph.changed("x" + std::to_string(i0));
+         graph.changed("x" + std::to_string(i1));
+
+         total_evals += (1 == thread_count) ?
+                        graph.evaluate() :
+                        graph.evaluate(std::thread::hardware_concurrency());
+      }
+
+      timer.stop();
+
+      std::size_t mismatches = 0;
+
+      for (std::size_t i = 0; i < formula_count; ++i)
+      {
+         if (z[i] != full_z[i])
+         {
+            ++mismatches;
+         }
+      }
+
+      printf("[%s] ticks: %d time: %8.4fsec evals/tick: %7.2f mismatches: %d\n",
+             (1 == thread_count) ? "incremental" : "parallel   ",
+             static_cast<int>(tick_count),
+             timer.time(),
+             total_evals / static_cast<double>(tick_count),
+             static_cast<int>(mismatches));
+   }
+}
+
+int main()
+{
+   expression_graph_example<double>();
+   return 0;
+}
+
+
+/*
+
+   Build:
+   c++ -pedantic-errors -Wall -Wextra -Werror -O3 -DNDEBUG -o exprtk_expression_graph exprtk_expression_graph.cpp -L/usr/lib -lstdc++ -lm -lpthread
+
+*/
@@ -19,6 +19,7 @@
 
 #include <cstdio>
 #include <string>
+#include <vector>
 
 #include "exprtk.hpp"
 
@@ -62,9 +63,145 @@ void extract_expression_dependents()
    }
 }
 
+template <typename T>
+void extract_program_dependencies()
+{
+   typedef exprtk::dependency_extractor<T>     extractor_t;
+   typedef typename extractor_t::dependencies dependencies_t;
+
+   const std::string program_list[] =
+      {
+         "a * sin(3x) + foo(abs(y - z) / w)",
+         "var total := 0; for (var i := 0; i < n; i += 1) { total += v[i] * w[i]; }; total / n",
+         "if (name == 'alpha') prefix + name[0:2]; else suffix;",
+         "{ var k := 2; k * bar(m) }; k + sum(u)"
+      };
+
+   const std::size_t program_count = sizeof(program_list) / sizeof(std::string);
+
+   /*
+      Note: Unlike collect_variables and collect_functions, the
+            extractor does not need unknown functions to be
+            registered, as nothing is compiled.
+   */
+   extractor_t extractor;
+   dependencies_t dependencies;
+
+   for (std::size_t i = 0; i < program_count; ++i)
+   {
+      if (!extractor.extract(program_list[i], dependencies))
+      {
+         printf("Error: %s\tExpression: %s\n",
+                extractor.error().c_str(),
+                program_list[i].c_str());
+
+         continue;
+      }
+
+      printf("Expression: %s\n", program_list[i].c_str());
+
+      for (const auto& var : dependencies.variable_list)
+      {
+         printf("   variable: %s\n",var.c_str());
+      }
+
+      for (const auto& vec : dependencies.vector_list)
+      {
+         printf("   vector:   %s\n",vec.c_str());
+      }
+
+      for (const auto& str : dependencies.string_list)
+      {
+         printf("   string:   %s\n",str.c_str());
+      }
+
+      for (const auto& func : dependencies.function_list)
+      {
+         printf("   function: %s\n",func.c_str());
+      }
+   }
+}
+
+template <typename T>
+void dependency_extraction_benchmark()
+{
+   typedef exprtk::dependency_extractor<T>     extractor_t;
+   typedef typename extractor_t::dependencies dependencies_t;
+
+   const std::size_t formula_count = 20000;
+
+   exprtk::symbol_table<T> symbol_table;
+   symbol_table.add_function("foo",[](T t)->T { return t; });
+
+   std::vector<std::string> formula_list;
+
+   for (std::size_t i = 0; i < formula_count; ++i)
+   {
+      const std::string x0 = "x" + std::to_string((i    ) % 500);
+      const std::string x1 = "x" + std::to_string((i * 7) % 500);
+      const std::string x2 = "x" + std::to_string((i * 3) % 500);
+
+      formula_list.push_back(
+         "(" + x0 + " * exp(-" + x1 + " / 100) + sqrt(abs(" + x0 + " - " + x2 + "))) / "
+         "foo(" + x1 + " + 2" + x2 + ") - min(" + x0 + ", " + x1 + ", " + x2 + ") * 3.5");
+   }
+
+   std::size_t symbol_count = 0;
+
+   exprtk::timer timer;
+   timer.start();
+
+   for (std::size_t i = 0; i < formula_count; ++i)
+   {
+      std::deque<std::string> variable_list;
+      std::deque<std::string> function_list;
+
+      exprtk::collect_variables(formula_list[i], symbol_table, variable_list);
+      exprtk::collect_functions(formula_list[i], symbol_table, function_list);
+
+      symbol_count += variable_list.size() + function_list.size();
+   }
+
+   timer.stop();
+
+   const double collect_time = timer.time();
+
+   printf("[collect_*] formulas: %d symbols: %d time: %8.4fsec\n",
+          static_cast<int>(formula_count),
+          static_cast<int>(symbol_count),
+          collect_time);
+
+   extractor_t extractor;
+   extractor.register_symbol_table(symbol_table);
+
+   dependencies_t dependencies;
+
+   symbol_count = 0;
+
+   timer.start();
+
+   for (std::size_t i = 0; i < formula_count; ++i)
+   {
+      extractor.extract(formula_list[i], dependencies);
+
+      symbol_count += dependencies.variable_list.size() +
+                      dependencies.function_list.size();
+   }
+
+   timer.stop();
+
+   printf("[extractor] formulas: %d symbols: %d time: %8.4fsec speedup: %6.2fx\n",
+          static_cast<int>(formula_count),
+          static_cast<int>(symbol_count),
+          timer.time(),
+          collect_time / timer.time());
+}
+
 int main()
 {
    extract_expression_dependents<double>();
+   extract_program_dependencies <double>();
+   dependency_extraction_benchmark<double>();
    return 0;
 }
 
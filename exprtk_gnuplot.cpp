@@ -21,7 +21,7 @@
 #include <iostream>
 #include <string>
 #include <fstream>
-#include <iomanip>
+#include <vector>
 
 #include "exprtk.hpp"
 
@@ -35,6 +35,7 @@ public:
    , max_x_(0.0)
    , min_y_(0.0)
    , max_y_(0.0)
+   , binary_output_(false)
    {}
 
    exprtk_gnuplot_fx& set_title(const std::string& title)
@@ -56,6 +57,17 @@ public:
       return *this;
    }
 
+   /*
+      Write the samples as raw doubles rather than text. This avoids
+      formatting altogether and the values are passed to gnuplot at
+      full precision.
+   */
+   exprtk_gnuplot_fx& set_binary_output(const bool binary_output)
+   {
+      binary_output_ = binary_output;
+      return *this;
+   }
+
    bool plot()
    {
       if (!generate_data())
@@ -81,11 +93,138 @@ private:
       stream << "set yrange[" << min_y_ << ":" << max_y_ <<"]\n";
       stream << "set xzeroaxis\n";
       stream << "set yzeroaxis\n";
-      stream << "plot 'data.dat' using 1:2:(1.0) smooth unique title '" << title_ <<"'\n";
+      stream << "plot 'data.dat' "
+             << (binary_output_ ? "binary format='%2double' " : "")
+             << "using 1:2:(1.0) smooth unique title '" << title_ <<"'\n";
 
       return true;
    }
 
+   enum sampling_constants
+   {
+      initial_segments = 1024,
+      max_depth        = 16
+   };
+
+   class data_writer
+   {
+   public:
+
+      data_writer(const std::string& file_name, const bool binary)
+      : file_(std::fopen(file_name.c_str(), binary ? "wb" : "w"))
+      , binary_(binary)
+      {
+         if (file_)
+         {
+            std::setvbuf(file_, 0, _IOFBF, 1 << 20);
+         }
+      }
+
+     ~data_writer()
+      {
+         if (file_)
+         {
+            std::fclose(file_);
+         }
+      }
+
+      bool operator!() const
+      {
+         return (0 == file_);
+      }
+
+      inline void write(const double x, const double y)
+      {
+         if (binary_)
+         {
+            const double xy[] = { x, y };
+            std::fwrite(xy, sizeof(double), 2, file_);
+         }
+         else
+            std::fprintf(file_, "%.10g\t%.10g\n", x, y);
+      }
+
+   private:
+
+      data_writer(const data_writer&);
+      data_writer& operator=(const data_writer&);
+
+      std::FILE* file_;
+      bool       binary_;
+   };
+
+   struct sampler
+   {
+      sampler(const exprtk::expression<double>& e, double& x, data_writer& w)
+      : expression(e)
+      , x_ref(x)
+      , writer(w)
+      , min_step (0.0)
+      , tolerance(0.0)
+      , min_y(+std::numeric_limits<double>::max())
+      , max_y(-std::numeric_limits<double>::max())
+      {}
+
+      inline double evaluate(const double x)
+      {
+         x_ref = x;
+         return expression.value();
+      }
+
+      static inline bool is_finite(const double y)
+      {
+         return (y == y) && (std::abs(y) <= std::numeric_limits<double>::max());
+      }
+
+      // Only finite values contribute to the y-range
+      inline void emit(const double x, const double y)
+      {
+         if (is_finite(y))
+         {
+            if (y < min_y) min_y = y;
+            if (y > max_y) max_y = y;
+         }
+
+         writer.write(x,y);
+      }
+
+      /*
+         Emit the points strictly between x0 and x1. The midpoint is
+         always emitted, and the halves are refined further only where
+         the midpoint strays from the chord by more than the tolerance,
+         ie: where the curve bends. Non-finite values are refined down
+         to the minimum step so that singularities are resolved. A
+         feature narrower than a segment that does not disturb its
+         midpoint, such as a thin spike, can still be missed.
+      */
+      void refine(const double x0, const double y0,
+                  const double x1, const double y1,
+                  const std::size_t depth)
+      {
+         const double xm = (x0 + x1) / 2.0;
+         const double ym = evaluate(xm);
+
+         const bool subdivide =
+            (depth < max_depth)            &&
+            ((x1 - x0) > (2.0 * min_step)) &&
+            !(std::abs(ym - (y0 + y1) / 2.0) <= tolerance);
+
+         if (subdivide) refine(x0, y0, xm, ym, depth + 1);
+
+         emit(xm,ym);
+
+         if (subdivide) refine(xm, ym, x1, y1, depth + 1);
+      }
+
+      const exprtk::expression<double>& expression;
+      double&      x_ref;
+      data_writer& writer;
+      double       min_step;
+      double       tolerance;
+      double       min_y;
+      double       max_y;
+   };
+
    bool generate_data()
    {
       typedef exprtk::symbol_table<double> symbol_table_t;
@@ -108,30 +247,65 @@ private:
          return false;
       }
 
-      std::ofstream stream("data.dat");
+      data_writer writer("data.dat", binary_output_);
 
-      if (!stream)
+      if (!writer)
       {
          return false;
       }
 
-      min_y_ = +std::numeric_limits<double>::max();
-      max_y_ = -std::numeric_limits<double>::max();
+      /*
+         Sample a coarse uniform grid first, its range sets the
+         tolerance, then refine each segment adaptively. Segments are
+         never split below the fixed step previously used throughout.
+      */
+      sampler s(expression, x, writer);
+
+      s.min_step = std::min(0.00005,std::abs(max_x_ - min_x_) / 1000.0);
 
-      stream << std::setprecision(10);
+      const double segment = (max_x_ - min_x_) / initial_segments;
 
-      const double increment = std::min(0.00005,std::abs(max_x_ - min_x_) / 1000.0);
+      std::vector<double> coarse_y(initial_segments + 1);
 
-      for (x = min_x_; x <= max_x_; x += increment)
+      double coarse_min_y = +std::numeric_limits<double>::max();
+      double coarse_max_y = -std::numeric_limits<double>::max();
+
+      for (std::size_t i = 0; i <= initial_segments; ++i)
       {
-         const double y = expression.value();
+         coarse_y[i] = s.evaluate(min_x_ + i * segment);
 
-              if (y < min_y_) min_y_ = y;
-         else if (y > max_y_) max_y_ = y;
+         if (!sampler::is_finite(coarse_y[i]))
+            continue;
 
-         stream << x << "\t" << y << "\n";
+         if (coarse_y[i] < coarse_min_y) coarse_min_y = coarse_y[i];
+         if (coarse_y[i] > coarse_max_y) coarse_max_y = coarse_y[i];
       }
 
+      // One ten-thousandth of the finite range is well below a pixel
+      if (coarse_min_y <= coarse_max_y)
+         s.tolerance = (coarse_max_y - coarse_min_y) * 0.0001;
+
+      s.emit(min_x_, coarse_y[0]);
+
+      for (std::size_t i = 0; i < initial_segments; ++i)
+      {
+         const double x0 = min_x_ + i * segment;
+         const double x1 = (i + 1 == initial_segments) ? max_x_ : x0 + segment;
+
+         s.refine(x0, coarse_y[i], x1, coarse_y[i + 1], 0);
+         s.emit  (x1, coarse_y[i + 1]);
+      }
+
+      // With no finite samples at all, fall back to an empty range
+      if (s.min_y > s.max_y)
+      {
+         s.min_y = 0.0;
+         s.max_y = 0.0;
+      }
+
+      min_y_ = s.min_y;
+      max_y_ = s.max_y;
+
       const double diff_y  = std::abs(max_y_ - min_y_);
       const double perc7_5 = diff_y * 0.075; //7.5%
 
@@ -147,6 +321,7 @@ private:
    double      max_x_;
    double      min_y_;
    double      max_y_;
+   bool        binary_output_;
 };
 
 int main()
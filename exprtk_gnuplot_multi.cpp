@@ -17,11 +17,14 @@
 */
 
 
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <iostream>
 #include <string>
 #include <fstream>
-#include <iomanip>
+#include <thread>
+#include <vector>
 
 #include "exprtk.hpp"
 
@@ -67,14 +70,68 @@ class exprtk_gnuplot_fx
 {
 public:
 
+   exprtk_gnuplot_fx()
+   : thread_count_(std::max(1U, std::thread::hardware_concurrency()))
+   , binary_output_(false)
+   {}
+
+   exprtk_gnuplot_fx& set_thread_count(const std::size_t thread_count)
+   {
+      thread_count_ = std::max<std::size_t>(1, thread_count);
+      return *this;
+   }
+
+   /*
+      Write the samples as raw doubles rather than text. This avoids
+      formatting altogether and the values are passed to gnuplot at
+      full precision.
+   */
+   exprtk_gnuplot_fx& set_binary_output(const bool binary_output)
+   {
+      binary_output_ = binary_output;
+      return *this;
+   }
+
+   /*
+      Each curve has its own parser, symbol table and data file, so the
+      curves are shared out between the threads, each thread taking the
+      next unclaimed curve until none remain.
+   */
    bool plot()
    {
-      for (std::size_t i = 0; i < curve_list_.size(); ++i)
+      std::vector<char> result(curve_list_.size(), 0);
+      std::atomic<std::size_t> next_curve(0);
+
+      const auto worker = [&]()
       {
-         if (!generate_data(i,curve_list_[i]))
-            return false;
+         for (std::size_t i = next_curve++; i < curve_list_.size(); i = next_curve++)
+         {
+            result[i] = generate_data(i,curve_list_[i]) ? 1 : 0;
+         }
+      };
+
+      const std::size_t thread_count = std::min(thread_count_, curve_list_.size());
+
+      if (thread_count <= 1)
+         worker();
+      else
+      {
+         std::vector<std::thread> thread_list;
+
+         for (std::size_t i = 0; i < thread_count; ++i)
+         {
+            thread_list.emplace_back(worker);
+         }
+
+         for (auto& t : thread_list)
+         {
+            t.join();
+         }
       }
 
+      if (std::find(result.begin(), result.end(), 0) != result.end())
+         return false;
+
       return generate_gp_script();
    }
 
@@ -120,13 +177,145 @@ private:
 
       for (std::size_t i = 0; i < curve_list_.size(); ++i)
       {
-         stream << "'data.dat" << i << "' using 1:2:(1.0) smooth unique title '" << curve_list_[i].title_;
+         stream << "'" << data_file_name(i) << "' "
+                << (binary_output_ ? "binary format='%2double' " : "")
+                << "using 1:2:(1.0) smooth unique title '" << curve_list_[i].title_;
          stream << (((i + 1) < curve_list_.size()) ? "',\\\n"  : "'\n");
       }
 
       return true;
    }
 
+   enum sampling_constants
+   {
+      initial_segments = 1024,
+      max_depth        = 16
+   };
+
+   class data_writer
+   {
+   public:
+
+      data_writer(const std::string& file_name, const bool binary)
+      : file_(std::fopen(file_name.c_str(), binary ? "wb" : "w"))
+      , binary_(binary)
+      {
+         if (file_)
+         {
+            std::setvbuf(file_, 0, _IOFBF, 1 << 20);
+         }
+      }
+
+     ~data_writer()
+      {
+         if (file_)
+         {
+            std::fclose(file_);
+         }
+      }
+
+      bool operator!() const
+      {
+         return (0 == file_);
+      }
+
+      inline void write(const double x, const double y)
+      {
+         if (binary_)
+         {
+            const double xy[] = { x, y };
+            std::fwrite(xy, sizeof(double), 2, file_);
+         }
+         else
+            std::fprintf(file_, "%.10g\t%.10g\n", x, y);
+      }
+
+   private:
+
+      data_writer(const data_writer&);
+      data_writer& operator=(const data_writer&);
+
+      std::FILE* file_;
+      bool       binary_;
+   };
+
+   struct sampler
+   {
+      sampler(const exprtk::expression<double>& e, double& x, data_writer& w)
+      : expression(e)
+      , x_ref(x)
+      , writer(w)
+      , min_step (0.0)
+      , tolerance(0.0)
+      , min_y(+std::numeric_limits<double>::max())
+      , max_y(-std::numeric_limits<double>::max())
+      {}
+
+      inline double evaluate(const double x)
+      {
+         x_ref = x;
+         return expression.value();
+      }
+
+      static inline bool is_finite(const double y)
+      {
+         return (y == y) && (std::abs(y) <= std::numeric_limits<double>::max());
+      }
+
+      // Only finite values contribute to the y-range
+      inline void emit(const double x, const double y)
+      {
+         if (is_finite(y))
+         {
+            if (y < min_y) min_y = y;
+            if (y > max_y) max_y = y;
+         }
+
+         writer.write(x,y);
+      }
+
+      /*
+         Emit the points strictly between x0 and x1. The midpoint is
+         always emitted, and the halves are refined further only where
+         the midpoint strays from the chord by more than the tolerance,
+         ie: where the curve bends. Non-finite values are refined down
+         to the minimum step so that singularities are resolved. A
+         feature narrower than a segment that does not disturb its
+         midpoint, such as a thin spike, can still be missed.
+      */
+      void refine(const double x0, const double y0,
+                  const double x1, const double y1,
+                  const std::size_t depth)
+      {
+         const double xm = (x0 + x1) / 2.0;
+         const double ym = evaluate(xm);
+
+         const bool subdivide =
+            (depth < max_depth)            &&
+            ((x1 - x0) > (2.0 * min_step)) &&
+            !(std::abs(ym - (y0 + y1) / 2.0) <= tolerance);
+
+         if (subdivide) refine(x0, y0, xm, ym, depth + 1);
+
+         emit(xm,ym);
+
+         if (subdivide) refine(xm, ym, x1, y1, depth + 1);
+      }
+
+      const exprtk::expression<double>& expression;
+      double&      x_ref;
+      data_writer& writer;
+      double       min_step;
+      double       tolerance;
+      double       min_y;
+      double       max_y;
+   };
+
+   static std::string data_file_name(const std::size_t index)
+   {
+      return "data.dat" + std::to_string(index);
+   }
+
    bool generate_data(const std::size_t index, exprtk_fx_curve& curve)
    {
       typedef exprtk::symbol_table<double> symbol_table_t;
@@ -149,32 +338,65 @@ private:
          return false;
       }
 
-      const std::string file_name = std::string("data.dat") + (char)('0' + index);
-
-      std::ofstream stream(file_name.c_str());
+      data_writer writer(data_file_name(index), binary_output_);
 
-      if (!stream)
+      if (!writer)
       {
          return false;
       }
 
-      curve.min_y_ = +std::numeric_limits<double>::max();
-      curve.max_y_ = -std::numeric_limits<double>::max();
+      /*
+         Sample a coarse uniform grid first, its range sets the
+         tolerance, then refine each segment adaptively. Segments are
+         never split below the fixed step previously used throughout.
+      */
+      sampler s(expression, x, writer);
+
+      s.min_step = std::min(0.00005,std::abs(curve.max_x_ - curve.min_x_) / 1000.0);
+
+      const double segment = (curve.max_x_ - curve.min_x_) / initial_segments;
+
+      std::vector<double> coarse_y(initial_segments + 1);
 
-      stream << std::setprecision(10);
+      double coarse_min_y = +std::numeric_limits<double>::max();
+      double coarse_max_y = -std::numeric_limits<double>::max();
 
-      const double increment = std::min(0.00005,std::abs(curve.max_x_ - curve.min_x_) / 1000.0);
+      for (std::size_t i = 0; i <= initial_segments; ++i)
+      {
+         coarse_y[i] = s.evaluate(curve.min_x_ + i * segment);
+
+         if (!sampler::is_finite(coarse_y[i]))
+            continue;
+
+         if (coarse_y[i] < coarse_min_y) coarse_min_y = coarse_y[i];
+         if (coarse_y[i] > coarse_max_y) coarse_max_y = coarse_y[i];
+      }
+
+      // One ten-thousandth of the finite range is well below a pixel
+      if (coarse_min_y <= coarse_max_y)
+         s.tolerance = (coarse_max_y - coarse_min_y) * 0.0001;
 
-      for (x = curve.min_x_; x <= curve.max_x_; x += increment)
+      s.emit(curve.min_x_, coarse_y[0]);
+
+      for (std::size_t i = 0; i < initial_segments; ++i)
       {
-         const double y = expression.value();
+         const double x0 = curve.min_x_ + i * segment;
+         const double x1 = (i + 1 == initial_segments) ? curve.max_x_ : x0 + segment;
 
-              if (y < curve.min_y_) curve.min_y_ = y;
-         else if (y > curve.max_y_) curve.max_y_ = y;
+         s.refine(x0, coarse_y[i], x1, coarse_y[i + 1], 0);
+         s.emit  (x1, coarse_y[i + 1]);
+      }
 
-         stream << x << "\t" << y << "\n";
+      // With no finite samples at all, fall back to an empty range
+      if (s.min_y > s.max_y)
+      {
+         s.min_y = 0.0;
+         s.max_y = 0.0;
       }
 
+      curve.min_y_ = s.min_y;
+      curve.max_y_ = s.max_y;
+
       const double diff_y  = std::abs(curve.max_y_ - curve.min_y_);
       const double perc7_5 = diff_y * 0.075; //7.5%
 
@@ -185,6 +407,8 @@ private:
    }
 
    std::deque<exprtk_fx_curve> curve_list_;
+   std::size_t thread_count_;
+   bool        binary_output_;
 };
 
 int main()
@@ -212,7 +436,7 @@ int main()
 
 /*
    Build and Run:
-   1. c++ -pedantic-errors -Wall -Wextra -Werror -Wno-long-long -O3 -DNDEBUG -o exprtk_gnuplot_multi exprtk_gnuplot_multi.cpp -lstdc++
+   1. c++ -pedantic-errors -Wall -Wextra -Werror -Wno-long-long -O3 -DNDEBUG -o exprtk_gnuplot_multi exprtk_gnuplot_multi.cpp -lstdc++ -lpthread
    2. ./exprtk_gnuplot_multi
    3. gnuplot plot.gp
 */
@@ -0,0 +1,369 @@
+/*
+ **************************************************************
+ *         C++ Mathematical Expression Toolkit Library        *
+ *                                                            *
+ * ExprTk Numerical Integration And Differentiation Benchmark *
+ * Author: Arash Partow (1999-2025)                           *
+ * URL: https://www.partow.net/programming/exprtk/index.html  *
+ *                                                            *
+ * Copyright notice:                                          *
+ * Free use of the Mathematical Expression Toolkit Library is *
+ * permitted under the guidelines and in accordance with the  *
+ * most current version of the MIT License.                   *
+ * https://www.opensource.org/licenses/MIT                    *
+ * SPDX-License-Identifier: MIT                               *
+ *                                                            *
+ **************************************************************
+*/
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "exprtk.hpp"
+
+
+struct integral_definition
+{
+   std::string expression;
+   double r0;
+   double r1;
+   double exact;
+};
+
+const integral_definition integral_list[] =
+   {
+      { "sin(x)"                   , 0.0, 3.141592653589793238, 2.0                                                },
+      { "4 / (1 + x^2)"            , 0.0, 1.0                 , 3.141592653589793238                               },
+      { "exp(-x) * sin(10 * x)"    , 0.0, 10.0                , (10.0 - std::exp(-10.0) * (std::sin(100.0) + 10.0 * std::cos(100.0))) / 101.0 },
+      { "1 / sqrt(x + 0.0001)"     , 0.0, 1.0                 , 2.0 * (std::sqrt(1.0001) - std::sqrt(0.0001))      }
+   };
+
+const std::size_t integral_count = sizeof(integral_list) / sizeof(integral_definition);
+
+// The previous form of exprtk::integrate, three evaluations per interval
+template <typename T>
+T three_point_integrate(const exprtk::expression<T>& e, T& x, const T& r0, const T& r1, const std::size_t number_of_intervals)
+{
+   const T h = (r1 - r0) / (T(2) * number_of_intervals);
+   T total_area = T(0);
+
+   for (std::size_t i = 0; i < number_of_intervals; ++i)
+   {
+      x = r0 + T(2) * i * h;
+      const T y0 = e.value(); x += h;
+      const T y1 = e.value(); x += h;
+      const T y2 = e.value(); x += h;
+      total_area += h * (y0 + T(4) * y1 + y2) / T(3);
+   }
+
+   return total_area;
+}
+
+template <typename T>
+void integration_benchmark()
+{
+   typedef exprtk::symbol_table<T> symbol_table_t;
+   typedef exprtk::expression<T>   expression_t;
+   typedef exprtk::parser<T>       parser_t;
+
+   T x = T(0);
+
+   symbol_table_t symbol_table;
+   symbol_table.add_variable("x",x);
+   symbol_table.add_constants();
+
+   parser_t parser;
+
+   const std::size_t intervals = 1000000;
+
+   printf("%-24s | %-21s | %-32s | %-32s\n", "", "three point 10^6", "single pass 10^6", "adaptive Gauss-Kronrod 1e-10");
+   printf("%-24s | %9s %11s | %9s %11s %10s | %9s %11s %10s\n", "integrand",
+          "time", "error",
+          "time", "error", "estimate",
+          "time", "error", "estimate");
+
+   for (std::size_t i = 0; i < integral_count; ++i)
+   {
+      const integral_definition& definition = integral_list[i];
+
+      expression_t expression;
+      expression.register_symbol_table(symbol_table);
+
+      if (!parser.compile(definition.expression, expression))
+      {
+         printf("Error: %s\tExpression: %s\n",
+                parser.error().c_str(),
+                definition.expression.c_str());
+
+         return;
+      }
+
+      exprtk::timer timer;
+
+      timer.start();
+      const T three_point = three_point_integrate(expression, x, T(definition.r0), T(definition.r1), intervals);
+      timer.stop();
+      const double three_point_time = timer.time();
+
+      T simpson_error = T(0);
+
+      timer.start();
+      const T simpson = exprtk::integrate(expression, x, T(definition.r0), T(definition.r1), simpson_error, intervals);
+      timer.stop();
+      const double simpson_time = timer.time();
+
+      T adaptive_error = T(0);
+
+      timer.start();
+      const T adaptive = exprtk::integrate_adaptive(expression, x, T(definition.r0), T(definition.r1), adaptive_error);
+      timer.stop();
+      const double adaptive_time = timer.time();
+
+      printf("%-24s | %7.3fms %11.3e | %7.3fms %11.3e %10.3e | %7.3fms %11.3e %10.3e\n",
+             definition.expression.c_str(),
+             three_point_time * 1000.0, std::abs(three_point - definition.exact),
+             simpson_time     * 1000.0, std::abs(simpson     - definition.exact), simpson_error,
+             adaptive_time    * 1000.0, std::abs(adaptive    - definition.exact), adaptive_error);
+   }
+}
+
+/*
+   Rather than fixing a large number of intervals up front, double
+   the count until the error estimate meets the tolerance.
+*/
+template <typename T>
+void early_stopping()
+{
+   typedef exprtk::symbol_table<T> symbol_table_t;
+   typedef exprtk::expression<T>   expression_t;
+   typedef exprtk::parser<T>       parser_t;
+
+   const integral_definition& definition = integral_list[2];
+
+   T x = T(0);
+
+   symbol_table_t symbol_table;
+   symbol_table.add_variable("x",x);
+
+   expression_t expression;
+   expression.register_symbol_table(symbol_table);
+
+   parser_t parser;
+
+   if (!parser.compile(definition.expression, expression))
+      return;
+
+   const T tolerance = T(1e-10);
+
+   T error     = T(0);
+   T area      = T(0);
+   std::size_t intervals = 16;
+
+   for ( ; intervals <= 1000000; intervals *= 2)
+   {
+      area = exprtk::integrate(expression, x, T(definition.r0), T(definition.r1), error, intervals);
+
+      if (error <= tolerance)
+         break;
+   }
+
+   printf("\nearly stopping: %s intervals: %d estimate: %10.3e error: %10.3e\n",
+          definition.expression.c_str(),
+          static_cast<int>(intervals),
+          error,
+          std::abs(area - definition.exact));
+}
+
+/*
+   Split the range across threads, each with its own symbol table and
+   expression, and integrate the pieces adaptively. The tolerance of
+   each piece is scaled so that the sum of the estimates meets the
+   tolerance of the whole.
+*/
+template <typename T>
+T parallel_integrate_adaptive(const std::string& expression_string,
+                              const T& r0, const T& r1,
+                              const T& tolerance,
+                              const std::size_t thread_count,
+                              T& error_estimate)
+{
+   std::vector<T> area_list (thread_count, T(0));
+   std::vector<T> error_list(thread_count, T(0));
+
+   std::vector<std::thread> thread_list;
+
+   for (std::size_t i = 0; i < thread_count; ++i)
+   {
+      thread_list.emplace_back(
+         std::thread([&, i]()
+                     {
+                        T x = T(0);
+
+                        exprtk::symbol_table<T> symbol_table;
+                        symbol_table.add_variable("x",x);
+
+                        exprtk::expression<T> expression;
+                        expression.register_symbol_table(symbol_table);
+
+                        exprtk::parser<T> parser;
+
+                        if (!parser.compile(expression_string, expression))
+                        {
+                           area_list [i] = std::numeric_limits<T>::quiet_NaN();
+                           error_list[i] = std::numeric_limits<T>::quiet_NaN();
+                           return;
+                        }
+
+                        const T width = (r1 - r0) / T(thread_count);
+                        const T a     = r0 + T(i) * width;
+                        const T b     = (i + 1 == thread_count) ? r1 : (a + width);
+
+                        area_list[i] = exprtk::integrate_adaptive(expression, x, a, b, error_list[i],
+                                                                  tolerance / T(thread_count), 100000);
+                     }));
+   }
+
+   for (auto& t : thread_list)
+   {
+      t.join();
+   }
+
+   T area = T(0);
+   error_estimate = T(0);
+
+   for (std::size_t i = 0; i < thread_count; ++i)
+   {
+      area           += area_list [i];
+      error_estimate += error_list[i];
+   }
+
+   return area;
+}
+
+template <typename T>
+void parallel_integration()
+{
+   const std::string expression_string = "sin(50 * x) * exp(-x / 4) + 1 / (1 + 400 * (x - 7)^2)";
+
+   const T r0 = T( 0);
+   const T r1 = T(20);
+   const T tolerance = T(1e-12);
+
+   const std::size_t thread_count = std::max<std::size_t>(2, std::thread::hardware_concurrency());
+
+   printf("\nparallel adaptive: %s over [%g,%g]\n", expression_string.c_str(), r0, r1);
+
+   for (std::size_t threads = 1; threads <= thread_count; threads *= 2)
+   {
+      T error = T(0);
+
+      exprtk::timer timer;
+      timer.start();
+
+      const T area = parallel_integrate_adaptive(expression_string, r0, r1, tolerance, threads, error);
+
+      timer.stop();
+
+      printf("   threads: %2d area: %20.15f estimate: %10.3e time: %8.3fms\n",
+             static_cast<int>(threads), area, error, timer.time() * 1000.0);
+   }
+}
+
+template <typename T>
+void batch_differentiation()
+{
+   typedef exprtk::symbol_table<T> symbol_table_t;
+   typedef exprtk::expression<T>   expression_t;
+   typedef exprtk::parser<T>       parser_t;
+
+   T x = T(0);
+
+   symbol_table_t symbol_table;
+   symbol_table.add_variable("x",x);
+
+   expression_t expression;
+   expression.register_symbol_table(symbol_table);
+
+   parser_t parser;
+
+   if (!parser.compile("sin(x) * exp(-x / 10)", expression))
+      return;
+
+   std::vector<T> x_list(200000);
+
+   for (std::size_t i = 0; i < x_list.size(); ++i)
+   {
+      x_list[i] = T(i) / T(10000);
+   }
+
+   exprtk::timer timer;
+
+   std::vector<T> pointwise(x_list.size());
+
+   timer.start();
+
+   for (std::size_t i = 0; i < x_list.size(); ++i)
+   {
+      x = x_list[i];
+      pointwise[i] = exprtk::derivative(expression, x);
+   }
+
+   timer.stop();
+
+   const double pointwise_time = timer.time();
+
+   std::vector<T> batch;
+   std::vector<T> error_list;
+
+   timer.start();
+
+   exprtk::derivative(expression, x, x_list, batch);
+
+   timer.stop();
+
+   const double batch_time = timer.time();
+
+   std::vector<T> estimated;
+
+   exprtk::derivative(expression, x, x_list, estimated, T(0.00000001), &error_list);
+
+   T max_error = T(0);
+
+   for (std::size_t i = 0; i < x_list.size(); ++i)
+   {
+      const T exact = std::exp(-x_list[i] / T(10)) * (std::cos(x_list[i]) - std::sin(x_list[i]) / T(10));
+      max_error = std::max(max_error, std::abs(batch[i] - exact));
+   }
+
+   printf("\nderivative of %d points  pointwise: %8.3fms batch: %8.3fms %s  max error: %10.3e max estimate: %10.3e\n",
+          static_cast<int>(x_list.size()),
+          pointwise_time * 1000.0,
+          batch_time     * 1000.0,
+          ((pointwise == batch) && (batch == estimated)) ? "OK" : "MISMATCH",
+          max_error,
+          *std::max_element(error_list.begin(), error_list.end()));
+}
+
+int main()
+{
+   integration_benchmark <double>();
+   early_stopping        <double>();
+   parallel_integration  <double>();
+   batch_differentiation <double>();
+
+   return 0;
+}
+
+
+/*
+
+   Build:
+   c++ -pedantic-errors -Wall -Wextra -Werror -O3 -DNDEBUG -o exprtk_integration_benchmark exprtk_integration_benchmark.cpp -L/usr/lib -lstdc++ -lm -lpthread
+
+*/
@@ -0,0 +1,161 @@
+/*
+ **************************************************************
+ *         C++ Mathematical Expression Toolkit Library        *
+ *                                                            *
+ * ExprTk Literal Parameter Sweep Example                     *
+ * Author: Arash Partow (1999-2025)                           *
+ * URL: https://www.partow.net/programming/exprtk/index.html  *
+ *                                                            *
+ * Copyright notice:                                          *
+ * Free use of the Mathematical Expression Toolkit Library is *
+ * permitted under the guidelines and in accordance with the  *
+ * most current version of the MIT License.                   *
+ * https://www.opensource.org/licenses/MIT                    *
+ * SPDX-License-Identifier: MIT                               *
+ *                                                            *
+ **************************************************************
+*/
+
+
+#include <cstdio>
+#include <limits>
+#include <string>
+
+#include "exprtk.hpp"
+
+
+template <typename T>
+void literal_parameter_sweep()
+{
+   typedef exprtk::symbol_table<T> symbol_table_t;
+   typedef exprtk::expression<T>   expression_t;
+   typedef exprtk::parser<T>       parser_t;
+   typedef typename parser_t::settings_t settings_t;
+
+   /*
+      Fit the damping and frequency of a damped oscillator to a set of
+      samples by sweeping both constants. With literal parameters the
+      expression is compiled once, and each candidate is patched in.
+   */
+   const std::string fit_program =
+      " var error := 0;                                   "
+      " for (var i := 0; i < 200; i += 1)                 "
+      " {                                                 "
+      "    var t := i / 20;                               "
+      "    var y := exp(-$damping * t) * cos($omega * t); "
+      "    error += (y - exp(-0.35 * t) * cos(2.5 * t))^2;"
+      " };                                                "
+      " error;                                            ";
+
+   symbol_table_t symbol_table;
+
+   expression_t expression;
+   expression.register_symbol_table(symbol_table);
+
+   parser_t parser(settings_t::default_compile_all_opts +
+                   settings_t::e_literal_parameters);
+
+   if (!parser.compile(fit_program, expression))
+   {
+      printf("Error: %s\tExpression: %s\n",
+             parser.error().c_str(),
+             fit_program.c_str());
+
+      return;
+   }
+
+   T* damping = expression.parameter("damping");
+   T* omega   = expression.parameter("omega"  );
+
+   T best_error   = std::numeric_limits<T>::infinity();
+   T best_damping = T(0);
+   T best_omega   = T(0);
+
+   exprtk::timer timer;
+   timer.start();
+
+   for (int d = 0; d <= 100; ++d)
+   {
+      for (int w = 0; w <= 100; ++w)
+      {
+         (*damping) = T(d) / T(100);
+         (*omega  ) = T(w) / T(20);
+
+         const T error = expression.value();
+
+         if (error < best_error)
+         {
+            best_error   = error;
+            best_damping = (*damping);
+            best_omega   = (*omega  );
+         }
+      }
+   }
+
+   timer.stop();
+
+   printf("[patched   ] damping: %5.3f omega: %5.3f error: %10.8f time: %8.4fsec\n",
+          best_damping, best_omega, best_error, timer.time());
+
+   // The same sweep, substituting each candidate into the text and recompiling
+   best_error = std::numeric_limits<T>::infinity();
+
+   timer.start();
+
+   for (int d = 0; d <= 100; ++d)
+   {
+      for (int w = 0; w <= 100; ++w)
+      {
+         std::string program = fit_program;
+
+         char damping_str[32];
+         char omega_str  [32];
+
+         snprintf(damping_str, sizeof(damping_str), "(%.17g)", static_cast<double>(T(d) / T(100)));
+         snprintf(omega_str  , sizeof(omega_str  ), "(%.17g)", static_cast<double>(T(w) / T(20 )));
+
+         program.replace(program.find("$damping"), 8, damping_str);
+         program.replace(program.find("$omega"  ), 6, omega_str  );
+
+         expression_t recompiled;
+         recompiled.register_symbol_table(symbol_table);
+
+         if (!parser.compile(program, recompiled))
+         {
+            printf("Error: %s\tExpression: %s\n",
+                   parser.error().c_str(),
+                   program.c_str());
+
+            return;
+         }
+
+         const T error = recompiled.value();
+
+         if (error < best_error)
+         {
+            best_error   = error;
+            best_damping = T(d) / T(100);
+            best_omega   = T(w) / T(20);
+         }
+      }
+   }
+
+   timer.stop();
+
+   printf("[recompiled] damping: %5.3f omega: %5.3f error: %10.8f time: %8.4fsec\n",
+          best_damping, best_omega, best_error, timer.time());
+}
+
+int main()
+{
+   literal_parameter_sweep<double>();
+   return 0;
+}
+
+
+/*
+
+   Build:
+   c++ -pedantic-errors -Wall -Wextra -Werror -O3 -DNDEBUG -o exprtk_literal_parameters exprtk_literal_parameters.cpp -L/usr/lib -lstdc++ -lm
+
+*/
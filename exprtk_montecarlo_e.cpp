@@ -18,29 +18,11 @@
 
 
 #include <cstdio>
-#include <cstdlib>
-#include <ctime>
 #include <string>
 
 #include "exprtk.hpp"
 
 
-template <typename T>
-struct rnd_01 : public exprtk::ifunction<T>
-{
-   using exprtk::ifunction<T>::operator();
-
-   rnd_01() : exprtk::ifunction<T>(0)
-   { ::srand(static_cast<unsigned int>(time(NULL))); }
-
-   inline T operator()()
-   {
-      // Note: Do not use this in production
-      // Result is in the interval [0,1)
-      return T(::rand() / T(RAND_MAX + 1.0));
-   }
-};
-
 template <typename T>
 void monte_carlo_e()
 {
@@ -56,17 +38,17 @@ void monte_carlo_e()
       " {                                         "
       "    var rand_sum := 0;                     "
       "    repeat                                 "
-      "       rand_sum += rnd_01;                 "
+      "       rand_sum += rnd_uniform();          "
       "       trials   += 1;                      "
       "    until (rand_sum > 1);                  "
       " };                                        "
       "                                           "
       " trials / max_samples;                     ";
 
-   rnd_01<T> rnd01;
+   exprtk::rtl::random::package<T> random_package;
 
    symbol_table_t symbol_table;
-   symbol_table.add_function("rnd_01",rnd01);
+   symbol_table.add_package(random_package);
 
    expression_t expression;
    expression.register_symbol_table(symbol_table);
@@ -17,39 +17,12 @@
 */
 
 
-#include <algorithm>
-#include <array>
 #include <cstdio>
-#include <random>
 #include <string>
 
 #include "exprtk.hpp"
 
 
-template <typename T>
-struct normal_distribution final : public exprtk::ifunction<T>
-{
-   using exprtk::ifunction<T>::operator();
-
-   normal_distribution()
-   : exprtk::ifunction<T>(2)
-   {
-      std::random_device device;
-      std::array<unsigned int,std::mt19937::state_size> seed;
-      std::generate_n(seed.data(), seed.size(), std::ref(device));
-      std::seed_seq seq(std::begin(seed), std::end(seed));
-      generator.seed(seq);
-   }
-
-   inline T operator()(const T& mean, const T& stddev) override
-   {
-      std::normal_distribution<T> distribution{mean, stddev};
-      return distribution(generator);
-   }
-
-   std::mt19937 generator;
-};
-
 template <typename T>
 void exprtk_montecarlo_option_pricing_model()
 {
@@ -57,22 +30,37 @@ void exprtk_montecarlo_option_pricing_model()
    typedef exprtk::expression<T>   expression_t;
    typedef exprtk::parser<T>       parser_t;
 
+   /*
+      Simulations are performed in batches, each batch of normal
+      variates is generated by a single call to rnd_normal, and the
+      terminal prices and payoffs are computed as vector operations,
+      where: max(x,0) == (x + |x|) / 2
+
+      Reseeding at the start of each evaluation has both the call and
+      put valuations use the same paths (common random numbers).
+   */
    const std::string exprtk_montecarlo_option_pricing_model_program =
+      " rnd_seed(20250101);                                                  "
+      "                                                                      "
       " var payoff_sum := 0;                                                 "
-      " var sqrt_t     := sqrt(t);                                           "
+      " var z[10^5]    := [0];                                               "
+      " var s_t[10^5]  := [0];                                               "
+      " var drift      := (r - v^2 / 2) * t;                                 "
+      " var diffusion  := v * sqrt(t);                                       "
       "                                                                      "
-      " for (var i := 0; i < n; i += 1)                                      "
+      " for (var i := 0; i < n; i += z[])                                    "
       " {                                                                    "
-      "    var s_t := s * exp((r - v^2 / 2) * t + v * sqrt_t * normal(0,1)); "
+      "    rnd_normal(z);                                                    "
+      "    s_t := s * exp(drift + diffusion * z);                            "
       "    payoff_sum +=                                                     "
       "       switch                                                         "
       "       {                                                              "
-      "          case callput_flag == 'call' : max(s_t - k, 0);              "
-      "          case callput_flag == 'put'  : max(k - s_t, 0);              "
+      "          case callput_flag == 'call' : sum((s_t - k) + abs(s_t - k));"
+      "          case callput_flag == 'put'  : sum((k - s_t) + abs(k - s_t));"
       "       };                                                             "
       " };                                                                   "
       "                                                                      "
-      " exp(-r * t) * payoff_sum / n;                                        ";
+      " exp(-r * t) * payoff_sum / (2 * n);                                  ";
 
    T s = T(100.00); // Spot / Stock / Underlying / Base price
    T k = T(110.00); // Strike price
@@ -83,7 +71,7 @@ void exprtk_montecarlo_option_pricing_model()
 
    std::string callput_flag;
 
-   normal_distribution<T> normal;
+   exprtk::rtl::random::package<T> random_package;
 
    symbol_table_t symbol_table(symbol_table_t::e_immutable);
    symbol_table.add_variable("s",s);
@@ -93,7 +81,7 @@ void exprtk_montecarlo_option_pricing_model()
    symbol_table.add_variable("v",v);
    symbol_table.add_constant("n",n);
    symbol_table.add_stringvar("callput_flag", callput_flag);
-   symbol_table.add_function ("normal"      , normal      );
+   symbol_table.add_package  (random_package);
 
    expression_t expression;
    expression.register_symbol_table(symbol_table);
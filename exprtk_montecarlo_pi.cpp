@@ -18,29 +18,11 @@
 
 
 #include <cstdio>
-#include <cstdlib>
-#include <ctime>
 #include <string>
 
 #include "exprtk.hpp"
 
 
-template <typename T>
-struct rnd_01 : public exprtk::ifunction<T>
-{
-   using exprtk::ifunction<T>::operator();
-
-   rnd_01() : exprtk::ifunction<T>(0)
-   { ::srand(static_cast<unsigned int>(time(NULL))); }
-
-   inline T operator()()
-   {
-      // Note: Do not use this in production
-      // Result is in the interval [0,1)
-      return T(::rand() / T(RAND_MAX + 1.0));
-   }
-};
-
 template <typename T>
 void monte_carlo_pi()
 {
@@ -49,21 +31,24 @@ void monte_carlo_pi()
    typedef exprtk::parser<T>       parser_t;
 
    const std::string monte_carlo_pi_program =
-      " var max_samples := 5 * 10^7;              "
-      " var count       := 0;                     "
-      "                                           "
-      " for (var i := 0; i < max_samples; i += 1) "
-      " {                                         "
-      "    if ((rnd_01^2 + rnd_01^2) <= 1)        "
-      "       count += 1;                         "
-      " };                                        "
-      "                                           "
-      " (4 * count) / max_samples;                ";
-
-   rnd_01<T> rnd01;
+      " var max_samples := 5 * 10^7;                     "
+      " var count       := 0;                            "
+      " var x[10^5]     := [0];                          "
+      " var y[10^5]     := [0];                          "
+      "                                                  "
+      " for (var i := 0; i < max_samples; i += x[])      "
+      " {                                                "
+      "    rnd_uniform(x);                               "
+      "    rnd_uniform(y);                               "
+      "    count += sum((x^2 + y^2) <= 1);               "
+      " };                                               "
+      "                                                  "
+      " (4 * count) / max_samples;                       ";
+
+   exprtk::rtl::random::package<T> random_package;
 
    symbol_table_t symbol_table;
-   symbol_table.add_function("rnd_01",rnd01);
+   symbol_table.add_package(random_package);
 
    expression_t expression;
    expression.register_symbol_table(symbol_table);
@@ -20,17 +20,22 @@
 #include <cstdio>
 #include <string>
 
+/*
+   Back the 800MB real-valued sieve with huge pages (MAP_HUGETLB, falling back
+   to transparent huge pages) so as to reduce TLB misses.
+*/
+#define exprtk_enable_vector_huge_pages
 #include "exprtk.hpp"
 
 
 template <typename T>
-void sieve_of_eratosthenes()
+void sieve_of_eratosthenes(const std::string& sieve_definition)
 {
    typedef exprtk::expression<T> expression_t;
    typedef exprtk::parser<T>     parser_t;
 
    const std::string sieve_of_eratosthenes_program =
-      " var sieve[10^8] := [false];                   "
+      sieve_definition +
       " var m := trunc(sqrt(sieve[]));                "
       "                                               "
       " sieve[0] := true;                             "
@@ -54,7 +59,12 @@ void sieve_of_eratosthenes()
    expression_t expression;
 
    parser_t parser;
-   parser.compile(sieve_of_eratosthenes_program,expression);
+
+   if (!parser.compile(sieve_of_eratosthenes_program,expression))
+   {
+      printf("Error: %s\n", parser.error().c_str());
+      return;
+   }
 
    exprtk::timer timer;
    timer.start();
@@ -63,13 +73,19 @@ void sieve_of_eratosthenes()
 
    timer.stop();
 
-   printf("Result: %8.3f\n",result);
-
-   printf("Total time: %8.3fsec\n",timer.time());
+   printf("[%-36s] Result: %8.3f\tTotal time: %8.3fsec\n",
+          sieve_definition.c_str(),
+          result,
+          timer.time());
 }
 
 int main()
 {
-   sieve_of_eratosthenes<double>();
+   // One value of type T per flag (800MB)
+   sieve_of_eratosthenes<double>("var sieve[10^8] := [false];");
+
+   // One bit per flag (12.5MB)
+   sieve_of_eratosthenes<double>("var sieve[10^8] : bool := [false];");
+
    return 0;
 }
@@ -0,0 +1,192 @@
+/*
+ **************************************************************
+ *         C++ Mathematical Expression Toolkit Library        *
+ *                                                            *
+ * ExprTk Program Set - Black-Scholes-Merton Greeks           *
+ * Author: Arash Partow (1999-2025)                           *
+ * URL: https://www.partow.net/programming/exprtk/index.html  *
+ *                                                            *
+ * Copyright notice:                                          *
+ * Free use of the Mathematical Expression Toolkit Library is *
+ * permitted under the guidelines and in accordance with the  *
+ * most current version of the MIT License.                   *
+ * https://www.opensource.org/licenses/MIT                    *
+ * SPDX-License-Identifier: MIT                               *
+ *                                                            *
+ **************************************************************
+*/
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "exprtk.hpp"
+
+
+std::string replace_all(std::string s, const std::string& from, const std::string& to)
+{
+   for (std::size_t pos = s.find(from); std::string::npos != pos; pos = s.find(from, pos + to.size()))
+   {
+      s.replace(pos, from.size(), to);
+   }
+
+   return s;
+}
+
+template <typename T>
+void bsm_greeks_program_set()
+{
+   typedef exprtk::symbol_table<T> symbol_table_t;
+   typedef exprtk::expression<T>   expression_t;
+   typedef exprtk::parser<T>       parser_t;
+   typedef exprtk::program_set<T>  program_set_t;
+
+   const std::string d1  = "((log(s / k) + (r + v * v / 2) * t) / (v * sqrt(t)))";
+   const std::string d2  = "(D1 - v * sqrt(t))";
+   const std::string pdf = "(exp(-D1 * D1 / 2) / sqrt(2pi))";
+
+   const std::string greek_list[] =
+      {
+         "s * ncdf(D1) - k * exp(-r * t) * ncdf(D2)",
+         "ncdf(D1)",
+         "PDF / (s * v * sqrt(t))",
+         "s * PDF * sqrt(t)",
+         "-s * PDF * v / (2sqrt(t)) - r * k * exp(-r * t) * ncdf(D2)",
+         "k * t * exp(-r * t) * ncdf(D2)"
+      };
+
+   const std::string greek_name[] = { "price", "delta", "gamma", "vega", "theta", "rho" };
+
+   const std::size_t greek_count = sizeof(greek_list) / sizeof(std::string);
+
+   T s = T(60.00);
+   T k = T(65.00);
+   T t = T( 0.25);
+   T r = T( 0.08);
+   T v = T( 0.30);
+
+   symbol_table_t symbol_table;
+   symbol_table.add_variable("s", s);
+   symbol_table.add_variable("k", k);
+   symbol_table.add_variable("t", t);
+   symbol_table.add_variable("r", r);
+   symbol_table.add_variable("v", v);
+   symbol_table.add_pi();
+
+   std::vector<std::string> formula_list;
+
+   for (std::size_t i = 0; i < greek_count; ++i)
+   {
+      std::string formula = greek_list[i];
+      formula = replace_all(formula, "PDF", pdf);
+      formula = replace_all(formula, "D2" , d2 );
+      formula = replace_all(formula, "D1" , d1 );
+      formula_list.push_back(formula);
+   }
+
+   std::vector<expression_t> expression_list(greek_count);
+
+   parser_t parser;
+
+   for (std::size_t i = 0; i < greek_count; ++i)
+   {
+      expression_list[i].register_symbol_table(symbol_table);
+
+      if (!parser.compile(formula_list[i], expression_list[i]))
+      {
+         printf("Error: %s\tExpression: %s\n", parser.error().c_str(), formula_list[i].c_str());
+         return;
+      }
+   }
+
+   program_set_t program_set(symbol_table);
+
+   for (std::size_t i = 0; i < greek_count; ++i)
+   {
+      program_set.add(formula_list[i]);
+   }
+
+   if (!program_set.compile())
+   {
+      printf("Error: %s\n", program_set.error().c_str());
+      return;
+   }
+
+   const std::vector<T>& results = program_set.evaluate();
+
+   for (std::size_t i = 0; i < greek_count; ++i)
+   {
+      const T separate = expression_list[i].value();
+
+      printf("%-5s = %12.8f %12.8f %s\n",
+             greek_name[i].c_str(),
+             separate,
+             results[i],
+             (std::abs(separate - results[i]) <= (T(1e-12) * std::max(T(1), std::abs(separate)))) ? "OK" : "MISMATCH");
+   }
+
+   const std::size_t rounds = 1000000;
+
+   {
+      T total = T(0);
+
+      exprtk::timer timer;
+      timer.start();
+
+      for (std::size_t i = 0; i < rounds; ++i)
+      {
+         s = T(40) + T(i % 400) / T(10);
+
+         for (std::size_t j = 0; j < greek_count; ++j)
+         {
+            total += expression_list[j].value();
+         }
+      }
+
+      timer.stop();
+
+      printf("[separate   ] Total: %16.6f Time: %8.4fsec Rate: %12.3f sets/sec\n",
+             total, timer.time(), rounds / timer.time());
+   }
+
+   {
+      T total = T(0);
+
+      exprtk::timer timer;
+      timer.start();
+
+      for (std::size_t i = 0; i < rounds; ++i)
+      {
+         s = T(40) + T(i % 400) / T(10);
+
+         program_set.evaluate();
+
+         for (std::size_t j = 0; j < greek_count; ++j)
+         {
+            total += results[j];
+         }
+      }
+
+      timer.stop();
+
+      printf("[program set] Total: %16.6f Time: %8.4fsec Rate: %12.3f sets/sec\n",
+             total, timer.time(), rounds / timer.time());
+   }
+}
+
+int main()
+{
+   bsm_greeks_program_set<double>();
+   return 0;
+}
+
+
+/*
+
+   Build:
+   c++ -pedantic-errors -Wall -Wextra -Werror -O3 -DNDEBUG -o exprtk_program_set_greeks exprtk_program_set_greeks.cpp -L/usr/lib -lstdc++ -lm
+
+*/
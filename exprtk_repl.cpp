@@ -23,7 +23,9 @@
 #include <fstream>
 #include <iostream>
 #include <numeric>
+#include <random>
 #include <string>
+#include <thread>
 
 #include "exprtk.hpp"
 
@@ -61,15 +63,20 @@ struct rnd_01 : public exprtk::ifunction<T>
 {
    using exprtk::ifunction<T>::operator();
 
-   rnd_01() : exprtk::ifunction<T>(0)
-   { ::srand(static_cast<unsigned int>(time(NULL))); }
+   // Each instance has its own generator state, seeded from the time plus the stream
+   explicit rnd_01(const unsigned int stream = 0)
+   : exprtk::ifunction<T>(0)
+   , engine_(static_cast<unsigned int>(time(NULL)) + stream)
+   {}
 
    inline T operator()()
    {
       // Note: Do not use this in production
       // Result is in the interval [0,1)
-      return T(::rand() / T(RAND_MAX + 1.0));
+      return T(engine_() / (engine_.max() + 1.0));
    }
+
+   std::mt19937 engine_;
 };
 
 template <typename T>
@@ -98,6 +105,7 @@ public:
    , enable_usr_                (false)
    , disable_local_vardef_      (false)
    , batch_runs_cnt_            (0    )
+   , batch_threads_cnt_         (1    )
    , compositor_(function_symbol_table_)
    #ifdef exprtk_enable_repl_variables
    , s0_("abcdefghijk")
@@ -112,25 +120,7 @@ public:
    {
       symbol_table_.add_constants();
 
-      symbol_table_.add_function("putch"  , putch_  );
-      symbol_table_.add_function("putint" , putint_ );
-      symbol_table_.add_function("rnd_01" , rnd_01_ );
-      symbol_table_.add_package (fileio_package_    );
-      symbol_table_.add_package (vecops_package_    );
-      symbol_table_.add_package (io_package_        );
-
-      symbol_table_.add_function("poly01", poly01_);
-      symbol_table_.add_function("poly02", poly02_);
-      symbol_table_.add_function("poly03", poly03_);
-      symbol_table_.add_function("poly04", poly04_);
-      symbol_table_.add_function("poly05", poly05_);
-      symbol_table_.add_function("poly06", poly06_);
-      symbol_table_.add_function("poly07", poly07_);
-      symbol_table_.add_function("poly08", poly08_);
-      symbol_table_.add_function("poly09", poly09_);
-      symbol_table_.add_function("poly10", poly10_);
-      symbol_table_.add_function("poly11", poly11_);
-      symbol_table_.add_function("poly12", poly12_);
+      register_functions(symbol_table_,rnd_01_);
 
       #ifdef exprtk_enable_repl_variables
       symbol_table_.add_stringvar("s0", s0_);
@@ -295,41 +285,26 @@ public:
          printf("\nCompile time: %6.3fms\n",compile_timer.time() * 1000.0);
       }
 
-      if (batch_runs_cnt_)
+      if (batch_runs_cnt_ && (batch_threads_cnt_ > 1))
       {
-         std::vector<double> timings(batch_runs_cnt_,0.0);
+         process_parallel_batch(program);
+         return;
+      }
+      else if (batch_runs_cnt_)
+      {
+         batch_worker worker(0);
+         worker.compile_time = compile_timer.time() * 1000.0;
 
          exprtk::timer total_timer;
-         exprtk::timer timer;
-
-         T result = T(0);
-
          total_timer.start();
 
-         for (std::size_t i = 0; i < batch_runs_cnt_; ++i)
-         {
-            timer.start();
-
-            result = expression.value();
-
-            timer.stop();
-
-            timings[i] = timer.time() * 1000.0;
-         }
+         run_batch(expression, worker);
 
          total_timer.stop();
 
-         printf("\nResult: %15.9f\n",result);
+         printf("\nResult: %15.9f\n",worker.result);
 
-         std::sort(timings.begin(),timings.end());
-
-         printf("\nRuns: %4d  Time min: %7.3fms   max: %7.3fms   avg: %7.3fms   tot: %7.3fms   90%%:%7.3fms\n",
-                static_cast<unsigned int>(batch_runs_cnt_),
-                timings.front(),
-                timings.back (),
-                std::accumulate(timings.begin(),timings.end(),0.0) / timings.size(),
-                total_timer.time() * 1000.0,
-                timings[static_cast<int>(timings.size() * 0.90)]);
+         print_batch_statistics(std::vector<batch_worker*>(1,&worker),total_timer.time() * 1000.0);
 
          return;
       }
@@ -434,9 +409,16 @@ public:
       else if ("$list_vars" == expression)
          list_symbols();
       else if ("$clear_functions" == expression)
+      {
          clear_functions();
+         save_session_functions();
+      }
+      else if ((0 == expression.find("$function_cache ")) && (expression.size() >= 17))
+         process_function_cache(expression.substr(16,expression.size() - 16));
       else if ((0 == expression.find("$batch_run ")) && (expression.size() >= 12))
          process_batch_run(expression.substr(11,expression.size() - 11));
+      else if ((0 == expression.find("$batch_threads ")) && (expression.size() >= 16))
+         process_batch_threads(expression.substr(15,expression.size() - 15));
       else if ((0 == expression.find("$load ")) && (expression.size() > 7))
          process_from_file(expression.substr(6,expression.size() - 6));
       else if ((0 == expression.find("$disable arithmetic ")) && (expression.size() >= 21))
@@ -557,11 +539,296 @@ private:
       }
    }
 
+   void register_functions(symbol_table_t& symbol_table, rnd_01<T>& rnd_01_func)
+   {
+      symbol_table.add_function("putch"  , putch_     );
+      symbol_table.add_function("putint" , putint_    );
+      symbol_table.add_function("rnd_01" , rnd_01_func);
+      symbol_table.add_package (fileio_package_    );
+      symbol_table.add_package (vecops_package_    );
+      symbol_table.add_package (io_package_        );
+
+      symbol_table.add_function("poly01", poly01_);
+      symbol_table.add_function("poly02", poly02_);
+      symbol_table.add_function("poly03", poly03_);
+      symbol_table.add_function("poly04", poly04_);
+      symbol_table.add_function("poly05", poly05_);
+      symbol_table.add_function("poly06", poly06_);
+      symbol_table.add_function("poly07", poly07_);
+      symbol_table.add_function("poly08", poly08_);
+      symbol_table.add_function("poly09", poly09_);
+      symbol_table.add_function("poly10", poly10_);
+      symbol_table.add_function("poly11", poly11_);
+      symbol_table.add_function("poly12", poly12_);
+   }
+
    void process_batch_run(const std::string& batch_runs_cnt)
    {
       batch_runs_cnt_ = atoi(batch_runs_cnt.c_str());
    }
 
+   void process_batch_threads(const std::string& batch_threads_cnt)
+   {
+      const int threads = atoi(batch_threads_cnt.c_str());
+
+      batch_threads_cnt_ = (threads > 0) ? threads : 1;
+   }
+
+   struct batch_worker
+   {
+      explicit batch_worker(const unsigned int stream)
+      : compositor(function_symbol_table)
+      , rnd_01_func(stream)
+      , compile_time(0.0)
+      , result(T(0))
+      , compiled(false)
+      {}
+
+      symbol_table_t             symbol_table;
+      symbol_table_t             function_symbol_table;
+      compositor_t               compositor;
+      rnd_01<T>                  rnd_01_func;
+      std::deque<std::vector<T>> vector_store;
+      std::vector<double>        timings;
+      double                     compile_time;
+      T                          result;
+      bool                       compiled;
+   };
+
+   /*
+      A single evaluation can be far shorter than the timer resolution,
+      so evaluations are timed in blocks, the block size doubling until
+      a block takes at least min_block_time, and shorter blocks being
+      merged until they do. Each evaluation is recorded with the mean
+      time of its block, so latency percentiles reflect blocks rather
+      than individual evaluations.
+   */
+   void run_batch(expression_t& expression, batch_worker& worker)
+   {
+      static const double min_block_time = 0.05; // ms
+
+      worker.timings.clear();
+      worker.timings.reserve(batch_runs_cnt_);
+
+      exprtk::timer timer;
+
+      std::size_t block_size   = 1;
+      std::size_t pending      = 0;
+      double      pending_time = 0.0;
+
+      for (std::size_t runs = 0; runs < batch_runs_cnt_; )
+      {
+         const std::size_t block = std::min(block_size, batch_runs_cnt_ - runs);
+
+         timer.start();
+
+         for (std::size_t i = 0; i < block; ++i)
+         {
+            worker.result = expression.value();
+         }
+
+         timer.stop();
+
+         runs         += block;
+         pending      += block;
+         pending_time += timer.time() * 1000.0;
+
+         if ((pending_time >= min_block_time) || (runs == batch_runs_cnt_))
+         {
+            worker.timings.insert(worker.timings.end(), pending, pending_time / pending);
+
+            pending      = 0;
+            pending_time = 0.0;
+         }
+         else if (block == block_size)
+         {
+            block_size *= 2;
+         }
+      }
+   }
+
+   /*
+      Give the worker its own copy of the variables, strings and vectors
+      of the global symbol table, and its own instances of the composited
+      functions, so that no evaluation state is shared between threads.
+      Each worker also has its own rnd_01 generator. The other native
+      functions and packages hold no state and are shared, though the
+      output of the I/O functions of different workers may interleave.
+   */
+   void clone_symbol_tables(batch_worker& worker)
+   {
+      symbol_table_t& symbol_table = worker.symbol_table;
+
+      symbol_table.add_constants();
+      register_functions(symbol_table,worker.rnd_01_func);
+
+      std::vector<std::pair<std::string,T> > variable_list;
+      symbol_table_.get_variable_list(variable_list);
+
+      for (std::size_t i = 0; i < variable_list.size(); ++i)
+      {
+         const std::string& name = variable_list[i].first;
+
+         if (symbol_table.symbol_exists(name))
+            continue;
+         else if (symbol_table_.is_constant_node(name))
+            symbol_table.add_constant(name,variable_list[i].second);
+         else
+            symbol_table.create_variable(name,variable_list[i].second);
+      }
+
+      std::vector<std::pair<std::string,std::string> > stringvar_list;
+      symbol_table_.get_stringvar_list(stringvar_list);
+
+      for (std::size_t i = 0; i < stringvar_list.size(); ++i)
+      {
+         symbol_table.create_stringvar(stringvar_list[i].first,stringvar_list[i].second);
+      }
+
+      std::vector<std::string> vector_list;
+      symbol_table_.get_vector_list(vector_list);
+
+      for (std::size_t i = 0; i < vector_list.size(); ++i)
+      {
+         typename symbol_table_t::vector_holder_ptr vector = symbol_table_.get_vector(vector_list[i]);
+
+         worker.vector_store.push_back(std::vector<T>(vector->data(), vector->data() + vector->size()));
+         symbol_table.add_vector(vector_list[i],worker.vector_store.back());
+      }
+
+      worker.compositor.add_auxiliary_symtab(symbol_table);
+
+      for (std::size_t i = 0; i < func_def_list_.size(); ++i)
+      {
+         worker.compositor.add(make_function(func_def_list_[i]),true);
+      }
+   }
+
+   void process_parallel_batch(const std::string& program)
+   {
+      std::deque<batch_worker> worker_list;
+
+      for (std::size_t i = 0; i < batch_threads_cnt_; ++i)
+      {
+         worker_list.emplace_back(static_cast<unsigned int>(i + 1));
+         clone_symbol_tables(worker_list.back());
+      }
+
+      typename parser_t::settings_t settings = parser_.settings();
+
+      std::vector<std::thread> thread_list;
+
+      exprtk::timer total_timer;
+      total_timer.start();
+
+      for (std::size_t i = 0; i < worker_list.size(); ++i)
+      {
+         batch_worker& worker = worker_list[i];
+
+         thread_list.emplace_back(
+            std::thread([this, &worker, &program, &settings]()
+                        {
+                           expression_t expression;
+                           expression.register_symbol_table(worker.symbol_table);
+                           expression.register_symbol_table(worker.function_symbol_table);
+
+                           parser_t parser(settings);
+
+                           if (enable_usr_)
+                              parser.enable_unknown_symbol_resolver();
+
+                           exprtk::timer compile_timer;
+                           compile_timer.start();
+
+                           worker.compiled = parser.compile(program,expression);
+
+                           compile_timer.stop();
+
+                           worker.compile_time = compile_timer.time() * 1000.0;
+
+                           if (worker.compiled)
+                           {
+                              run_batch(expression, worker);
+                           }
+                        }));
+      }
+
+      for (auto& t : thread_list)
+      {
+         t.join();
+      }
+
+      total_timer.stop();
+
+      std::vector<batch_worker*> compiled_list;
+
+      for (std::size_t i = 0; i < worker_list.size(); ++i)
+      {
+         if (worker_list[i].compiled)
+            compiled_list.push_back(&worker_list[i]);
+      }
+
+      if (compiled_list.size() != worker_list.size())
+      {
+         printf("\nERROR - %d of %d workers failed to compile the program\n",
+                static_cast<int>(worker_list.size() - compiled_list.size()),
+                static_cast<int>(worker_list.size()));
+
+         return;
+      }
+
+      printf("\nResult: %15.9f\n",compiled_list.front()->result);
+
+      print_batch_statistics(compiled_list,total_timer.time() * 1000.0);
+   }
+
+   void print_batch_statistics(const std::vector<batch_worker*>& worker_list, const double total_time)
+   {
+      std::vector<double> timings;
+      std::vector<double> compile_timings;
+
+      for (std::size_t i = 0; i < worker_list.size(); ++i)
+      {
+         timings.insert(timings.end(), worker_list[i]->timings.begin(), worker_list[i]->timings.end());
+         compile_timings.push_back(worker_list[i]->compile_time);
+      }
+
+      std::sort(timings.begin(),timings.end());
+      std::sort(compile_timings.begin(),compile_timings.end());
+
+      const double evaluation_time = std::accumulate(timings.begin(),timings.end(),0.0);
+      const double compile_time    = std::accumulate(compile_timings.begin(),compile_timings.end(),0.0);
+
+      printf("\nThreads: %d  Runs: %d  Throughput: %12.1f evals/sec\n",
+             static_cast<int>(worker_list.size()),
+             static_cast<int>(timings.size()),
+             timings.size() / (total_time / 1000.0));
+
+      printf("Latency  min: %9.3fus  p50: %9.3fus  p90: %9.3fus  p99: %9.3fus  p99.9: %9.3fus  max: %9.3fus  avg: %9.3fus\n",
+             1000.0 * timings.front(),
+             1000.0 * percentile(timings,0.500),
+             1000.0 * percentile(timings,0.900),
+             1000.0 * percentile(timings,0.990),
+             1000.0 * percentile(timings,0.999),
+             1000.0 * timings.back (),
+             1000.0 * evaluation_time / timings.size());
+
+      printf("Compile  min: %7.3fms  max: %7.3fms  tot: %7.3fms  Evaluation tot: %7.3fms  Wall: %7.3fms  Compile share: %5.2f%%\n",
+             compile_timings.front(),
+             compile_timings.back (),
+             compile_time,
+             evaluation_time,
+             total_time,
+             (100.0 * compile_time) / (compile_time + evaluation_time));
+   }
+
+   static double percentile(const std::vector<double>& sorted_timings, const double p)
+   {
+      const std::size_t index = static_cast<std::size_t>(p * (sorted_timings.size() - 1) + 0.5);
+
+      return sorted_timings[std::min(index, sorted_timings.size() - 1)];
+   }
+
    void process_multiline()
    {
       std::string program;
@@ -611,11 +878,41 @@ private:
 
    struct parse_function_definition_impl : public exprtk::lexer::parser_helper
    {
-      func_parse_result process(std::string& func_def, function_definition& fd)
+      /*
+         Lex the program once, then split off each leading function
+         definition in turn, leaving the remainder of the program.
+      */
+      func_parse_result process(std::string& func_def, std::vector<function_definition>& fd_list)
       {
          if (!init(func_def))
             return e_parse_lexfail;
 
+         std::size_t program_begin = 0;
+
+         func_parse_result result = e_parse_notfunc;
+
+         for ( ; ; )
+         {
+            function_definition fd;
+
+            result = process(func_def, fd, program_begin);
+
+            if (e_parse_success != result)
+               break;
+
+            fd_list.push_back(fd);
+         }
+
+         if (program_begin < func_def.size())
+            func_def = func_def.substr(program_begin,func_def.size() - program_begin);
+         else
+            func_def = "";
+
+         return (e_parse_notfunc == result) ? e_parse_success : result;
+      }
+
+      func_parse_result process(const std::string& func_def, function_definition& fd, std::size_t& program_begin)
+      {
          if (!token_is(token_t::e_symbol,"function"))
             return e_parse_notfunc;
 
@@ -685,21 +982,141 @@ private:
 
          fd.body = func_def.substr(body_begin,size);
 
-         const std::size_t index = body_begin + size;
-
-         if (index < func_def.size())
-            func_def = func_def.substr(index,func_def.size() - index);
-         else
-            func_def = "";
+         program_begin = body_begin + size;
 
          return e_parse_success;
       }
    };
 
-   func_parse_result parse_function_definition(std::string& func_def, function_definition& cf)
+   /*
+      Enable the on-disk function cache in an existing directory. The
+      functions defined interactively are kept in its session file and
+      are restored when the cache is next enabled.
+   */
+   void process_function_cache(const std::string& directory)
    {
-      parse_function_definition_impl parser;
-      return parser.process(func_def,cf);
+      if ("off" == directory)
+      {
+         function_cache_dir_.clear();
+         return;
+      }
+
+      function_cache_dir_ = directory;
+
+      std::vector<function_definition> fd_list;
+
+      if (load_function_cache(session_file(),fd_list))
+      {
+         add_function_definitions(fd_list,true);
+      }
+   }
+
+   std::string session_file() const
+   {
+      return function_cache_dir_ + "/session.fdc";
+   }
+
+   void save_session_functions()
+   {
+      if (!function_cache_dir_.empty())
+      {
+         save_function_cache(session_file(),session_func_def_list_);
+      }
+   }
+
+   /*
+      Cache file layout:
+         exprtk_repl_function_cache <version>
+         function <name> <var count> <body size>
+         <var> (one per line)
+         <body bytes>
+         ...
+         end
+   */
+   bool save_function_cache(const std::string& file_name,
+                            const std::vector<function_definition>& fd_list) const
+   {
+      std::ofstream stream(file_name.c_str(), std::ios::binary);
+
+      if (!stream)
+      {
+         printf("ERROR: Failed to write function cache: %s\n",file_name.c_str());
+         return false;
+      }
+
+      stream << "exprtk_repl_function_cache " << function_cache_version << "\n";
+
+      for (std::size_t i = 0; i < fd_list.size(); ++i)
+      {
+         const function_definition& fd = fd_list[i];
+
+         stream << "function " << fd.name << " " << fd.var_list.size() << " " << fd.body.size() << "\n";
+
+         for (std::size_t j = 0; j < fd.var_list.size(); ++j)
+         {
+            stream << fd.var_list[j] << "\n";
+         }
+
+         stream << fd.body << "\n";
+      }
+
+      stream << "end\n";
+
+      return static_cast<bool>(stream);
+   }
+
+   bool load_function_cache(const std::string& file_name,
+                            std::vector<function_definition>& fd_list) const
+   {
+      std::ifstream stream(file_name.c_str(), std::ios::binary);
+
+      std::string tag;
+      int version = 0;
+
+      if (!(stream >> tag >> version) || ("exprtk_repl_function_cache" != tag) || (function_cache_version != version))
+         return false;
+
+      std::vector<function_definition> cached_list;
+
+      for ( ; ; )
+      {
+         std::size_t size = 0;
+
+         if (!(stream >> tag))
+            return false;
+         else if ("end" == tag)
+         {
+            fd_list.swap(cached_list);
+
+            return true;
+         }
+         else if ("function" != tag)
+            return false;
+
+         function_definition fd;
+         std::size_t var_count = 0;
+
+         if (!(stream >> fd.name >> var_count >> size))
+            return false;
+
+         fd.var_list.resize(var_count);
+
+         for (std::size_t i = 0; i < var_count; ++i)
+         {
+            if (!(stream >> fd.var_list[i]))
+               return false;
+         }
+
+         if (stream.get() != '\n')
+            return false;
+
+         fd.body.resize(size);
+
+         if (size && !stream.read(&fd.body[0], size))
+            return false;
+
+         cached_list.push_back(fd);
+      }
    }
 
    std::string read_from_stdin()
@@ -739,75 +1156,125 @@ private:
             func_def.erase(func_def.begin());
       }
 
-      do
+      std::vector<function_definition> fd_list;
+
+      const bool parsed = parse_function_definitions(func_def,fd_list);
+
+      const std::size_t session_count = session_func_def_list_.size();
+
+      const bool added = add_function_definitions(fd_list,read_stdin);
+
+      // Loaded functions can also replace session functions of the same name
+      if (read_stdin || (session_count != session_func_def_list_.size()))
       {
-         function_definition fd;
+         save_session_functions();
+      }
 
-         func_parse_result fp_result = parse_function_definition(func_def,fd);
+      if (!added)
+         return;
+      else if (!parsed)
+      {
+         printf("Error - Critical parsing error - partial parse occurred\n");
+         return;
+      }
 
-         if (e_parse_success == fp_result)
+      if (!func_def.empty())
+      {
+         process(func_def);
+      }
+   }
+
+   // Split the leading function definitions off the program
+   bool parse_function_definitions(std::string& func_def, std::vector<function_definition>& fd_list)
+   {
+      parse_function_definition_impl parser;
+      return (e_parse_success == parser.process(func_def,fd_list));
+   }
+
+   /*
+      Functions defined interactively, or restored from the session file,
+      are also kept in the session list. Only those are saved to the
+      session file, not the functions of loaded programs.
+   */
+   bool add_function_definitions(const std::vector<function_definition>& fd_list, const bool session = false)
+   {
+      for (std::size_t i = 0; i < fd_list.size(); ++i)
+      {
+         if (!add_function_definition(fd_list[i],session))
+            return false;
+      }
+
+      return true;
+   }
+
+   static void remove_function_definition(std::vector<function_definition>& fd_list, const std::string& name)
+   {
+      for (std::size_t i = 0; i < fd_list.size(); ++i)
+      {
+         if (exprtk::details::imatch(name, fd_list[i].name))
          {
-            std::string vars;
+            fd_list.erase(fd_list.begin() + i);
 
-            for (std::size_t i = 0; i < fd.var_list.size(); ++i)
-            {
-               vars += fd.var_list[i] + ((i < fd.var_list.size() - 1) ? "," : "");
-            }
+            break;
+         }
+      }
+   }
 
-            function_t f(fd.name);
+   bool add_function_definition(const function_definition& fd, const bool session = false)
+   {
+      std::string vars;
 
-            for (std::size_t i = 0; i < fd.var_list.size(); ++i)
-            {
-               f.var(fd.var_list[i]);
-            }
+      for (std::size_t i = 0; i < fd.var_list.size(); ++i)
+      {
+         vars += fd.var_list[i] + ((i < fd.var_list.size() - 1) ? "," : "");
+      }
 
-            f.expression(fd.body);
+      const function_t f = make_function(fd);
 
-            if (function_symbol_table_.get_function(fd.name))
-            {
-               function_symbol_table_.remove_function(fd.name);
+      if (function_symbol_table_.get_function(fd.name))
+      {
+         function_symbol_table_.remove_function(fd.name);
 
-               for (std::size_t i = 0; i < func_def_list_.size(); ++i)
-               {
-                  if (exprtk::details::imatch(fd.name, func_def_list_[i].name))
-                  {
-                     func_def_list_.erase(func_def_list_.begin() + i);
+         remove_function_definition(func_def_list_        , fd.name);
+         remove_function_definition(session_func_def_list_, fd.name);
+      }
 
-                     break;
-                  }
-               }
-            }
+      if (!compositor_.add(f,true))
+      {
+         function_symbol_table_.remove_function(fd.name);
 
-            if (!compositor_.add(f,true))
-            {
-               function_symbol_table_.remove_function(fd.name);
+         printf("Error - Failed to add function: %s\n",fd.name.c_str());
 
-               printf("Error - Failed to add function: %s\n",fd.name.c_str());
+         return false;
+      }
 
-               return;
-            }
+      printf("Function[%02d]\n",static_cast<int>(func_def_list_.size()));
+      printf("Name: %s      \n",fd.name.c_str()                        );
+      printf("Vars: (%s)    \n",vars.c_str()                           );
+      printf("------------------------------------------------------\n");
 
-            printf("Function[%02d]\n",static_cast<int>(func_def_list_.size()));
-            printf("Name: %s      \n",fd.name.c_str()                        );
-            printf("Vars: (%s)    \n",vars.c_str()                           );
-            printf("------------------------------------------------------\n");
+      func_def_list_.push_back(fd);
 
-            func_def_list_.push_back(fd);
-         }
-         else if (e_parse_notfunc != fp_result)
-         {
-            printf("Error - Critical parsing error - partial parse occurred\n");
-            return;
-         }
-         else
-            break;
+      if (session)
+      {
+         session_func_def_list_.push_back(fd);
       }
-      while (!func_def.empty());
 
-      if (!func_def.empty())
+      return true;
+   }
+
+   function_t make_function(const function_definition& fd) const
+   {
+      function_t f(fd.name);
+
+      for (std::size_t i = 0; i < fd.var_list.size(); ++i)
       {
-         process(func_def);
+         f.var(fd.var_list[i]);
       }
+
+      f.expression(fd.body);
+
+      return f;
    }
 
    void list_symbols()
@@ -843,7 +1310,8 @@ private:
 
    void clear_functions()
    {
-      func_def_list_.clear();
+      func_def_list_        .clear();
+      session_func_def_list_.clear();
       function_symbol_table_.clear();
    }
 
@@ -946,6 +1414,10 @@ private:
    bool enable_usr_;
    bool disable_local_vardef_;
    std::size_t batch_runs_cnt_;
+   std::size_t batch_threads_cnt_;
+   std::string function_cache_dir_;
+
+   static const int function_cache_version = 2;
 
    symbol_table_t symbol_table_;
    symbol_table_t function_symbol_table_;
@@ -973,6 +1445,7 @@ private:
    exprtk::polynomial<T,12> poly12_;
 
    std::vector<function_definition> func_def_list_;
+   std::vector<function_definition> session_func_def_list_;
 
    std::map<std::string,typename settings_store_t::settings_arithmetic_opr> arith_opr_;
    std::map<std::string,typename settings_store_t::settings_assignment_opr> assign_opr_;
@@ -995,6 +1468,11 @@ void repl(int argc, char* argv[])
 {
    expression_processor<T> processor;
 
+   if (const char* cache_dir = getenv("EXPRTK_REPL_CACHE_DIR"))
+   {
+      processor.process_directive(std::string("$function_cache ") + cache_dir);
+   }
+
    if (argc > 1)
    {
       for (int i = 1; i < argc; ++i)
@@ -1062,9 +1540,26 @@ REPL commands:
   $clear_functions
   Clear all functions found in the global function symbol table.
 
+  $function_cache <directory>/off
+  Keep the interactively defined functions in the given existing
+  directory across sessions. The functions of loaded files are not
+  kept. It can be enabled at startup via the EXPRTK_REPL_CACHE_DIR
+  variable.
+
   $load <program file name>
   Load the file as a complete program and execute.
 
+  $batch_run <runs>
+  Evaluate each following program the given number of times and
+  report throughput, latency percentiles and compile time. Short
+  evaluations are timed in blocks, the latency of each being its
+  block's mean. A count of zero returns to single evaluations.
+
+  $batch_threads <threads>
+  Run batches on the given number of threads, each worker compiling
+  its own copy of the program against its own copy of the symbol
+  tables. The runs count applies per worker.
+
   $begin/$end
   Pre/post-ambles for multiline expressions.
 
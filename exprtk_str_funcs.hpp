@@ -20,15 +20,535 @@
 #define INCLUDE_EXPRTK_STR_FUNCS_HPP
 
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+
 #include "exprtk.hpp"
 
 
+/*
+   SSE2 kernels are used whenever the target guarantees SSE2. With GCC
+   and Clang on x86 AVX2 kernels are also built, and are selected at
+   runtime when the CPU supports them. Define exprtk_disable_simd_str_funcs
+   to use the scalar kernels only.
+*/
+#ifndef exprtk_disable_simd_str_funcs
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#      define exprtk_simd_str_funcs_sse2
+#      include <emmintrin.h>
+#   endif
+#   if defined(exprtk_simd_str_funcs_sse2) &&                \
+       (defined(__GNUC__) || defined(__clang__))  &&          \
+       (defined(__x86_64__) || defined(__i386__))
+#      define exprtk_simd_str_funcs_avx2
+#      define exprtk_simd_str_funcs_avx2_target __attribute__((target("avx2")))
+#      include <immintrin.h>
+#   endif
+#endif
+
+
 namespace exprtk
 {
    namespace helper
    {
       namespace details
       {
+         namespace kernel
+         {
+            struct char_set
+            {
+               static const std::size_t max_simd_chars = 8;
+
+               char_set(const char* s, const std::size_t n)
+               : count(0)
+               {
+                  std::fill_n(table, 256, false);
+                  std::fill_n(list , max_simd_chars, '\0');
+
+                  for (std::size_t i = 0; i < n; ++i)
+                  {
+                     const unsigned char c = static_cast<unsigned char>(s[i]);
+
+                     if (table[c])
+                        continue;
+
+                     table[c] = true;
+
+                     if (count < max_simd_chars)
+                     {
+                        list[count] = s[i];
+                     }
+
+                     ++count;
+                  }
+               }
+
+               inline bool contains(const char c) const
+               {
+                  return table[static_cast<unsigned char>(c)];
+               }
+
+               // Sets of up to max_simd_chars are matched with one compare per character
+               inline bool vectorisable() const
+               {
+                  return (0 < count) && (count <= max_simd_chars);
+               }
+
+               bool        table[256];
+               char        list[max_simd_chars];
+               std::size_t count;
+            };
+
+            inline const char_set& whitespace()
+            {
+               static const char_set ws(" \t\n\v\f\r", 6);
+               return ws;
+            }
+
+            inline bool avx2_available()
+            {
+               #ifdef exprtk_simd_str_funcs_avx2
+               static const bool available = (0 != __builtin_cpu_supports("avx2"));
+               return available;
+               #else
+               return false;
+               #endif
+            }
+
+            inline std::size_t first_bit(unsigned int mask)
+            {
+               #if defined(__GNUC__) || defined(__clang__)
+               return static_cast<std::size_t>(__builtin_ctz(mask));
+               #else
+               std::size_t i = 0;
+               while (0 == (mask & 1)) { mask >>= 1; ++i; }
+               return i;
+               #endif
+            }
+
+            inline std::size_t last_bit(unsigned int mask)
+            {
+               #if defined(__GNUC__) || defined(__clang__)
+               return static_cast<std::size_t>(31 - __builtin_clz(mask));
+               #else
+               std::size_t i = 0;
+               while (mask >>= 1) { ++i; }
+               return i;
+               #endif
+            }
+
+            // Flip the case of every character in [lo,hi], lo and hi being ASCII letters
+            inline void convert_case_scalar(char* s, const std::size_t n, const char lo, const char hi)
+            {
+               for (std::size_t i = 0; i < n; ++i)
+               {
+                  if ((lo <= s[i]) && (s[i] <= hi))
+                  {
+                     s[i] ^= 0x20;
+                  }
+               }
+            }
+
+            // Index of the first character not in the set, n when there is none
+            inline std::size_t span_leading_scalar(const char* s, const std::size_t n, const char_set& set)
+            {
+               std::size_t i = 0;
+
+               while ((i < n) && set.contains(s[i]))
+               {
+                  ++i;
+               }
+
+               return i;
+            }
+
+            // One past the index of the last character not in the set, 0 when there is none
+            inline std::size_t span_trailing_scalar(const char* s, const std::size_t n, const char_set& set)
+            {
+               std::size_t i = n;
+
+               while ((i > 0) && set.contains(s[i - 1]))
+               {
+                  --i;
+               }
+
+               return i;
+            }
+
+            // Copies the characters not in the set from src to dst, dst may equal src
+            inline std::size_t remove_set_scalar(char* dst, const char* src, const std::size_t n, const char_set& set)
+            {
+               std::size_t j = 0;
+
+               for (std::size_t i = 0; i < n; ++i)
+               {
+                  if (!set.contains(src[i]))
+                  {
+                     dst[j++] = src[i];
+                  }
+               }
+
+               return j;
+            }
+
+            #ifdef exprtk_simd_str_funcs_sse2
+            inline __m128i sse2_set_mask(const __m128i x, const __m128i* set_reg, const std::size_t count)
+            {
+               __m128i mask = _mm_cmpeq_epi8(x, set_reg[0]);
+
+               for (std::size_t k = 1; k < count; ++k)
+               {
+                  mask = _mm_or_si128(mask, _mm_cmpeq_epi8(x, set_reg[k]));
+               }
+
+               return mask;
+            }
+
+            inline void convert_case_sse2(char* s, const std::size_t n, const char lo, const char hi)
+            {
+               const __m128i lo_v = _mm_set1_epi8(static_cast<char>(lo - 1));
+               const __m128i hi_v = _mm_set1_epi8(static_cast<char>(hi + 1));
+               const __m128i flip = _mm_set1_epi8(0x20);
+
+               std::size_t i = 0;
+
+               for ( ; (i + 16) <= n; i += 16)
+               {
+                  __m128i* p = reinterpret_cast<__m128i*>(s + i);
+
+                  const __m128i x = _mm_loadu_si128(p);
+                  const __m128i m = _mm_and_si128(_mm_cmpgt_epi8(x, lo_v), _mm_cmplt_epi8(x, hi_v));
+
+                  _mm_storeu_si128(p, _mm_xor_si128(x, _mm_and_si128(m, flip)));
+               }
+
+               convert_case_scalar(s + i, n - i, lo, hi);
+            }
+
+            inline std::size_t span_leading_sse2(const char* s, const std::size_t n, const char_set& set)
+            {
+               __m128i set_reg[char_set::max_simd_chars];
+
+               for (std::size_t k = 0; k < set.count; ++k)
+               {
+                  set_reg[k] = _mm_set1_epi8(set.list[k]);
+               }
+
+               std::size_t i = 0;
+
+               for ( ; (i + 16) <= n; i += 16)
+               {
+                  const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                  const unsigned int outside = 0xFFFFu & ~static_cast<unsigned int>(
+                     _mm_movemask_epi8(sse2_set_mask(x, set_reg, set.count)));
+
+                  if (outside)
+                     return i + first_bit(outside);
+               }
+
+               return i + span_leading_scalar(s + i, n - i, set);
+            }
+
+            inline std::size_t span_trailing_sse2(const char* s, const std::size_t n, const char_set& set)
+            {
+               __m128i set_reg[char_set::max_simd_chars];
+
+               for (std::size_t k = 0; k < set.count; ++k)
+               {
+                  set_reg[k] = _mm_set1_epi8(set.list[k]);
+               }
+
+               std::size_t i = n;
+
+               for ( ; i >= 16; i -= 16)
+               {
+                  const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i - 16));
+                  const unsigned int outside = 0xFFFFu & ~static_cast<unsigned int>(
+                     _mm_movemask_epi8(sse2_set_mask(x, set_reg, set.count)));
+
+                  if (outside)
+                     return i - 16 + last_bit(outside) + 1;
+               }
+
+               return span_trailing_scalar(s, i, set);
+            }
+
+            inline std::size_t remove_set_sse2(char* s, const std::size_t n, const char_set& set)
+            {
+               __m128i set_reg[char_set::max_simd_chars];
+
+               for (std::size_t k = 0; k < set.count; ++k)
+               {
+                  set_reg[k] = _mm_set1_epi8(set.list[k]);
+               }
+
+               std::size_t i = 0;
+               std::size_t j = 0;
+
+               // Blocks without a removed character are moved whole, j never passes i
+               for ( ; (i + 16) <= n; i += 16)
+               {
+                  const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                  const unsigned int removed = static_cast<unsigned int>(
+                     _mm_movemask_epi8(sse2_set_mask(x, set_reg, set.count)));
+
+                  if (0 == removed)
+                  {
+                     _mm_storeu_si128(reinterpret_cast<__m128i*>(s + j), x);
+                     j += 16;
+                  }
+                  else if (0xFFFFu != removed)
+                  {
+                     for (std::size_t k = 0; k < 16; ++k)
+                     {
+                        if (0 == (removed & (1u << k)))
+                        {
+                           s[j++] = s[i + k];
+                        }
+                     }
+                  }
+               }
+
+               return j + remove_set_scalar(s + j, s + i, n - i, set);
+            }
+            #endif
+
+            #ifdef exprtk_simd_str_funcs_avx2
+            inline exprtk_simd_str_funcs_avx2_target
+            __m256i avx2_set_mask(const __m256i x, const __m256i* set_reg, const std::size_t count)
+            {
+               __m256i mask = _mm256_cmpeq_epi8(x, set_reg[0]);
+
+               for (std::size_t k = 1; k < count; ++k)
+               {
+                  mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(x, set_reg[k]));
+               }
+
+               return mask;
+            }
+
+            inline exprtk_simd_str_funcs_avx2_target
+            void convert_case_avx2(char* s, const std::size_t n, const char lo, const char hi)
+            {
+               const __m256i lo_v = _mm256_set1_epi8(static_cast<char>(lo - 1));
+               const __m256i hi_v = _mm256_set1_epi8(static_cast<char>(hi + 1));
+               const __m256i flip = _mm256_set1_epi8(0x20);
+
+               std::size_t i = 0;
+
+               for ( ; (i + 32) <= n; i += 32)
+               {
+                  __m256i* p = reinterpret_cast<__m256i*>(s + i);
+
+                  const __m256i x = _mm256_loadu_si256(p);
+                  const __m256i m = _mm256_and_si256(_mm256_cmpgt_epi8(x, lo_v), _mm256_cmpgt_epi8(hi_v, x));
+
+                  _mm256_storeu_si256(p, _mm256_xor_si256(x, _mm256_and_si256(m, flip)));
+               }
+
+               convert_case_scalar(s + i, n - i, lo, hi);
+            }
+
+            inline exprtk_simd_str_funcs_avx2_target
+            std::size_t span_leading_avx2(const char* s, const std::size_t n, const char_set& set)
+            {
+               __m256i set_reg[char_set::max_simd_chars];
+
+               for (std::size_t k = 0; k < set.count; ++k)
+               {
+                  set_reg[k] = _mm256_set1_epi8(set.list[k]);
+               }
+
+               std::size_t i = 0;
+
+               for ( ; (i + 32) <= n; i += 32)
+               {
+                  const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+                  const unsigned int outside = ~static_cast<unsigned int>(
+                     _mm256_movemask_epi8(avx2_set_mask(x, set_reg, set.count)));
+
+                  if (outside)
+                     return i + first_bit(outside);
+               }
+
+               return i + span_leading_scalar(s + i, n - i, set);
+            }
+
+            inline exprtk_simd_str_funcs_avx2_target
+            std::size_t span_trailing_avx2(const char* s, const std::size_t n, const char_set& set)
+            {
+               __m256i set_reg[char_set::max_simd_chars];
+
+               for (std::size_t k = 0; k < set.count; ++k)
+               {
+                  set_reg[k] = _mm256_set1_epi8(set.list[k]);
+               }
+
+               std::size_t i = n;
+
+               for ( ; i >= 32; i -= 32)
+               {
+                  const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i - 32));
+                  const unsigned int outside = ~static_cast<unsigned int>(
+                     _mm256_movemask_epi8(avx2_set_mask(x, set_reg, set.count)));
+
+                  if (outside)
+                     return i - 32 + last_bit(outside) + 1;
+               }
+
+               return span_trailing_scalar(s, i, set);
+            }
+
+            inline exprtk_simd_str_funcs_avx2_target
+            std::size_t remove_set_avx2(char* s, const std::size_t n, const char_set& set)
+            {
+               __m256i set_reg[char_set::max_simd_chars];
+
+               for (std::size_t k = 0; k < set.count; ++k)
+               {
+                  set_reg[k] = _mm256_set1_epi8(set.list[k]);
+               }
+
+               std::size_t i = 0;
+               std::size_t j = 0;
+
+               for ( ; (i + 32) <= n; i += 32)
+               {
+                  const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+                  const unsigned int removed = static_cast<unsigned int>(
+                     _mm256_movemask_epi8(avx2_set_mask(x, set_reg, set.count)));
+
+                  if (0 == removed)
+                  {
+                     _mm256_storeu_si256(reinterpret_cast<__m256i*>(s + j), x);
+                     j += 32;
+                  }
+                  else if (0xFFFFFFFFu != removed)
+                  {
+                     for (std::size_t k = 0; k < 32; ++k)
+                     {
+                        if (0 == (removed & (1u << k)))
+                        {
+                           s[j++] = s[i + k];
+                        }
+                     }
+                  }
+               }
+
+               return j + remove_set_scalar(s + j, s + i, n - i, set);
+            }
+            #endif
+
+            inline void convert_case(char* s, const std::size_t n, const char lo, const char hi)
+            {
+               #ifdef exprtk_simd_str_funcs_avx2
+               if ((n >= 32) && avx2_available())
+               {
+                  convert_case_avx2(s, n, lo, hi);
+                  return;
+               }
+               #endif
+
+               #ifdef exprtk_simd_str_funcs_sse2
+               if (n >= 16)
+               {
+                  convert_case_sse2(s, n, lo, hi);
+                  return;
+               }
+               #endif
+
+               convert_case_scalar(s, n, lo, hi);
+            }
+
+            // Spans are usually short, so strings under 64 characters are scanned directly
+            inline std::size_t span_leading(const char* s, const std::size_t n, const char_set& set)
+            {
+               #ifdef exprtk_simd_str_funcs_avx2
+               if ((n >= 64) && set.vectorisable() && avx2_available())
+                  return span_leading_avx2(s, n, set);
+               #endif
+
+               #ifdef exprtk_simd_str_funcs_sse2
+               if ((n >= 64) && set.vectorisable())
+                  return span_leading_sse2(s, n, set);
+               #endif
+
+               return span_leading_scalar(s, n, set);
+            }
+
+            inline std::size_t span_trailing(const char* s, const std::size_t n, const char_set& set)
+            {
+               #ifdef exprtk_simd_str_funcs_avx2
+               if ((n >= 64) && set.vectorisable() && avx2_available())
+                  return span_trailing_avx2(s, n, set);
+               #endif
+
+               #ifdef exprtk_simd_str_funcs_sse2
+               if ((n >= 64) && set.vectorisable())
+                  return span_trailing_sse2(s, n, set);
+               #endif
+
+               return span_trailing_scalar(s, n, set);
+            }
+
+            inline std::size_t remove_set(char* s, const std::size_t n, const char_set& set)
+            {
+               #ifdef exprtk_simd_str_funcs_avx2
+               if ((n >= 32) && set.vectorisable() && avx2_available())
+                  return remove_set_avx2(s, n, set);
+               #endif
+
+               #ifdef exprtk_simd_str_funcs_sse2
+               if ((n >= 16) && set.vectorisable())
+                  return remove_set_sse2(s, n, set);
+               #endif
+
+               return remove_set_scalar(s, s, n, set);
+            }
+
+            // Appends s with every occurrence of the pattern removed, candidates are found with memchr
+            inline void remove_all(std::string& result,
+                                   const char* s, const std::size_t n,
+                                   const char* p, const std::size_t m)
+            {
+               const char* itr = s;
+               const char* end = s + n;
+
+               if ((0 == m) || (m > n))
+               {
+                  result.append(s, n);
+                  return;
+               }
+
+               const char* last = end - m;
+               const char* scan = itr;
+
+               while (scan <= last)
+               {
+                  const void* hit = std::memchr(scan, p[0], static_cast<std::size_t>(last - scan) + 1);
+
+                  if (0 == hit)
+                     break;
+
+                  const char* candidate = static_cast<const char*>(hit);
+
+                  if (0 == std::memcmp(candidate, p, m))
+                  {
+                     result.append(itr, static_cast<std::size_t>(candidate - itr));
+                     itr  = candidate + m;
+                     scan = itr;
+                  }
+                  else
+                     scan = candidate + 1;
+               }
+
+               result.append(itr, static_cast<std::size_t>(end - itr));
+            }
+         }
+
          template <typename T, typename Process>
          struct igf_impl : public exprtk::igeneric_function<T>
          {
@@ -44,27 +564,392 @@ namespace exprtk
             }
          };
 
-         struct toupper_impl         {};
-         struct tolower_impl         {};
-         struct trim_leading_ws_impl {};
-         struct trim_trailing_ws_impl{};
-         struct trim_ws_impl         {};
-         struct trim_leading_impl    {};
-         struct trim_trailing_impl   {};
-         struct trim_impl            {};
-         struct sort_impl            {};
-         struct remove_impl          {};
-         struct removec_impl         {};
-         struct to_str_impl          {};
-         struct rotate_l_impl        {};
-         struct rotate_r_impl        {};
-         struct join_impl            {};
-         struct alphabet_uc_impl     {};
-         struct alphabet_lc_impl     {};
-         struct digits_impl          {};
-         struct odd_digits_impl      {};
-         struct even_digits_impl     {};
+         template <typename T, typename Process>
+         struct igf_str_impl : public exprtk::igeneric_function<T>
+         {
+            typedef exprtk::igeneric_function<T> igfun_t;
+            typedef typename igfun_t::parameter_list_t parameter_list_t;
+
+            using igfun_t::operator();
+
+            igf_str_impl(const std::string& param_sequence = "")
+            : exprtk::igeneric_function<T>(param_sequence, igfun_t::e_rtrn_string)
+            {}
+
+            inline T operator()(std::string& result, parameter_list_t parameters)
+            {
+               return Process::template execute<T>(result, parameters);
+            }
+         };
+
+         template <typename T>
+         struct str_param
+         {
+            typedef typename exprtk::igeneric_function<T>::parameter_list_t parameter_list_t;
+            typedef typename exprtk::igeneric_function<T>::generic_type     generic_type;
+            typedef typename generic_type::string_view                     string_t;
+            typedef typename generic_type::scalar_view                     scalar_t;
+
+            static inline kernel::char_set chars(parameter_list_t& parameters, const std::size_t i)
+            {
+               const string_t s(parameters[i]);
+               return kernel::char_set(s.begin(), s.size());
+            }
+         };
+
+         template <typename Range>
+         struct case_impl
+         {
+            template <typename T>
+            static inline T execute(std::string& result, typename str_param<T>::parameter_list_t& parameters)
+            {
+               const typename str_param<T>::string_t s(parameters[0]);
+
+               result.assign(s.begin(), s.size());
+
+               if (!result.empty())
+               {
+                  kernel::convert_case(&result[0], result.size(), Range::lo, Range::hi);
+               }
+
+               return T(1);
+            }
+         };
+
+         struct upper_range { static const char lo = 'a'; static const char hi = 'z'; };
+         struct lower_range { static const char lo = 'A'; static const char hi = 'Z'; };
+
+         struct toupper_impl : public case_impl<upper_range> {};
+         struct tolower_impl : public case_impl<lower_range> {};
+
+         template <bool Leading, bool Trailing, bool CharsParam>
+         struct trim_base_impl
+         {
+            template <typename T>
+            static inline T execute(std::string& result, typename str_param<T>::parameter_list_t& parameters)
+            {
+               const typename str_param<T>::string_t s(parameters[0]);
+
+               const kernel::char_set set = CharsParam ?
+                                            str_param<T>::chars(parameters, 1) :
+                                            kernel::whitespace();
+
+               std::size_t begin = 0;
+               std::size_t end   = s.size();
+
+               if (Leading)
+               {
+                  begin = kernel::span_leading(s.begin(), end, set);
+               }
+
+               if (Trailing)
+               {
+                  end = begin + kernel::span_trailing(s.begin() + begin, end - begin, set);
+               }
+
+               result.assign(s.begin() + begin, end - begin);
+
+               return T(1);
+            }
+         };
+
+         struct trim_leading_ws_impl  : public trim_base_impl<true , false, false> {};
+         struct trim_trailing_ws_impl : public trim_base_impl<false, true , false> {};
+         struct trim_ws_impl          : public trim_base_impl<true , true , false> {};
+         struct trim_leading_impl     : public trim_base_impl<true , false, true > {};
+         struct trim_trailing_impl    : public trim_base_impl<false, true , true > {};
+         struct trim_impl             : public trim_base_impl<true , true , true > {};
+
+         struct sort_impl
+         {
+            // Counting sort over the byte values, O(n) regardless of the input order
+            template <typename T>
+            static inline T execute(std::string& result, typename str_param<T>::parameter_list_t& parameters)
+            {
+               const typename str_param<T>::string_t s(parameters[0]);
+
+               std::size_t count[256];
+               std::fill_n(count, 256, std::size_t(0));
+
+               for (std::size_t i = 0; i < s.size(); ++i)
+               {
+                  ++count[static_cast<unsigned char>(s[i])];
+               }
+
+               result.clear();
+               result.reserve(s.size());
+
+               for (std::size_t c = 0; c < 256; ++c)
+               {
+                  if (count[c])
+                  {
+                     result.append(count[c], static_cast<char>(c));
+                  }
+               }
+
+               return T(1);
+            }
+         };
+
+         struct remove_impl
+         {
+            template <typename T>
+            static inline T execute(std::string& result, typename str_param<T>::parameter_list_t& parameters)
+            {
+               const typename str_param<T>::string_t s(parameters[0]);
+               const typename str_param<T>::string_t p(parameters[1]);
+
+               result.clear();
+               result.reserve(s.size());
+
+               kernel::remove_all(result, s.begin(), s.size(), p.begin(), p.size());
+
+               return T(1);
+            }
+         };
+
+         struct removec_impl
+         {
+            template <typename T>
+            static inline T execute(std::string& result, typename str_param<T>::parameter_list_t& parameters)
+            {
+               const typename str_param<T>::string_t s(parameters[0]);
+               const kernel::char_set set = str_param<T>::chars(parameters, 1);
+
+               result.assign(s.begin(), s.size());
+
+               if (!result.empty())
+               {
+                  result.resize(kernel::remove_set(&result[0], result.size(), set));
+               }
+
+               return T(1);
+            }
+         };
+
+         struct to_str_impl
+         {
+            template <typename T>
+            static inline T execute(std::string& result, typename str_param<T>::parameter_list_t& parameters)
+            {
+               const typename str_param<T>::scalar_t v(parameters[0]);
+
+               // Enough significant digits for the value to round-trip
+               #if __cplusplus >= 201103L
+               const int precision = std::numeric_limits<T>::max_digits10;
+               #else
+               const int precision = std::numeric_limits<T>::digits10 + 2;
+               #endif
+
+               char buffer[64];
+
+               snprintf(buffer, sizeof(buffer), "%.*g",
+                         precision,
+                         static_cast<double>(v()));
+
+               result.assign(buffer);
+
+               return T(1);
+            }
+         };
+
+         template <bool Left>
+         struct rotate_base_impl
+         {
+            template <typename T>
+            static inline T execute(std::string& result, typename str_param<T>::parameter_list_t& parameters)
+            {
+               const typename str_param<T>::string_t s(parameters[0]);
+
+               std::size_t n = 0;
+
+               if (!typename str_param<T>::scalar_t(parameters[1]).to_uint(n) || s.size() < 2)
+               {
+                  result.assign(s.begin(), s.size());
+                  return T(s.size() < 2 ? 1 : 0);
+               }
+
+               n %= s.size();
+
+               const std::size_t split = Left ? n : (s.size() - n) % s.size();
+
+               result.assign(s.begin() + split, s.size() - split);
+               result.append(s.begin(), split);
+
+               return T(1);
+            }
+         };
+
+         struct rotate_l_impl : public rotate_base_impl<true > {};
+         struct rotate_r_impl : public rotate_base_impl<false> {};
+
+         struct join_impl
+         {
+            // join(separator, s0, s1, ...)
+            template <typename T>
+            static inline T execute(std::string& result, typename str_param<T>::parameter_list_t& parameters)
+            {
+               typedef typename str_param<T>::generic_type generic_type;
+               typedef typename str_param<T>::string_t     string_t;
+
+               result.clear();
+
+               for (std::size_t i = 0; i < parameters.size(); ++i)
+               {
+                  if (generic_type::e_string != parameters[i].type)
+                     return T(0);
+               }
+
+               const string_t separator(parameters[0]);
+
+               std::size_t total = 0;
+
+               for (std::size_t i = 1; i < parameters.size(); ++i)
+               {
+                  total += string_t(parameters[i]).size() + separator.size();
+               }
+
+               result.reserve(total);
+
+               for (std::size_t i = 1; i < parameters.size(); ++i)
+               {
+                  const string_t s(parameters[i]);
+
+                  if (i > 1)
+                  {
+                     result.append(separator.begin(), separator.size());
+                  }
+
+                  result.append(s.begin(), s.size());
+               }
+
+               return T(1);
+            }
+         };
+
+         template <typename Sequence>
+         struct constant_str_impl
+         {
+            template <typename T>
+            static inline T execute(std::string& result, typename str_param<T>::parameter_list_t&)
+            {
+               result.assign(Sequence::value());
+               return T(1);
+            }
+         };
+
+         struct alphabet_uc_seq { static const char* value() { return "ABCDEFGHIJKLMNOPQRSTUVWXYZ"; } };
+         struct alphabet_lc_seq { static const char* value() { return "abcdefghijklmnopqrstuvwxyz"; } };
+         struct digits_seq      { static const char* value() { return "0123456789";                 } };
+         struct odd_digits_seq  { static const char* value() { return "13579";                      } };
+         struct even_digits_seq { static const char* value() { return "02468";                      } };
+
+         struct alphabet_uc_impl : public constant_str_impl<alphabet_uc_seq> {};
+         struct alphabet_lc_impl : public constant_str_impl<alphabet_lc_seq> {};
+         struct digits_impl      : public constant_str_impl<digits_seq     > {};
+         struct odd_digits_impl  : public constant_str_impl<odd_digits_seq > {};
+         struct even_digits_impl : public constant_str_impl<even_digits_seq> {};
       }
+
+      template <typename T>
+      struct str_funcs_package
+      {
+         typedef details::igf_str_impl<T,details::toupper_impl         > toupper_t;
+         typedef details::igf_str_impl<T,details::tolower_impl         > tolower_t;
+         typedef details::igf_str_impl<T,details::trim_leading_ws_impl > trim_leading_ws_t;
+         typedef details::igf_str_impl<T,details::trim_trailing_ws_impl> trim_trailing_ws_t;
+         typedef details::igf_str_impl<T,details::trim_ws_impl         > trim_ws_t;
+         typedef details::igf_str_impl<T,details::trim_leading_impl    > trim_leading_t;
+         typedef details::igf_str_impl<T,details::trim_trailing_impl   > trim_trailing_t;
+         typedef details::igf_str_impl<T,details::trim_impl            > trim_t;
+         typedef details::igf_str_impl<T,details::sort_impl            > sort_t;
+         typedef details::igf_str_impl<T,details::remove_impl          > remove_t;
+         typedef details::igf_str_impl<T,details::removec_impl         > removec_t;
+         typedef details::igf_str_impl<T,details::to_str_impl          > to_str_t;
+         typedef details::igf_str_impl<T,details::rotate_l_impl        > rotate_l_t;
+         typedef details::igf_str_impl<T,details::rotate_r_impl        > rotate_r_t;
+         typedef details::igf_str_impl<T,details::join_impl            > join_t;
+         typedef details::igf_str_impl<T,details::alphabet_uc_impl     > alphabet_uc_t;
+         typedef details::igf_str_impl<T,details::alphabet_lc_impl     > alphabet_lc_t;
+         typedef details::igf_str_impl<T,details::digits_impl          > digits_t;
+         typedef details::igf_str_impl<T,details::odd_digits_impl      > odd_digits_t;
+         typedef details::igf_str_impl<T,details::even_digits_impl     > even_digits_t;
+
+         str_funcs_package()
+         : toupper_         ("S"  )
+         , tolower_         ("S"  )
+         , trim_leading_ws_ ("S"  )
+         , trim_trailing_ws_("S"  )
+         , trim_ws_         ("S"  )
+         , trim_leading_    ("SS" )
+         , trim_trailing_   ("SS" )
+         , trim_            ("SS" )
+         , sort_            ("S"  )
+         , remove_          ("SS" )
+         , removec_         ("SS" )
+         , to_str_          ("T"  )
+         , rotate_l_        ("ST" )
+         , rotate_r_        ("ST" )
+         , join_            ("SS*")
+         , alphabet_uc_     ("Z"  )
+         , alphabet_lc_     ("Z"  )
+         , digits_          ("Z"  )
+         , odd_digits_      ("Z"  )
+         , even_digits_     ("Z"  )
+         {}
+
+         bool register_package(exprtk::symbol_table<T>& symtab)
+         {
+            #define exprtk_register_function(FunctionName, FunctionType) \
+            if (!symtab.add_function(FunctionName,FunctionType))         \
+               return false;                                             \
+
+            exprtk_register_function("toupper"         , toupper_         )
+            exprtk_register_function("tolower"         , tolower_         )
+            exprtk_register_function("trim_leading_ws" , trim_leading_ws_ )
+            exprtk_register_function("trim_trailing_ws", trim_trailing_ws_)
+            exprtk_register_function("trim_ws"         , trim_ws_         )
+            exprtk_register_function("trim_leading"    , trim_leading_    )
+            exprtk_register_function("trim_trailing"   , trim_trailing_   )
+            exprtk_register_function("trim"            , trim_            )
+            exprtk_register_function("sort"            , sort_            )
+            exprtk_register_function("remove"          , remove_          )
+            exprtk_register_function("removec"         , removec_         )
+            exprtk_register_function("to_str"          , to_str_          )
+            exprtk_register_function("rotate_l"        , rotate_l_        )
+            exprtk_register_function("rotate_r"        , rotate_r_        )
+            exprtk_register_function("join"            , join_            )
+            exprtk_register_function("alphabet_uc"     , alphabet_uc_     )
+            exprtk_register_function("alphabet_lc"     , alphabet_lc_     )
+            exprtk_register_function("digits"          , digits_          )
+            exprtk_register_function("odd_digits"      , odd_digits_      )
+            exprtk_register_function("even_digits"     , even_digits_     )
+            #undef exprtk_register_function
+
+            return true;
+         }
+
+         toupper_t          toupper_;
+         tolower_t          tolower_;
+         trim_leading_ws_t  trim_leading_ws_;
+         trim_trailing_ws_t trim_trailing_ws_;
+         trim_ws_t          trim_ws_;
+         trim_leading_t     trim_leading_;
+         trim_trailing_t    trim_trailing_;
+         trim_t             trim_;
+         sort_t             sort_;
+         remove_t           remove_;
+         removec_t          removec_;
+         to_str_t           to_str_;
+         rotate_l_t         rotate_l_;
+         rotate_r_t         rotate_r_;
+         join_t             join_;
+         alphabet_uc_t      alphabet_uc_;
+         alphabet_lc_t      alphabet_lc_;
+         digits_t           digits_;
+         odd_digits_t       odd_digits_;
+         even_digits_t      even_digits_;
+      };
    }
 } // namespace exprtk
 
@@ -0,0 +1,312 @@
+/*
+ **************************************************************
+ *         C++ Mathematical Expression Toolkit Library        *
+ *                                                            *
+ * ExprTk String Functions Benchmark                          *
+ * Author: Arash Partow (1999-2025)                           *
+ * URL: https://www.partow.net/programming/exprtk/index.html  *
+ *                                                            *
+ * Copyright notice:                                          *
+ * Free use of the Mathematical Expression Toolkit Library is *
+ * permitted under the guidelines and in accordance with the  *
+ * most current version of the MIT License.                   *
+ * https://www.opensource.org/licenses/MIT                    *
+ * SPDX-License-Identifier: MIT                               *
+ *                                                            *
+ **************************************************************
+*/
+
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "exprtk.hpp"
+#include "exprtk_str_funcs.hpp"
+
+
+namespace kernel = exprtk::helper::details::kernel;
+
+std::string make_text(std::mt19937& engine, const std::size_t length)
+{
+   static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ,0123456789;\t";
+
+   std::uniform_int_distribution<std::size_t> pick(0, sizeof(alphabet) - 2);
+
+   std::string text(length, ' ');
+
+   for (std::size_t i = 0; i < length; ++i)
+   {
+      text[i] = alphabet[pick(engine)];
+   }
+
+   return text;
+}
+
+// Compare the dispatched kernels with the scalar ones over random inputs
+bool kernel_check()
+{
+   std::mt19937 engine(1234);
+   std::uniform_int_distribution<std::size_t> length(0, 300);
+   std::uniform_int_distribution<std::size_t> padding(0, 70);
+
+   const kernel::char_set& ws = kernel::whitespace();
+   const kernel::char_set  punctuation(",;", 2);
+
+   std::size_t mismatches = 0;
+
+   for (std::size_t i = 0; i < 20000; ++i)
+   {
+      const std::string text =
+         std::string(padding(engine), ' ') +
+         make_text(engine, length(engine)) +
+         std::string(padding(engine), '\t');
+
+      std::string scalar = text;
+      std::string simd   = text;
+
+      if (!text.empty())
+      {
+         kernel::convert_case_scalar(&scalar[0], scalar.size(), 'a', 'z');
+         kernel::convert_case       (&simd  [0], simd  .size(), 'a', 'z');
+      }
+
+      if (scalar != simd)
+         ++mismatches;
+
+      if (
+           (kernel::span_leading_scalar (text.data(), text.size(), ws) !=
+            kernel::span_leading        (text.data(), text.size(), ws)) ||
+           (kernel::span_trailing_scalar(text.data(), text.size(), ws) !=
+            kernel::span_trailing       (text.data(), text.size(), ws))
+         )
+      {
+         ++mismatches;
+      }
+
+      scalar = text;
+      simd   = text;
+
+      if (!text.empty())
+      {
+         scalar.resize(kernel::remove_set_scalar(&scalar[0], scalar.data(), scalar.size(), punctuation));
+         simd  .resize(kernel::remove_set       (&simd  [0], simd  .size(), punctuation));
+      }
+
+      if (scalar != simd)
+         ++mismatches;
+   }
+
+   printf("kernel check: %s (avx2: %s)\n",
+          (0 == mismatches) ? "PASSED" : "FAILED",
+          kernel::avx2_available() ? "yes" : "no");
+
+   return (0 == mismatches);
+}
+
+static volatile std::size_t checksum_sink = 0;
+
+template <typename Function>
+double throughput(Function f, const std::vector<std::string>& text_list, const std::size_t rounds)
+{
+   std::size_t bytes    = 0;
+   std::size_t checksum = 0;
+
+   exprtk::timer timer;
+   timer.start();
+
+   for (std::size_t r = 0; r < rounds; ++r)
+   {
+      for (std::size_t i = 0; i < text_list.size(); ++i)
+      {
+         checksum += f(text_list[i]);
+         bytes    += text_list[i].size();
+      }
+   }
+
+   timer.stop();
+
+   checksum_sink = checksum;
+
+   return (bytes / timer.time()) / 1.0e9;
+}
+
+/*
+   Each routine works on a copy of its input, as the string functions
+   do, so the copy is part of both the scalar and the SIMD timings.
+*/
+void kernel_benchmark()
+{
+   const std::size_t length_list[] = { 16, 64, 256, 4096, 65536, 1048576 };
+   const std::size_t length_count  = sizeof(length_list) / sizeof(std::size_t);
+
+   const kernel::char_set& ws = kernel::whitespace();
+   const kernel::char_set  punctuation(",;", 2);
+
+   std::mt19937 engine(5678);
+
+   std::string buffer;
+
+   printf("\n%9s | %21s | %21s | %21s\n", "length", "toupper GB/s", "trim_ws GB/s", "removec GB/s");
+   printf("%9s | %6s %6s %7s | %6s %6s %7s | %6s %6s %7s\n", "",
+          "scalar", "simd", "speedup",
+          "scalar", "simd", "speedup",
+          "scalar", "simd", "speedup");
+
+   for (std::size_t l = 0; l < length_count; ++l)
+   {
+      const std::size_t length = length_list[l];
+
+      // Roughly 256MB of text is processed per measurement
+      const std::size_t copies = std::max<std::size_t>(1, (1 << 20) / length);
+      const std::size_t rounds = std::max<std::size_t>(1, (256 << 20) / (copies * length));
+
+      std::vector<std::string> text_list;
+
+      for (std::size_t i = 0; i < copies; ++i)
+      {
+         const std::size_t pad = length / 4;
+         text_list.push_back(std::string(pad, ' ') + make_text(engine, length - 2 * pad) + std::string(pad, '\t'));
+      }
+
+      const double upper_scalar = throughput([&](const std::string& s) -> std::size_t
+         {
+            buffer.assign(s);
+            kernel::convert_case_scalar(&buffer[0], buffer.size(), 'a', 'z');
+            return static_cast<unsigned char>(buffer[buffer.size() / 2]);
+         },
+         text_list, rounds);
+
+      const double upper_simd = throughput([&](const std::string& s) -> std::size_t
+         {
+            buffer.assign(s);
+            kernel::convert_case(&buffer[0], buffer.size(), 'a', 'z');
+            return static_cast<unsigned char>(buffer[buffer.size() / 2]);
+         },
+         text_list, rounds);
+
+      const double trim_scalar = throughput([&](const std::string& s) -> std::size_t
+         {
+            const std::size_t b = kernel::span_leading_scalar(s.data(), s.size(), ws);
+            buffer.assign(s.data() + b, kernel::span_trailing_scalar(s.data() + b, s.size() - b, ws));
+            return buffer.size();
+         },
+         text_list, rounds);
+
+      const double trim_simd = throughput([&](const std::string& s) -> std::size_t
+         {
+            const std::size_t b = kernel::span_leading(s.data(), s.size(), ws);
+            buffer.assign(s.data() + b, kernel::span_trailing(s.data() + b, s.size() - b, ws));
+            return buffer.size();
+         },
+         text_list, rounds);
+
+      const double removec_scalar = throughput([&](const std::string& s) -> std::size_t
+         {
+            buffer.assign(s);
+            return kernel::remove_set_scalar(&buffer[0], buffer.data(), buffer.size(), punctuation);
+         },
+         text_list, rounds);
+
+      const double removec_simd = throughput([&](const std::string& s) -> std::size_t
+         {
+            buffer.assign(s);
+            return kernel::remove_set(&buffer[0], buffer.size(), punctuation);
+         },
+         text_list, rounds);
+
+      printf("%9d | %6.2f %6.2f %6.2fx | %6.2f %6.2f %6.2fx | %6.2f %6.2f %6.2fx\n",
+             static_cast<int>(length),
+             upper_scalar  , upper_simd  , upper_simd   / upper_scalar  ,
+             trim_scalar   , trim_simd   , trim_simd    / trim_scalar   ,
+             removec_scalar, removec_simd, removec_simd / removec_scalar);
+   }
+}
+
+template <typename T>
+void str_funcs_expressions()
+{
+   typedef exprtk::symbol_table<T> symbol_table_t;
+   typedef exprtk::expression<T>   expression_t;
+   typedef exprtk::parser<T>       parser_t;
+
+   std::string field  = "   Row 17, Account Name; ACME Widgets Ltd, Region: EMEA   \t";
+   std::string result;
+
+   exprtk::helper::str_funcs_package<T> str_funcs;
+
+   symbol_table_t symbol_table;
+   symbol_table.add_stringvar("field" , field );
+   symbol_table.add_stringvar("result", result);
+   str_funcs.register_package(symbol_table);
+
+   const std::string program_list[] =
+      {
+         "result := toupper(field)              ",
+         "result := tolower(trim_ws(field))     ",
+         "result := trim(field, ' \t,;R')       ",
+         "result := removec(field, ',; \t')     ",
+         "result := remove(field, 'ACME ')      ",
+         "result := rotate_l(trim_ws(field), 4) ",
+         "result := sort(removec(field, ' '))   ",
+         "result := join(', ', digits(), odd_digits(), to_str(3.25))"
+      };
+
+   const std::size_t program_count = sizeof(program_list) / sizeof(std::string);
+
+   parser_t parser;
+
+   printf("\n");
+
+   for (std::size_t i = 0; i < program_count; ++i)
+   {
+      expression_t expression;
+      expression.register_symbol_table(symbol_table);
+
+      if (!parser.compile(program_list[i], expression))
+      {
+         printf("Error: %s\tExpression: %s\n",
+                parser.error().c_str(),
+                program_list[i].c_str());
+
+         continue;
+      }
+
+      const std::size_t rounds = 200000;
+
+      exprtk::timer timer;
+      timer.start();
+
+      for (std::size_t j = 0; j < rounds; ++j)
+      {
+         expression.value();
+      }
+
+      timer.stop();
+
+      printf("%-60s [%s] %6.1fns/eval\n",
+             program_list[i].c_str(),
+             result.c_str(),
+             (timer.time() * 1.0e9) / rounds);
+   }
+}
+
+int main()
+{
+   if (!kernel_check())
+      return 1;
+
+   kernel_benchmark();
+   str_funcs_expressions<double>();
+
+   return 0;
+}
+
+
+/*
+
+   Build:
+   c++ -pedantic-errors -Wall -Wextra -Werror -O3 -DNDEBUG -o exprtk_str_funcs_benchmark exprtk_str_funcs_benchmark.cpp -L/usr/lib -lstdc++ -lm
+
+*/
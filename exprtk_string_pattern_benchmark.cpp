@@ -0,0 +1,189 @@
+/*
+ **************************************************************
+ *         C++ Mathematical Expression Toolkit Library        *
+ *                                                            *
+ * ExprTk String Pattern Matching Benchmark                   *
+ * Author: Arash Partow (1999-2025)                           *
+ * URL: https://www.partow.net/programming/exprtk/index.html  *
+ *                                                            *
+ * Copyright notice:                                          *
+ * Free use of the Mathematical Expression Toolkit Library is *
+ * permitted under the guidelines and in accordance with the  *
+ * most current version of the MIT License.                   *
+ * https://www.opensource.org/licenses/MIT                    *
+ * SPDX-License-Identifier: MIT                               *
+ *                                                            *
+ **************************************************************
+*/
+
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "exprtk.hpp"
+
+
+std::vector<std::string> make_log_lines(const std::size_t count)
+{
+   static const char* method_list[] = { "GET", "PUT", "POST", "HEAD", "PATCH", "DELETE", "OPTIONS", "TRACE" };
+   static const char* path_list  [] = { "/api/v1/users", "/api/v2/orders", "/static/app.js", "/health", "/Api/V1/login" };
+   static const char* status_list[] = { "ok", "error: upstream timeout", "error: bad request", "redirect", "Error: TIMEOUT" };
+
+   std::mt19937 engine(4321);
+   std::uniform_int_distribution<int> pick(0, 1 << 20);
+
+   std::vector<std::string> line_list;
+
+   for (std::size_t i = 0; i < count; ++i)
+   {
+      char buffer[256];
+
+      snprintf(buffer, sizeof(buffer), "2025-03-%02d %-7s %s?id=%d host=node%02d latency=%dms status=%s",
+               1 + (pick(engine) % 28),
+               method_list[pick(engine) % 8],
+               path_list  [pick(engine) % 5],
+               pick(engine),
+               pick(engine) % 64,
+               pick(engine) % 1000,
+               status_list[pick(engine) % 5]);
+
+      line_list.push_back(buffer);
+   }
+
+   return line_list;
+}
+
+template <typename T>
+void string_pattern_benchmark()
+{
+   typedef exprtk::symbol_table<T> symbol_table_t;
+   typedef exprtk::expression<T>   expression_t;
+   typedef exprtk::parser<T>       parser_t;
+
+   std::string line;
+   std::string method;
+
+   /*
+      Each pair of programs computes the same result. The first uses
+      constant patterns and literals, which are compiled at parse time,
+      the second reads the same values from string variables, so each
+      evaluation interprets the pattern afresh.
+   */
+   std::string p0 = "*error*timeout*";
+   std::string p1 = "*/API/V?/*";
+   std::string p2 = "2025-03-1?*";
+   std::string m0 = "GET";
+   std::string m1 = "PUT";
+   std::string m2 = "POST";
+   std::string m3 = "PATCH";
+   std::string m4 = "DELETE";
+   std::string m5 = "OPTIONS";
+
+   symbol_table_t symbol_table;
+   symbol_table.add_stringvar("line"  , line  );
+   symbol_table.add_stringvar("method", method);
+   symbol_table.add_stringvar("p0"    , p0    );
+   symbol_table.add_stringvar("p1"    , p1    );
+   symbol_table.add_stringvar("p2"    , p2    );
+   symbol_table.add_stringvar("m0"    , m0    );
+   symbol_table.add_stringvar("m1"    , m1    );
+   symbol_table.add_stringvar("m2"    , m2    );
+   symbol_table.add_stringvar("m3"    , m3    );
+   symbol_table.add_stringvar("m4"    , m4    );
+   symbol_table.add_stringvar("m5"    , m5    );
+
+   const std::string program_list[][2] =
+      {
+         { "line like '*error*timeout*'", "line like p0" },
+         { "line ilike '*/API/V?/*'"    , "line ilike p1" },
+         { "line like '2025-03-1?*'"    , "line like p2" },
+         {
+           "method == 'GET' or method == 'PUT' or method == 'POST' or "
+           "method == 'PATCH' or method == 'DELETE' or method == 'OPTIONS'",
+           "method == m0 or method == m1 or method == m2 or "
+           "method == m3 or method == m4 or method == m5"
+         }
+      };
+
+   const std::size_t program_count = sizeof(program_list) / sizeof(program_list[0]);
+
+   const std::vector<std::string> line_list = make_log_lines(10000);
+
+   std::vector<std::string> method_list;
+
+   for (std::size_t i = 0; i < line_list.size(); ++i)
+   {
+      method_list.push_back(line_list[i].substr(11, line_list[i].find(' ', 11) - 11));
+   }
+
+   const std::size_t rounds = 100;
+
+   parser_t parser;
+
+   printf("%-44s %10s %10s %8s\n", "program", "constant", "variable", "speedup");
+
+   for (std::size_t i = 0; i < program_count; ++i)
+   {
+      expression_t expression[2];
+
+      T      total[2] = { T(0), T(0) };
+      double time[2] = { 0.0 , 0.0  };
+
+      for (std::size_t j = 0; j < 2; ++j)
+      {
+         expression[j].register_symbol_table(symbol_table);
+
+         if (!parser.compile(program_list[i][j], expression[j]))
+         {
+            printf("Error: %s\tExpression: %s\n",
+                   parser.error().c_str(),
+                   program_list[i][j].c_str());
+
+            return;
+         }
+
+         exprtk::timer timer;
+         timer.start();
+
+         for (std::size_t r = 0; r < rounds; ++r)
+         {
+            for (std::size_t k = 0; k < line_list.size(); ++k)
+            {
+               line   = line_list  [k];
+               method = method_list[k];
+
+               total[j] += expression[j].value();
+            }
+         }
+
+         timer.stop();
+
+         time[j] = timer.time();
+      }
+
+      const double evaluations = static_cast<double>(rounds * line_list.size());
+
+      printf("%-44.44s %8.1fns %8.1fns %7.2fx %s\n",
+             program_list[i][0].c_str(),
+             (time[0] * 1.0e9) / evaluations,
+             (time[1] * 1.0e9) / evaluations,
+             time[1] / time[0],
+             (total[0] == total[1]) ? "OK" : "MISMATCH");
+   }
+}
+
+int main()
+{
+   string_pattern_benchmark<double>();
+   return 0;
+}
+
+
+/*
+
+   Build:
+   c++ -pedantic-errors -Wall -Wextra -Werror -O3 -DNDEBUG -o exprtk_string_pattern_benchmark exprtk_string_pattern_benchmark.cpp -L/usr/lib -lstdc++ -lm
+
+*/
@@ -0,0 +1,255 @@
+/*
+ **************************************************************
+ *         C++ Mathematical Expression Toolkit Library        *
+ *                                                            *
+ * ExprTk BLAS Level-1 (axpy family) Benchmark                *
+ * Author: Arash Partow (1999-2025)                           *
+ * URL: https://www.partow.net/programming/exprtk/index.html  *
+ *                                                            *
+ * Copyright notice:                                          *
+ * Free use of the Mathematical Expression Toolkit Library is *
+ * permitted under the guidelines and in accordance with the  *
+ * most current version of the MIT License.                   *
+ * https://www.opensource.org/licenses/MIT                    *
+ * SPDX-License-Identifier: MIT                               *
+ *                                                            *
+ **************************************************************
+*/
+
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "exprtk.hpp"
+
+
+/*
+   Scalar reference versions of axpy, axpby and axpbsy - these are
+   equivalent to the loops used by rtl::vecops prior to the SIMD
+   kernels, and serve as the baseline for the comparison.
+*/
+template <typename T>
+struct ref_axpy final : public exprtk::igeneric_function<T>
+{
+   typedef typename exprtk::igeneric_function<T>::parameter_list_t parameter_list_t;
+   typedef typename exprtk::igeneric_function<T>::generic_type     generic_type;
+   typedef typename generic_type::scalar_view scalar_t;
+   typedef typename generic_type::vector_view vector_t;
+
+   using exprtk::igeneric_function<T>::operator();
+
+   ref_axpy()
+   : exprtk::igeneric_function<T>("TVV")
+   {}
+
+   inline T operator() (parameter_list_t parameters) override
+   {
+      const vector_t x(parameters[1]);
+            vector_t y(parameters[2]);
+
+      const T a = scalar_t(parameters[0])();
+
+      for (std::size_t i = 0; i < y.size(); ++i)
+      {
+         y[i] = (a * x[i]) + y[i];
+      }
+
+      return T(1);
+   }
+};
+
+template <typename T>
+struct ref_axpby final : public exprtk::igeneric_function<T>
+{
+   typedef typename exprtk::igeneric_function<T>::parameter_list_t parameter_list_t;
+   typedef typename exprtk::igeneric_function<T>::generic_type     generic_type;
+   typedef typename generic_type::scalar_view scalar_t;
+   typedef typename generic_type::vector_view vector_t;
+
+   using exprtk::igeneric_function<T>::operator();
+
+   ref_axpby()
+   : exprtk::igeneric_function<T>("TVTV")
+   {}
+
+   inline T operator() (parameter_list_t parameters) override
+   {
+      const vector_t x(parameters[1]);
+            vector_t y(parameters[3]);
+
+      const T a = scalar_t(parameters[0])();
+      const T b = scalar_t(parameters[2])();
+
+      for (std::size_t i = 0; i < y.size(); ++i)
+      {
+         y[i] = (a * x[i]) + (b * y[i]);
+      }
+
+      return T(1);
+   }
+};
+
+template <typename T>
+struct ref_axpbsy final : public exprtk::igeneric_function<T>
+{
+   typedef typename exprtk::igeneric_function<T>::parameter_list_t parameter_list_t;
+   typedef typename exprtk::igeneric_function<T>::generic_type     generic_type;
+   typedef typename generic_type::scalar_view scalar_t;
+   typedef typename generic_type::vector_view vector_t;
+
+   using exprtk::igeneric_function<T>::operator();
+
+   ref_axpbsy()
+   : exprtk::igeneric_function<T>("TVTTV")
+   {}
+
+   inline T operator() (parameter_list_t parameters) override
+   {
+      const vector_t x(parameters[1]);
+            vector_t y(parameters[4]);
+
+      const T a = scalar_t(parameters[0])();
+      const T b = scalar_t(parameters[2])();
+
+      const std::size_t s = static_cast<std::size_t>(scalar_t(parameters[3])());
+
+      for (std::size_t i = 0; (i + s) < y.size(); ++i)
+      {
+         y[i] = (a * x[i]) + (b * y[i + s]);
+      }
+
+      return T(1);
+   }
+};
+
+struct benchmark_program
+{
+   std::string name;
+   std::string reference;
+   std::string vecops;
+   std::size_t flops_per_element;
+};
+
+template <typename T>
+double run_benchmark(const std::string& program,
+                     const std::size_t size,
+                     const std::size_t rounds,
+                     T& checksum)
+{
+   typedef exprtk::symbol_table<T> symbol_table_t;
+   typedef exprtk::expression<T>   expression_t;
+   typedef exprtk::parser<T>       parser_t;
+
+   ref_axpy  <T> r_axpy;
+   ref_axpby <T> r_axpby;
+   ref_axpbsy<T> r_axpbsy;
+
+   exprtk::rtl::vecops::package<T> vecops_package;
+
+   std::vector<T> x(size);
+   std::vector<T> y(size);
+
+   for (std::size_t i = 0; i < size; ++i)
+   {
+      x[i] = T(1) + T(i % 17) / T(17);
+      y[i] = T(1) - T(i % 13) / T(13);
+   }
+
+   T a = T(0.5);
+   T b = T(0.5);
+
+   symbol_table_t symbol_table;
+   symbol_table.add_package (vecops_package);
+   symbol_table.add_function("ref_axpy"  , r_axpy  );
+   symbol_table.add_function("ref_axpby" , r_axpby );
+   symbol_table.add_function("ref_axpbsy", r_axpbsy);
+   symbol_table.add_vector  ("x", x);
+   symbol_table.add_vector  ("y", y);
+   symbol_table.add_variable("a", a);
+   symbol_table.add_variable("b", b);
+
+   expression_t expression;
+   expression.register_symbol_table(symbol_table);
+
+   parser_t parser;
+
+   if (!parser.compile(program, expression))
+   {
+      printf("Error: %s\tExpression: %s\n",
+             parser.error().c_str(),
+             program.c_str());
+
+      return -1.0;
+   }
+
+   exprtk::timer timer;
+   timer.start();
+
+   for (std::size_t r = 0; r < rounds; ++r)
+   {
+      expression.value();
+   }
+
+   timer.stop();
+
+   checksum = T(0);
+
+   for (std::size_t i = 0; i < size; ++i)
+   {
+      checksum += y[i];
+   }
+
+   return timer.time();
+}
+
+template <typename T>
+void blas1_benchmark(const char* type_name)
+{
+   static const benchmark_program program_list[] =
+      {
+        { "axpy"  , "ref_axpy(a, x, y)"         , "axpy(a, x, y)"                     , 2 },
+        { "axpby" , "ref_axpby(a, x, b, y)"     , "axpby(a, x, b, y)"                 , 3 },
+        { "axpbsy", "ref_axpbsy(a, x, b, 1, y)" , "axpbsy(a, x, b, 1, y, 0, y[] - 2)" , 3 }
+      };
+
+   static const std::size_t program_list_size = sizeof(program_list) / sizeof(benchmark_program);
+
+   const std::size_t total_elements = 1 << 27;
+
+   for (std::size_t p = 0; p < program_list_size; ++p)
+   {
+      for (std::size_t size = (1 << 8); size <= (1 << 22); size <<= 2)
+      {
+         const std::size_t rounds = total_elements / size;
+
+         T ref_checksum    = T(0);
+         T vecops_checksum = T(0);
+
+         const double ref_time    = run_benchmark<T>(program_list[p].reference, size, rounds, ref_checksum   );
+         const double vecops_time = run_benchmark<T>(program_list[p].vecops   , size, rounds, vecops_checksum);
+
+         if ((ref_time < 0.0) || (vecops_time < 0.0))
+            return;
+
+         const double flops = 1.0 * program_list[p].flops_per_element * size * rounds;
+
+         printf("[%-6s] %-6s size: %8d  scalar: %7.3f GFLOPS  vecops: %7.3f GFLOPS  speedup: %6.3fx  %s\n",
+                type_name,
+                program_list[p].name.c_str(),
+                static_cast<int>(size),
+                flops / ref_time    / 1e9,
+                flops / vecops_time / 1e9,
+                ref_time / vecops_time,
+                (ref_checksum == vecops_checksum) ? "OK" : "MISMATCH");
+      }
+   }
+}
+
+int main()
+{
+   blas1_benchmark<double>("double");
+   blas1_benchmark<float> ("float" );
+
+   return 0;
+}
@@ -0,0 +1,168 @@
+/*
+ **************************************************************
+ *         C++ Mathematical Expression Toolkit Library        *
+ *                                                            *
+ * ExprTk Parallel Vector Sort/Selection Benchmark            *
+ * Author: Arash Partow (1999-2025)                           *
+ * URL: https://www.partow.net/programming/exprtk/index.html  *
+ *                                                            *
+ * Copyright notice:                                          *
+ * Free use of the Mathematical Expression Toolkit Library is *
+ * permitted under the guidelines and in accordance with the  *
+ * most current version of the MIT License.                   *
+ * https://www.opensource.org/licenses/MIT                    *
+ * SPDX-License-Identifier: MIT                               *
+ *                                                            *
+ **************************************************************
+*/
+
+
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define exprtk_enable_parallel_vecops
+#include "exprtk.hpp"
+
+
+template <typename T>
+struct vecops_instance
+{
+   typedef exprtk::symbol_table<T> symbol_table_t;
+   typedef exprtk::expression<T>   expression_t;
+   typedef exprtk::parser<T>       parser_t;
+
+   vecops_instance(const std::size_t parallel_threshold, std::vector<T>& v)
+   : sort_(parallel_threshold)
+   , nth_element_(parallel_threshold)
+   {
+      symbol_table_.add_function("sort"        , sort_       );
+      symbol_table_.add_function("nth_element" , nth_element_);
+      symbol_table_.add_vector  ("v"           , v           );
+   }
+
+   bool compile(const std::string& program, expression_t& expression)
+   {
+      expression.register_symbol_table(symbol_table_);
+
+      parser_t parser;
+
+      if (!parser.compile(program, expression))
+      {
+         printf("Error: %s\tExpression: %s\n",
+                parser.error().c_str(),
+                program.c_str());
+
+         return false;
+      }
+
+      return true;
+   }
+
+   exprtk::rtl::vecops::sort<T>       sort_;
+   exprtk::rtl::vecops::nthelement<T> nth_element_;
+   symbol_table_t                     symbol_table_;
+};
+
+template <typename T>
+double run(const std::size_t parallel_threshold,
+           const std::string& program,
+           const std::vector<T>& input,
+           std::vector<T>& output,
+           T& result)
+{
+   typedef typename vecops_instance<T>::expression_t expression_t;
+
+   output = input;
+
+   vecops_instance<T> instance(parallel_threshold, output);
+
+   expression_t expression;
+
+   if (!instance.compile(program, expression))
+      return -1.0;
+
+   exprtk::timer timer;
+   timer.start();
+
+   result = expression.value();
+
+   timer.stop();
+
+   return timer.time();
+}
+
+template <typename T>
+void sort_benchmark(const std::size_t parallel_threshold)
+{
+   static const std::string program_list[] =
+      {
+        "sort(v); v[v[] / 2]"                 ,
+        "sort(v, 'descending'); v[v[] / 10]"  ,
+        "nth_element(v, v[] / 2); v[v[] / 2]" ,
+        "nth_element(v, 99 * v[] / 100); v[99 * v[] / 100]"
+      };
+
+   static const std::size_t program_list_size = sizeof(program_list) / sizeof(std::string);
+
+   const std::size_t sizes[] = { 100000, 1000000, 10000000, 30000000 };
+
+   std::mt19937 rng(0x5EED);
+   std::normal_distribution<T> dist(T(0), T(1000));
+
+   for (std::size_t s = 0; s < sizeof(sizes) / sizeof(std::size_t); ++s)
+   {
+      std::vector<T> input(sizes[s]);
+
+      for (std::size_t i = 0; i < input.size(); ++i)
+      {
+         input[i] = dist(rng);
+      }
+
+      for (std::size_t p = 0; p < program_list_size; ++p)
+      {
+         std::vector<T> sequential_output;
+         std::vector<T> parallel_output;
+
+         T sequential_result = T(0);
+         T parallel_result   = T(0);
+
+         const double sequential_time = run(std::numeric_limits<std::size_t>::max(),
+                                            program_list[p], input,
+                                            sequential_output, sequential_result);
+
+         const double parallel_time   = run(parallel_threshold,
+                                            program_list[p], input,
+                                            parallel_output, parallel_result);
+
+         if ((sequential_time < 0.0) || (parallel_time < 0.0))
+            return;
+
+         const bool match = (sequential_result == parallel_result);
+
+         printf("[%-50s] size: %9d  seq: %8.4fsec  par: %8.4fsec  speedup: %6.3fx  %s\n",
+                program_list[p].c_str(),
+                static_cast<int>(sizes[s]),
+                sequential_time,
+                parallel_time,
+                sequential_time / parallel_time,
+                (match ? "OK" : "MISMATCH"));
+      }
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   const std::size_t parallel_threshold = ((argc == 2) ? atoi(argv[1]) : exprtk_parallel_vecops_threshold);
+
+   printf("Hardware threads: %d  Parallel threshold: %d\n",
+          static_cast<int>(std::thread::hardware_concurrency()),
+          static_cast<int>(parallel_threshold));
+
+   sort_benchmark<double>(parallel_threshold);
+
+   return 0;
+}